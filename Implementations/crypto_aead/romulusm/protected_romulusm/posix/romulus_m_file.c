@@ -0,0 +1,249 @@
+/**
+ * Romulus-M encryption/decryption of files in constant memory (POSIX only).
+ *
+ * Romulus-M requires two passes over the message. Instead of loading the whole
+ * file into memory, the source is read twice through 'pread' using a bounded
+ * buffer and fed to the streaming interface defined in 'romulus_m_stream.h'.
+ * In bulk mode (see 'romulus_bulk.h'), the buffer is a larger mapping backed
+ * by huge pages whenever possible, so that fewer reads are issued and the
+ * buffer takes a single TLB entry.
+ *
+ * This file is kept out of the top-level directory, which is built for
+ * bare-metal targets by the framework: hosted builds add it explicitly, from
+ * the 'protected_romulusm' directory with '-I.'.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "romulus_m_stream.h"
+#include "romulus_bulk.h"
+
+#define FILE_CHUNKBYTES     16384
+#define FILE_BULKBYTES      (2 << 20)   // a huge page on most platforms
+
+/**
+ * Returns the buffer to be used for a file of 'len' bytes (either 'stack_buf'
+ * or a FILE_BULKBYTES mapping), its size being written into 'buflen'.
+ */
+static uint8_t *get_buffer(uint8_t *stack_buf, unsigned long long len,
+    size_t *buflen)
+{
+    void *p = MAP_FAILED;
+    *buflen = FILE_CHUNKBYTES;
+    if (!BULK_ENABLED(len))
+        return stack_buf;
+#ifdef MAP_HUGETLB
+    p = mmap(NULL, FILE_BULKBYTES, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (p == MAP_FAILED) {  // no huge pages reserved, try transparent ones
+        p = mmap(NULL, FILE_BULKBYTES, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            return stack_buf;
+#ifdef MADV_HUGEPAGE
+        madvise(p, FILE_BULKBYTES, MADV_HUGEPAGE);
+#endif
+    }
+    *buflen = FILE_BULKBYTES;
+    return p;
+}
+
+/**
+ * Zeroizes the first 'len' bytes of the buffer (which held plaintext) before
+ * releasing it. Stores go through a volatile pointer so that they are not
+ * elided for the stack buffer, about to go out of scope.
+ */
+static void put_buffer(uint8_t *buf, const uint8_t *stack_buf, size_t len)
+{
+    volatile uint8_t *p = buf;
+    while (len-- > 0)
+        *p++ = 0x00;
+    if (buf != stack_buf)
+        munmap(buf, FILE_BULKBYTES);
+}
+
+/**
+ * Reads exactly 'len' bytes at offset 'off', retrying on short reads.
+ */
+static int read_at(int fd, uint8_t *buf, size_t len, off_t off)
+{
+    ssize_t n;
+    while (len > 0) {
+        n = pread(fd, buf, len, off);
+        if (n <= 0)
+            return -1;
+        buf += n;
+        len -= n;
+        off += n;
+    }
+    return 0;
+}
+
+/**
+ * Writes exactly 'len' bytes at offset 'off', retrying on short writes.
+ */
+static int write_at(int fd, const uint8_t *buf, size_t len, off_t off)
+{
+    ssize_t n;
+    while (len > 0) {
+        n = pwrite(fd, buf, len, off);
+        if (n <= 0)
+            return -1;
+        buf += n;
+        len -= n;
+        off += n;
+    }
+    return 0;
+}
+
+/**
+ * MAC pass over the first 'len' bytes of 'fd'.
+ */
+static int mac_file(
+    romulusm_stream_ctx *ctx, uint8_t *buf, size_t buflen,
+    int fd, unsigned long long len,
+    const uint8_t *ad, unsigned long long adlen)
+{
+    unsigned long long off;
+    size_t n;
+    romulusm_ad_update(ctx, ad, adlen);
+    for(off = 0; off < len; off += n) {
+        n = (len - off < buflen) ? (size_t)(len - off) : buflen;
+        if (read_at(fd, buf, n, (off_t)off))
+            return -1;
+        romulusm_mac_update(ctx, buf, n);
+    }
+    return 0;
+}
+
+static int encrypt_file(
+    int out_fd, int in_fd, unsigned long long mlen,
+    uint8_t *buf, size_t buflen,
+    const uint8_t *ad, unsigned long long adlen,
+    const uint8_t *npub,
+    const uint8_t *k, const uint8_t *k_m)
+{
+    romulusm_stream_ctx ctx;
+    uint8_t tag[TAGBYTES];
+    unsigned long long off;
+    size_t n;
+    int ret = -1;
+
+    // 1st pass: MAC computation
+    romulusm_stream_init(&ctx, npub, k, k_m);
+    if (mac_file(&ctx, buf, buflen, in_fd, mlen, ad, adlen))
+        goto end;
+    romulusm_begin_encrypt(&ctx, tag);
+    // 2nd pass: encryption
+    for(off = 0; off < mlen; off += n) {
+        n = (mlen - off < buflen) ? (size_t)(mlen - off) : buflen;
+        if (read_at(in_fd, buf, n, (off_t)off))
+            goto end;
+        romulusm_encrypt_update(&ctx, buf, buf, n);
+        if (write_at(out_fd, buf, n, (off_t)off))
+            goto end;
+    }
+    ret = write_at(out_fd, tag, TAGBYTES, (off_t)mlen);
+end:
+    romulusm_stream_wipe(&ctx);
+    return ret;
+}
+
+static int decrypt_file(
+    int out_fd, int in_fd, unsigned long long clen,
+    uint8_t *buf, size_t buflen,
+    const uint8_t *ad, unsigned long long adlen,
+    const uint8_t *npub,
+    const uint8_t *k, const uint8_t *k_m)
+{
+    romulusm_stream_ctx ctx;
+    uint8_t tag[TAGBYTES];
+    unsigned long long off;
+    size_t n;
+    int ret = -1;
+
+    if (read_at(in_fd, tag, TAGBYTES, (off_t)clen))
+        return -1;
+    // 1st pass: decryption
+    romulusm_stream_init(&ctx, npub, k, k_m);
+    romulusm_begin_decrypt(&ctx, tag);
+    for(off = 0; off < clen; off += n) {
+        n = (clen - off < buflen) ? (size_t)(clen - off) : buflen;
+        if (read_at(in_fd, buf, n, (off_t)off))
+            goto end;
+        romulusm_decrypt_update(&ctx, buf, buf, n);
+        if (write_at(out_fd, buf, n, (off_t)off))
+            break;
+    }
+    // 2nd pass: MAC computation over the released plaintext
+    romulusm_stream_init(&ctx, npub, k, k_m);
+    if (off < clen || mac_file(&ctx, buf, buflen, out_fd, clen, ad, adlen) ||
+        romulusm_mac_verify(&ctx, tag))
+        ret = ftruncate(out_fd, 0) ? -2 : -1;
+    else
+        ret = ftruncate(out_fd, (off_t)clen);
+end:
+    romulusm_stream_wipe(&ctx);
+    return ret;
+}
+
+/**
+ * Encrypts the content of 'in_fd' into 'out_fd' (ciphertext || tag).
+ *
+ * Returns a non-zero value if an I/O error occurs.
+ */
+int romulusm_encrypt_file(
+    int out_fd, int in_fd,
+    const uint8_t *ad, unsigned long long adlen,
+    const uint8_t *npub,
+    const uint8_t *k, const uint8_t *k_m)
+{
+    struct stat st;
+    uint8_t stack_buf[FILE_CHUNKBYTES];
+    uint8_t *buf;
+    size_t buflen;
+    int ret;
+
+    if (fstat(in_fd, &st))
+        return -1;
+    buf = get_buffer(stack_buf, (unsigned long long)st.st_size, &buflen);
+    ret = encrypt_file(out_fd, in_fd, (unsigned long long)st.st_size,
+        buf, buflen, ad, adlen, npub, k, k_m);
+    put_buffer(buf, stack_buf,
+        ((unsigned long long)st.st_size < buflen) ? (size_t)st.st_size : buflen);
+    return ret;
+}
+
+/**
+ * Decrypts the content of 'in_fd' (ciphertext || tag) into 'out_fd'.
+ *
+ * Returns a non-zero value if tag verification fails (in which case 'out_fd'
+ * is truncated) or if an I/O error occurs.
+ */
+int romulusm_decrypt_file(
+    int out_fd, int in_fd,
+    const uint8_t *ad, unsigned long long adlen,
+    const uint8_t *npub,
+    const uint8_t *k, const uint8_t *k_m)
+{
+    struct stat st;
+    uint8_t stack_buf[FILE_CHUNKBYTES];
+    uint8_t *buf;
+    size_t buflen;
+    int ret;
+
+    if (fstat(in_fd, &st) || st.st_size < TAGBYTES)
+        return -1;
+    buf = get_buffer(stack_buf, (unsigned long long)st.st_size, &buflen);
+    ret = decrypt_file(out_fd, in_fd, (unsigned long long)st.st_size - TAGBYTES,
+        buf, buflen, ad, adlen, npub, k, k_m);
+    put_buffer(buf, stack_buf,
+        ((unsigned long long)st.st_size < buflen) ? (size_t)st.st_size : buflen);
+    return ret;
+}
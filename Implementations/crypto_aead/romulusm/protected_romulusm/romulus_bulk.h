@@ -0,0 +1,58 @@
+#ifndef ROMULUS_BULK_H_
+#define ROMULUS_BULK_H_
+
+#include <stdint.h>
+
+//Bulk mode for messages of at least 'romulus_bulk_threshold' bytes, which
+//would otherwise evict the rest of the working set from the caches:
+//  - the input is prefetched ROMULUS_BULK_PREFETCH bytes ahead of the current
+//    block, with no temporal locality,
+//  - if built with -DROMULUS_BULK_NT, output blocks which are not read back by
+//    the implementation are written with non-temporal stores (SSE2 targets
+//    only, and only if the output buffer is 16-byte aligned).
+//The threshold defaults to ROMULUS_BULK_THRESHOLD and can be changed at
+//runtime, 0 disabling the bulk mode. It is meant to be set once at startup.
+#ifndef ROMULUS_BULK_THRESHOLD
+#define ROMULUS_BULK_THRESHOLD  (1ULL << 20)
+#endif
+#ifndef ROMULUS_BULK_PREFETCH
+#define ROMULUS_BULK_PREFETCH   4096
+#endif
+
+extern unsigned long long romulus_bulk_threshold;
+
+#define BULK_ENABLED(len)                                                       \
+    (romulus_bulk_threshold != 0 && (len) >= romulus_bulk_threshold)
+
+#if defined(__GNUC__)
+#define BULK_PREFETCH(p)                                                        \
+    __builtin_prefetch((const void *)((uintptr_t)(p) + ROMULUS_BULK_PREFETCH), 0, 0)
+#else
+#define BULK_PREFETCH(p)
+#endif
+
+#if defined(ROMULUS_BULK_NT) && defined(__SSE2__)
+#include <emmintrin.h>
+
+static inline void bulk_store_block(uint8_t *out, const uint8_t *blk)
+{
+    __m128i x = _mm_loadu_si128((const __m128i *)blk);
+    if (((uintptr_t)out & 15) == 0)
+        _mm_stream_si128((__m128i *)out, x);
+    else
+        _mm_storeu_si128((__m128i *)out, x);
+}
+
+//non-temporal stores are weakly ordered
+#define BULK_FENCE()    _mm_sfence()
+#else
+static inline void bulk_store_block(uint8_t *out, const uint8_t *blk)
+{
+    for(int i = 0; i < 16; i++)
+        out[i] = blk[i];
+}
+
+#define BULK_FENCE()    do {} while (0)
+#endif
+
+#endif  // ROMULUS_BULK_H_
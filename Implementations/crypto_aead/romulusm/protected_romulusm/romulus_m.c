@@ -8,6 +8,9 @@
  */
 #include "skinny128.h"
 #include "romulus_m.h"
+#include "romulus_bulk.h"
+
+unsigned long long romulus_bulk_threshold = ROMULUS_BULK_THRESHOLD;
 
 /**
  * Equivalent to 'memset(buf, 0x00, buflen)'.
@@ -32,7 +35,7 @@ static void copy(uint8_t dest[], const uint8_t src[], int srclen)
 /**
  * Internal helper to compute the final Additional Data (AD) domain.
  */
-static uint8_t final_ad_domain (unsigned long long adlen, unsigned long long mlen) {
+uint8_t romulusm_final_ad_domain (unsigned long long adlen, unsigned long long mlen) {
     uint8_t domain = 0;
     uint32_t leftover;
     //Determine which domain bits we need based on the length of the ad
@@ -84,7 +87,7 @@ void romulusm_init(uint8_t *state, uint8_t *state_m, uint8_t *tk1)
  * Romulus-M Additional Data (AD) processing.
  * 
  * At the end of the function, 'rtk' and 'rtk_m' are ready for use for message
- * processing. 
+ * processing. In bulk mode (see 'romulus_bulk.h'), the message is prefetched.
  */
 void romulusm_process_ad(
     uint8_t *state, uint8_t* state_m,
@@ -94,10 +97,11 @@ void romulusm_process_ad(
     const uint8_t *npub,
     const uint8_t *k, const uint8_t *k_m)
 {   
+    int bulk = BULK_ENABLED(mlen);
     uint32_t tmp;
     uint8_t pad[BLOCKBYTES];
     uint8_t rtk1[BLOCKBYTES*8];
-    uint8_t final_domain = 0x30 ^ final_ad_domain(adlen, mlen);
+    uint8_t final_domain = 0x30 ^ romulusm_final_ad_domain(adlen, mlen);
     
     SET_DOMAIN(tk1, 0x28);
     while (adlen > 2*BLOCKBYTES) {          // Process double blocks but the last
@@ -155,6 +159,8 @@ void romulusm_process_ad(
     // Process all message double blocks except the last
     SET_DOMAIN(tk1, 0x2C);
     while (mlen > 32) {
+        if (bulk)
+            BULK_PREFETCH(m);
         UPDATE_CTR(tk1);
         XOR_BLOCK(state, state, m);
         tk_schedule_123(rtk, rtk_m, rtk1, tk1, m + BLOCKBYTES, k, k_m);
@@ -192,14 +198,23 @@ void romulusm_process_ad(
     skinny128_384_plus(state, state_m, state, state_m, rtk, rtk_m, rtk1);
 }
 
+/**
+ * Romulus-M message encryption/decryption.
+ *
+ * In bulk mode (see 'romulus_bulk.h'), the input is prefetched. Only the
+ * ciphertext blocks go through 'bulk_store_block' since the plaintext released
+ * by decryption is read back for tag verification.
+ */
 void romulusm_process_msg(
     uint8_t *out, const uint8_t *in, unsigned long long inlen,
     uint8_t *state, uint8_t *state_m,
     const uint8_t *rtk, const uint8_t *rtk_m, uint8_t *tk1,
     const int mode)
 {
+    int bulk = BULK_ENABLED(inlen);
     uint32_t tmp;
     uint8_t tmp_blk[BLOCKBYTES];
+    uint8_t out_blk[BLOCKBYTES];
     uint8_t rtk1[BLOCKBYTES*8];
     
     if (mode == ENCRYPT_MODE) {
@@ -216,15 +231,23 @@ void romulusm_process_msg(
         while (inlen > BLOCKBYTES) {
             tk_schedule_1(rtk1, tk1);
             skinny128_384_plus(state, state_m, state, state_m, rtk, rtk_m, rtk1);
-            if (mode == ENCRYPT_MODE)
+            if (bulk)
+                BULK_PREFETCH(in);
+            if (bulk && mode == ENCRYPT_MODE) {
+                RHO(state, state_m, out_blk, in, tmp_blk);
+                bulk_store_block(out, out_blk);
+            } else if (mode == ENCRYPT_MODE) {
                 RHO(state, state_m, out, in, tmp_blk);
-            else
+            } else {
                 RHO_INV(state, state_m, in, out, tmp_blk);
+            }
             UPDATE_CTR(tk1);
             out += BLOCKBYTES;
             in += BLOCKBYTES;
             inlen -= BLOCKBYTES;
         }
+        if (bulk)
+            BULK_FENCE();
         tk_schedule_1(rtk1, tk1);
         skinny128_384_plus(state, state_m, state, state_m, rtk, rtk_m, rtk1);
         for(int i = 0; i < (int)inlen; i++) {
@@ -44,17 +44,17 @@
 })
 
 //Rho as defined in the Romulus specification
-//use pad as a tmp variable in case y = z
+//z is absorbed into the state before y is written, so that y = z is supported
 #define RHO(x,x_m,y,z,tmp) ({       \
     G(tmp,x);                       \
+    XOR_BLOCK(x, x, z);             \
     XOR_BLOCK(y, tmp, z);           \
     G(tmp,x_m);                     \
     XOR_BLOCK(y, tmp, y);           \
-    XOR_BLOCK(x, x, z);             \
 })
 
 //Rho inverse as defined in the Romulus specification
-//use pad as a tmp variable in case y = z
+//y is fully read before z is written, so that y = z is supported
 #define RHO_INV(x, x_m, y, z, tmp) ({   \
     G(tmp, x);                          \
     XOR_BLOCK(z, tmp, y);               \
@@ -64,6 +64,8 @@
 })
 
 // Core Romulus-M functions.
+uint8_t romulusm_final_ad_domain(unsigned long long adlen, unsigned long long mlen);
+
 void romulusm_init(uint8_t *state, uint8_t *state_m, uint8_t *tk1);
 
 void romulusm_process_ad(
@@ -0,0 +1,328 @@
+/**
+ * Romulus-M two-pass streaming interface (w/ 1st-order masking countermeasure).
+ *
+ * Same computations as 'romulusm_process_ad' and 'romulusm_process_msg' except
+ * that the inputs can be split across several calls. Since the processing of a
+ * double block depends on whether it is the last one (padding, counter update,
+ * domain separation), the last 2 blocks are always held back in the context
+ * until more input is received or the MAC is finalized.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include "skinny128.h"
+#include "romulus_m_stream.h"
+
+/**
+ * Equivalent to 'memset(buf, 0x00, buflen)'.
+ */
+static void zeroize(uint8_t buf[], int buflen)
+{
+  int i;
+  for(i = 0; i < buflen; i++)
+    buf[i] = 0x00;
+}
+
+/**
+ * Equivalent to 'memcpy(dest, src, srclen)'.
+ */
+static void copy(uint8_t dest[], const uint8_t src[], int srclen)
+{
+  int i;
+  for(i = 0; i < srclen; i++)
+    dest[i] = src[i];
+}
+
+/**
+ * Encrypts the internal state using 'tk2' as TK2 and the current TK1.
+ */
+static void mac_block(romulusm_stream_ctx *ctx, const uint8_t *tk2)
+{
+    uint8_t rtk1[BLOCKBYTES*8];
+    tk_schedule_123(ctx->rtk_23, ctx->rtk_3m, rtk1, ctx->tk1, tk2,
+        ctx->k, ctx->k_m);
+    skinny128_384_plus(ctx->state, ctx->state_m, ctx->state, ctx->state_m,
+        ctx->rtk_23, ctx->rtk_3m, rtk1);
+}
+
+/**
+ * Processes a double block which is known not to be the last one.
+ */
+static void mac_double_block(romulusm_stream_ctx *ctx, const uint8_t *in)
+{
+    uint32_t tmp;
+    UPDATE_CTR(ctx->tk1);
+    XOR_BLOCK(ctx->state, ctx->state, in);
+    mac_block(ctx, in + BLOCKBYTES);
+    UPDATE_CTR(ctx->tk1);
+}
+
+/**
+ * Processes a full unit of input (a single block when the first message block
+ * is paired with the last AD block, a double block otherwise).
+ */
+static void mac_unit(romulusm_stream_ctx *ctx, const uint8_t *in)
+{
+    uint32_t tmp;
+    if (ctx->phase == STREAM_MSG_FIRST) {
+        mac_block(ctx, in);
+        UPDATE_CTR(ctx->tk1);
+        ctx->phase = STREAM_MSG;
+    } else {
+        mac_double_block(ctx, in);
+    }
+}
+
+/**
+ * Absorbs the input, holding back the last unit until more input is received.
+ */
+static void mac_absorb(
+    romulusm_stream_ctx *ctx,
+    const uint8_t *in, unsigned long long inlen)
+{
+    uint32_t unit, n;
+    while (inlen > 0) {
+        unit = (ctx->phase == STREAM_MSG_FIRST) ? BLOCKBYTES : 2*BLOCKBYTES;
+        if (ctx->buflen == unit) {
+            mac_unit(ctx, ctx->buf);
+            ctx->buflen = 0;
+        } else if (ctx->buflen == 0 && inlen > unit) {
+            mac_unit(ctx, in);
+            in += unit;
+            inlen -= unit;
+        } else {
+            n = unit - ctx->buflen;
+            if (inlen < n)
+                n = (uint32_t)inlen;
+            copy(ctx->buf + ctx->buflen, in, n);
+            ctx->buflen += n;
+            in += n;
+            inlen -= n;
+        }
+    }
+}
+
+/**
+ * Processes the held back AD blocks once the AD length is known.
+ */
+static void mac_end_ad(romulusm_stream_ctx *ctx)
+{
+    uint32_t tmp;
+    uint32_t r = ctx->buflen;
+    if (r > BLOCKBYTES) {                   // Left-over (partial) double block
+        if (r < 2*BLOCKBYTES) {
+            zeroize(ctx->buf + r, 2*BLOCKBYTES-r-1);
+            ctx->buf[2*BLOCKBYTES-1] = (uint8_t)(r - BLOCKBYTES); // Padding
+        }
+        mac_double_block(ctx, ctx->buf);
+        ctx->phase = STREAM_MSG;
+    } else {                                // Left-over (partial) single block
+        SET_DOMAIN(ctx->tk1, 0x2C);
+        UPDATE_CTR(ctx->tk1);
+        for(int i = 0; i < (int)r; i++)
+            ctx->state[i] ^= ctx->buf[i];
+        if (r < BLOCKBYTES)
+            ctx->state[15] ^= (uint8_t)r;   // Padding
+        ctx->phase = STREAM_MSG_FIRST;
+    }
+    SET_DOMAIN(ctx->tk1, 0x2C);
+    ctx->buflen = 0;
+}
+
+/**
+ * Processes the held back message blocks and the nonce.
+ */
+static void mac_final(romulusm_stream_ctx *ctx)
+{
+    uint32_t tmp;
+    uint32_t r;
+    if (ctx->phase == STREAM_AD)
+        mac_end_ad(ctx);
+    r = ctx->buflen;
+    if (ctx->phase == STREAM_MSG_FIRST) {
+        if (r < BLOCKBYTES) {
+            zeroize(ctx->buf + r, BLOCKBYTES-r-1);
+            ctx->buf[15] = (uint8_t)r;      // Padding
+        }
+        mac_block(ctx, ctx->buf);
+    } else if (r > BLOCKBYTES) {            // Last message double block
+        if (r < 2*BLOCKBYTES) {
+            zeroize(ctx->buf + r, 2*BLOCKBYTES-r-1);
+            ctx->buf[2*BLOCKBYTES-1] = (uint8_t)(r - BLOCKBYTES); // Padding
+        }
+        UPDATE_CTR(ctx->tk1);
+        XOR_BLOCK(ctx->state, ctx->state, ctx->buf);
+        mac_block(ctx, ctx->buf + BLOCKBYTES);
+    } else if (r > 0) {                     // Last message single block
+        for(int i = 0; i < (int)r; i++)
+            ctx->state[i] ^= ctx->buf[i];
+        if (r < BLOCKBYTES)
+            ctx->state[15] ^= (uint8_t)r;   // Padding
+    }
+    SET_DOMAIN(ctx->tk1, 0x30 ^ romulusm_final_ad_domain(ctx->adlen, ctx->mlen));
+    UPDATE_CTR(ctx->tk1);
+    mac_block(ctx, ctx->npub);
+    ctx->buflen = 0;
+}
+
+/**
+ * Initializes the context for a MAC pass or a decryption pass.
+ */
+void romulusm_stream_init(
+    romulusm_stream_ctx *ctx,
+    const uint8_t *npub,
+    const uint8_t *k, const uint8_t *k_m)
+{
+    romulusm_init(ctx->state, ctx->state_m, ctx->tk1);
+    SET_DOMAIN(ctx->tk1, 0x28);
+    copy(ctx->npub, npub, BLOCKBYTES);
+    copy(ctx->k, k, KEYBYTES);
+    copy(ctx->k_m, k_m, KEYBYTES);
+    ctx->buflen = 0;
+    ctx->phase = STREAM_AD;
+    ctx->adlen = 0;
+    ctx->mlen = 0;
+}
+
+/**
+ * Additional data absorption. Must be called before 'romulusm_mac_update'.
+ */
+void romulusm_ad_update(
+    romulusm_stream_ctx *ctx,
+    const uint8_t *ad, unsigned long long adlen)
+{
+    ctx->adlen += adlen;
+    mac_absorb(ctx, ad, adlen);
+}
+
+/**
+ * Message absorption (first pass).
+ */
+void romulusm_mac_update(
+    romulusm_stream_ctx *ctx,
+    const uint8_t *m, unsigned long long mlen)
+{
+    if (ctx->phase == STREAM_AD)
+        mac_end_ad(ctx);
+    ctx->mlen += mlen;
+    mac_absorb(ctx, m, mlen);
+}
+
+/**
+ * Common setup for the encryption/decryption pass, the internal state being
+ * already initialized with the (masked) tag.
+ */
+static void cipher_init(romulusm_stream_ctx *ctx)
+{
+    tk_schedule_23(ctx->rtk_23, ctx->rtk_3m, ctx->npub, ctx->k, ctx->k_m);
+    ctx->tk1[0] = 0x01;
+    zeroize(ctx->tk1+1, BLOCKBYTES-1);
+    SET_DOMAIN(ctx->tk1, 0x24);
+    ctx->phase = STREAM_CIPHER;
+    ctx->mlen = 0;
+}
+
+/**
+ * Outputs the tag and prepares the context for the second pass.
+ */
+void romulusm_begin_encrypt(romulusm_stream_ctx *ctx, uint8_t *tag)
+{
+    mac_final(ctx);
+    romulusm_generate_tag(tag, ctx->state, ctx->state_m);
+    cipher_init(ctx);
+}
+
+/**
+ * Prepares the context for decryption from the tag.
+ */
+void romulusm_begin_decrypt(romulusm_stream_ctx *ctx, const uint8_t *tag)
+{
+    for(int i = 0; i < TAGBYTES; i++)
+        ctx->state[i] = tag[i] ^ ctx->state_m[i];
+    cipher_init(ctx);
+}
+
+/**
+ * Encryption/decryption pass. Full blocks are processed with RHO/RHO_INV while
+ * bytes of partial blocks are processed one by one, so that the output length
+ * always matches the input length.
+ */
+static void cipher_update(
+    romulusm_stream_ctx *ctx,
+    uint8_t *out, const uint8_t *in, unsigned long long inlen,
+    const int mode)
+{
+    uint32_t tmp;
+    uint32_t pos;
+    uint8_t tmp_blk[BLOCKBYTES];
+    uint8_t rtk1[BLOCKBYTES*8];
+    while (inlen > 0) {
+        pos = (uint32_t)(ctx->mlen % BLOCKBYTES);
+        if (pos == 0) {
+            if (ctx->mlen > 0)
+                UPDATE_CTR(ctx->tk1);
+            tk_schedule_1(rtk1, ctx->tk1);
+            skinny128_384_plus(ctx->state, ctx->state_m, ctx->state,
+                ctx->state_m, ctx->rtk_23, ctx->rtk_3m, rtk1);
+            if (inlen >= BLOCKBYTES) {
+                if (mode == ENCRYPT_MODE)
+                    RHO(ctx->state, ctx->state_m, out, in, tmp_blk);
+                else
+                    RHO_INV(ctx->state, ctx->state_m, in, out, tmp_blk);
+                ctx->mlen += BLOCKBYTES;
+                out += BLOCKBYTES;
+                in += BLOCKBYTES;
+                inlen -= BLOCKBYTES;
+                continue;
+            }
+        }
+        tmp = in[0];                        // Use of tmp variable in case c = m
+        out[0] = in[0] ^ (ctx->state[pos] >> 1) ^ (ctx->state[pos] & 0x80) ^
+            (ctx->state[pos] << 7);
+        out[0] ^= (ctx->state_m[pos] >> 1) ^ (ctx->state_m[pos] & 0x80) ^
+            (ctx->state_m[pos] << 7);
+        ctx->state[pos] ^= (mode == ENCRYPT_MODE) ? (uint8_t)tmp : out[0];
+        ctx->mlen += 1;
+        out += 1;
+        in += 1;
+        inlen -= 1;
+    }
+}
+
+/**
+ * Message encryption (second pass).
+ */
+void romulusm_encrypt_update(
+    romulusm_stream_ctx *ctx,
+    uint8_t *c, const uint8_t *m, unsigned long long mlen)
+{
+    cipher_update(ctx, c, m, mlen, ENCRYPT_MODE);
+}
+
+/**
+ * Ciphertext decryption (first pass when decrypting).
+ */
+void romulusm_decrypt_update(
+    romulusm_stream_ctx *ctx,
+    uint8_t *m, const uint8_t *c, unsigned long long clen)
+{
+    cipher_update(ctx, m, c, clen, DECRYPT_MODE);
+}
+
+/**
+ * Tag verification at the end of the MAC pass over the decrypted message.
+ *
+ * Returns non-zero value if verification fails.
+ */
+uint32_t romulusm_mac_verify(romulusm_stream_ctx *ctx, const uint8_t *tag)
+{
+    mac_final(ctx);
+    return romulusm_verify_tag(tag, ctx->state, ctx->state_m);
+}
+
+void romulusm_stream_wipe(romulusm_stream_ctx *ctx)
+{
+    zeroize((uint8_t *)ctx, sizeof(romulusm_stream_ctx));
+}
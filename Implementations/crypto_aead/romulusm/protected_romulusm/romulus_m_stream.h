@@ -0,0 +1,90 @@
+#ifndef ROMULUSM_STREAM_H_
+#define ROMULUSM_STREAM_H_
+
+#include "romulus_m.h"
+
+//Two-pass streaming interface for Romulus-M.
+//
+//Encryption:  romulusm_stream_init, romulusm_ad_update*, romulusm_mac_update*,
+//             romulusm_begin_encrypt (outputs the tag), romulusm_encrypt_update*
+//             over the same message again.
+//Decryption:  romulusm_stream_init, romulusm_begin_decrypt,
+//             romulusm_decrypt_update*, then a fresh MAC pass over the released
+//             plaintext ending with romulusm_mac_verify. The plaintext must not
+//             be used before romulusm_mac_verify succeeds.
+//
+//The context holds the key shares and their round tweakeys: it must be
+//cleared with romulusm_stream_wipe once the stream is over (or aborted).
+//
+//Only up to 2 blocks are buffered, whatever the message length.
+#define STREAM_AD           0
+#define STREAM_MSG_FIRST    1   // first message block pairs with the last AD block
+#define STREAM_MSG          2
+#define STREAM_CIPHER       3
+
+typedef struct {
+    uint8_t state[BLOCKBYTES];                          // internal state (1st share)
+    uint8_t state_m[BLOCKBYTES];                        // internal state (2nd share)
+    uint8_t tk1[BLOCKBYTES];
+    uint8_t npub[BLOCKBYTES];
+    uint8_t k[KEYBYTES];
+    uint8_t k_m[KEYBYTES];
+    uint8_t buf[2*BLOCKBYTES];                          // held back until more input
+    uint32_t buflen;
+    uint32_t phase;
+    unsigned long long adlen;
+    unsigned long long mlen;
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS];    // round tweakeys (1st share)
+    uint8_t rtk_3m[BLOCKBYTES*SKINNY128_384_ROUNDS];    // round tweakeys (2nd share)
+} romulusm_stream_ctx;
+
+void romulusm_stream_init(
+    romulusm_stream_ctx *ctx,
+    const uint8_t *npub,
+    const uint8_t *k, const uint8_t *k_m);
+
+void romulusm_ad_update(
+    romulusm_stream_ctx *ctx,
+    const uint8_t *ad, unsigned long long adlen);
+
+void romulusm_mac_update(
+    romulusm_stream_ctx *ctx,
+    const uint8_t *m, unsigned long long mlen);
+
+void romulusm_begin_encrypt(romulusm_stream_ctx *ctx, uint8_t *tag);
+
+void romulusm_encrypt_update(
+    romulusm_stream_ctx *ctx,
+    uint8_t *c, const uint8_t *m, unsigned long long mlen);
+
+void romulusm_begin_decrypt(romulusm_stream_ctx *ctx, const uint8_t *tag);
+
+void romulusm_decrypt_update(
+    romulusm_stream_ctx *ctx,
+    uint8_t *m, const uint8_t *c, unsigned long long clen);
+
+uint32_t romulusm_mac_verify(romulusm_stream_ctx *ctx, const uint8_t *tag);
+
+//Zeroizes the whole context (key shares, round tweakeys, internal state and
+//buffered data).
+void romulusm_stream_wipe(romulusm_stream_ctx *ctx);
+
+//File helpers (POSIX only, see 'posix/romulus_m_file.c').
+//The source is read twice through pread() with a bounded buffer, so both file
+//descriptors must be seekable. The output is the ciphertext followed by the
+//tag, as with crypto_aead_encrypt.
+int romulusm_encrypt_file(
+    int out_fd, int in_fd,
+    const uint8_t *ad, unsigned long long adlen,
+    const uint8_t *npub,
+    const uint8_t *k, const uint8_t *k_m);
+
+//'out_fd' must be opened for reading and writing since the released plaintext
+//is read back for tag verification. It is truncated if verification fails.
+int romulusm_decrypt_file(
+    int out_fd, int in_fd,
+    const uint8_t *ad, unsigned long long adlen,
+    const uint8_t *npub,
+    const uint8_t *k, const uint8_t *k_m);
+
+#endif  // ROMULUSM_STREAM_H_
@@ -9,6 +9,7 @@
 
 #include "crypto_aead.h"
 #include "romulus_m.h"
+#include "romulus_usdt.h"
 
 
 
@@ -21,5 +22,9 @@ const unsigned char *npub,
 const unsigned char *k
 )
 {
-  return romulus_m_decrypt(m,mlen,nsec,c,clen,ad,adlen,npub,k);
+  int ret;
+  ROMULUS_PROBE3(aead_decrypt_entry,"romulus-m",adlen,clen);
+  ret = romulus_m_decrypt(m,mlen,nsec,c,clen,ad,adlen,npub,k);
+  ROMULUS_PROBE4(aead_decrypt_return,"romulus-m",adlen,clen,ret);
+  return ret;
 }
@@ -9,6 +9,7 @@
 
 #include "crypto_aead.h"
 #include "romulus_m.h"
+#include "romulus_usdt.h"
 
 
 
@@ -21,5 +22,9 @@ int crypto_aead_encrypt (
 			 const unsigned char* k
 			 )
 {
-  return romulus_m_encrypt(c,clen,m,mlen,ad,adlen,nsec,npub,k);
+  int ret;
+  ROMULUS_PROBE3(aead_encrypt_entry,"romulus-m",adlen,mlen);
+  ret = romulus_m_encrypt(c,clen,m,mlen,ad,adlen,nsec,npub,k);
+  ROMULUS_PROBE4(aead_encrypt_return,"romulus-m",adlen,mlen,ret);
+  return ret;
 }
@@ -59,6 +59,7 @@ void rho_ad (const unsigned char* m,
 }
 
 // Rho(S,M): pads an M block and outputs S'= M xor S and C = M xor G(S) 
+// Only len8 bytes are written to C, so that C and M can be the same buffer
 void rho (const unsigned char* m,
 	  unsigned char* c,
 	  unsigned char* s,
@@ -66,23 +67,22 @@ void rho (const unsigned char* m,
 	  int ver) {
   int i;
   unsigned char mp [16];
+  unsigned char gs [16];
 
   pad(m,mp,ver,len8);
 
-  g8A(s,c);
+  g8A(s,gs);
   for (i = 0; i < ver; i++) {
     s[i] = s[i] ^ mp[i];
     if (i < len8) {
-      c[i] = c[i] ^ mp[i];
-    }
-    else {
-      c[i] = 0;
+      c[i] = gs[i] ^ mp[i];
     }
   }
   
 }
 
 // Inverse-Rho(S,M): pads a C block and outputs S'= C xor G(S) xor S and M = C xor G(S) 
+// Only len8 bytes are written to M, so that C and M can be the same buffer
 void irho (unsigned char* m,
 	  const unsigned char* c,
 	  unsigned char* s,
@@ -90,22 +90,20 @@ void irho (unsigned char* m,
 	  int ver) {
   int i;
   unsigned char cp [16];
+  unsigned char gs [16];
 
   pad(c,cp,ver,len8);
 
-  g8A(s,m);
+  g8A(s,gs);
   for (i = 0; i < ver; i++) {
     if (i < len8) {
-      s[i] = s[i] ^ cp[i] ^ m[i];
+      s[i] = s[i] ^ cp[i] ^ gs[i];
     }
     else {
       s[i] = s[i] ^ cp[i];
     }
     if (i < len8) {
-      m[i] = m[i] ^ cp[i];
-    }
-    else {
-      m[i] = 0;
+      m[i] = gs[i] ^ cp[i];
     }
   }
   
@@ -180,17 +178,38 @@ void block_cipher(unsigned char* s,
 
 }
 
-// Calls the TBC using the nonce as part of the tweakey
-void nonce_encryption (const unsigned char* N,
-		       unsigned char* CNT,
-		       unsigned char*s, const unsigned char* k,
-		       int t, unsigned char D) {
-  unsigned char T [16];
-  int i;  
-  for (i = 0; i < t; i++) {
+// Precomputes the subtweakeys of TK2 || TK3 = N || K, which are the same for all the TBC calls
+// using the nonce
+void nonce_key_schedule (unsigned char* rtk23,
+			 const unsigned char* N,
+			 const unsigned char* k) {
+  unsigned char T [32];
+  int i;
+  for (i = 0; i < 16; i++) {
     T[i] = N[i];
-  }  
-  block_cipher(s,k,T,CNT,D,t);
+    T[i+16] = k[i];
+  }
+  skinny_128_384_plus_ks(rtk23,T);
+
+}
+
+// Calls the TBC using the nonce as part of the tweakey, from the subtweakeys computed by
+// nonce_key_schedule: only TK1 (counter and domain bits) is composed for each call
+void nonce_encryption (const unsigned char* rtk23,
+		       unsigned char* CNT,
+		       unsigned char*s,
+		       unsigned char D) {
+  unsigned char KT [16];
+  int i;
+
+  for (i = 0; i < 7; i++) {
+    KT[i] = CNT[i];
+  }
+  KT[i] = D;
+  for (i = 8; i < 16; i++) {
+    KT[i] = 0x00;
+  }
+  skinny_128_384_plus_enc_with_rtk(s,KT,rtk23);
 
 }
 
@@ -206,10 +225,10 @@ void generate_tag (unsigned char** c, unsigned char* s,
 
 // Absorbs and encrypts the message blocks.
 unsigned long long msg_encryption (const unsigned char** M, unsigned char** c,
-				   const unsigned char* N,
+				   const unsigned char* rtk23,
 				   unsigned char* CNT,
-				   unsigned char*s, const unsigned char* k,
-				   unsigned int n, unsigned int t, unsigned char D,
+				   unsigned char*s,
+				   unsigned int n, unsigned char D,
 				   unsigned long long mlen) {
   int len8;
 
@@ -226,16 +245,16 @@ unsigned long long msg_encryption (const unsigned char** M, unsigned char** c,
   *c = *c + len8;
   *M = *M + len8;
   lfsr_gf56(CNT);
-  nonce_encryption(N,CNT,s,k,t,D);
+  nonce_encryption(rtk23,CNT,s,D);
   return mlen;
 }
 
 // Absorbs and decrypts the ciphertext blocks.
 unsigned long long msg_decryption (unsigned char** M, const unsigned char** c,
-				   const unsigned char* N,
+				   const unsigned char* rtk23,
 				   unsigned char* CNT,
-				   unsigned char*s, const unsigned char* k,
-				   unsigned int n, unsigned int t, unsigned char D,
+				   unsigned char*s,
+				   unsigned int n, unsigned char D,
 				   unsigned long long clen) {
   int len8;
 
@@ -251,7 +270,7 @@ unsigned long long msg_decryption (unsigned char** M, const unsigned char** c,
   *c = *c + len8;
   *M = *M + len8;
   lfsr_gf56(CNT);
-  nonce_encryption(N,CNT,s,k,t,D);
+  nonce_encryption(rtk23,CNT,s,D);
   return clen;
 }
 
@@ -335,6 +354,7 @@ int romulus_m_encrypt (
   unsigned char s[16];
   unsigned char CNT[7];
   unsigned char T[16];
+  unsigned char rtk23[SKINNY_RTK23_BYTES];
   const unsigned char* N;
   unsigned int n, t, i;
   unsigned char w;
@@ -342,6 +362,8 @@ int romulus_m_encrypt (
 
   (void)nsec;
   N = npub;
+  // TK2 and TK3 are fixed to N and K in all the calls to nonce_encryption
+  nonce_key_schedule(rtk23,N,k);
   
   n = AD_BLK_LEN_ODD;
   t = AD_BLK_LEN_EVN;
@@ -463,7 +485,7 @@ int romulus_m_encrypt (
   while (xlen > 0) {
     xlen = ad_encryption(&m,s,k,xlen,CNT,44,n,t);
   }
-  nonce_encryption(N,CNT,s,k,t,w);
+  nonce_encryption(rtk23,CNT,s,w);
   
   
   // Tag generation 
@@ -483,9 +505,9 @@ int romulus_m_encrypt (
 
 
   if (mlen > 0) {
-    nonce_encryption(N,CNT,s,k,t,36);  
+    nonce_encryption(rtk23,CNT,s,36);  
     while (mlen > n) {
-      mlen = msg_encryption(&m,&c,N,CNT,s,k,n,t,36,mlen);
+      mlen = msg_encryption(&m,&c,rtk23,CNT,s,n,36,mlen);
     }
     rho(m, c, s, mlen, 16);
     c = c + mlen;
@@ -516,6 +538,7 @@ const unsigned char *k
   unsigned char s[16];
   unsigned char CNT[7];
   unsigned char T[16];
+  unsigned char rtk23[SKINNY_RTK23_BYTES];
   const unsigned char* N;
   unsigned int n, t, i;
   unsigned char w;
@@ -526,6 +549,8 @@ const unsigned char *k
   mauth = m;
 
   N = npub;
+  // TK2 and TK3 are fixed to N and K in all the calls to nonce_encryption
+  nonce_key_schedule(rtk23,N,k);
   
   n = AD_BLK_LEN_ODD;
   t = AD_BLK_LEN_EVN;
@@ -548,9 +573,9 @@ const unsigned char *k
 
 
   if (clen > 0) {    
-    nonce_encryption(N,CNT,s,k,t,36);
+    nonce_encryption(rtk23,CNT,s,36);
     while (clen > n) {
-      clen = msg_decryption(&m,&c,N,CNT,s,k,n,t,36,clen);
+      clen = msg_decryption(&m,&c,rtk23,CNT,s,n,36,clen);
     }
     irho(m, c, s, clen, 16);
     c = c + clen;
@@ -674,7 +699,7 @@ const unsigned char *k
   while (xlen > 0) {
     xlen = ad_encryption(&mauth,s,k,xlen,CNT,44,n,t);
   }
-  nonce_encryption(N,CNT,s,k,t,w);
+  nonce_encryption(rtk23,CNT,s,w);
 
   // Tag generation 
   g8A(s, T);
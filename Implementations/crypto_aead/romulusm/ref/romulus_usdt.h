@@ -0,0 +1,35 @@
+#ifndef ROMULUS_USDT_H_
+#define ROMULUS_USDT_H_
+
+//Optional USDT probes (provider 'romulus') at entry and exit of the public
+//AEAD and hash functions, compiled in with -DROMULUS_USDT on platforms
+//providing <sys/sdt.h> (e.g. systemtap-sdt-dev on Debian/Ubuntu) and
+//compiled out otherwise. A probe which is not attached is a single NOP, its
+//arguments only having to be available in registers or memory at that point.
+//
+//  aead_encrypt_entry(variant, adlen, mlen)
+//  aead_encrypt_return(variant, adlen, mlen, result)
+//  aead_decrypt_entry(variant, adlen, clen)
+//  aead_decrypt_return(variant, adlen, clen, result)
+//  aead_encrypt_batch_entry(variant, n)
+//  aead_encrypt_batch_return(variant, n, result)
+//  aead_decrypt_batch_entry(variant, n)
+//  aead_decrypt_batch_return(variant, n, result)
+//  hash_entry(variant, inlen)
+//  hash_return(variant, inlen, result)
+//
+//'variant' is a string (e.g. "romulus-t"), 'result' the return value of the
+//function. See 'Implementations/tools/bpftrace' for example scripts.
+#ifdef ROMULUS_USDT
+#include <sys/sdt.h>
+#define ROMULUS_PROBE2(name, a, b)          DTRACE_PROBE2(romulus, name, a, b)
+#define ROMULUS_PROBE3(name, a, b, c)       DTRACE_PROBE3(romulus, name, a, b, c)
+#define ROMULUS_PROBE4(name, a, b, c, d)    \
+    DTRACE_PROBE4(romulus, name, a, b, c, d)
+#else
+#define ROMULUS_PROBE2(name, a, b)
+#define ROMULUS_PROBE3(name, a, b, c)
+#define ROMULUS_PROBE4(name, a, b, c, d)
+#endif
+
+#endif  // ROMULUS_USDT_H_
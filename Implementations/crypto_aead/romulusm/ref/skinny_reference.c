@@ -244,3 +244,89 @@ void skinny_128_384_plus_enc (unsigned char* input, const unsigned char* userkey
  	enc(input,userkey); 
 }
 
+// Computes the subtweakeys related to TK2 and TK3 for all rounds, i.e. the two top rows of
+// TK2 xor TK3 for each round (8 bytes per round), since they do not depend on the internal state
+void ks(unsigned char* rtk23, const unsigned char* userkey)
+{
+	unsigned char state[4][4];
+	unsigned char keyCells[3][4][4];
+	int i, j, r;
+
+	for(i = 0; i < 16; i++) {
+        keyCells[0][i>>2][i&0x3] = 0;
+	    keyCells[1][i>>2][i&0x3] = userkey[i]&0xFF;
+	    keyCells[2][i>>2][i&0x3] = userkey[i+16]&0xFF;
+	}
+
+	for(r = 0; r < N_RNDS; r++){
+        for(i = 0; i < 16; i++) state[i>>2][i&0x3] = 0;
+        // AddKey on an all-zero state with TK1 = 0 extracts the subtweakey
+	    AddKey(state, keyCells);
+        for(i = 0; i <= 1; i++)
+            for(j = 0; j < 4; j++)
+                rtk23[8*r+4*i+j] = state[i][j];
+	}
+}
+
+// Extract and apply the subtweakey of TK1 and the precomputed subtweakey of TK2 and TK3 to
+// the internal state, then update TK1 (no LFSR is applied to TK1)
+void AddKeyWithRtk(unsigned char state[4][4], unsigned char keyCells[4][4], const unsigned char* rtk23)
+{
+	int i, j;
+	unsigned char pos;
+	unsigned char keyCells_tmp[4][4];
+
+    for(i = 0; i <= 1; i++)
+    {
+        for(j = 0; j < 4; j++)
+        {
+            state[i][j] ^= keyCells[i][j] ^ rtk23[4*i+j];
+        }
+    }
+
+    for(i = 0; i < 4; i++){
+        for(j = 0; j < 4; j++){
+            pos=TWEAKEY_P[j+4*i];
+            keyCells_tmp[i][j]=keyCells[pos>>2][pos&0x3];
+        }
+    }
+
+    for(i = 0; i < 4; i++){
+        for(j = 0; j < 4; j++){
+            keyCells[i][j]=keyCells_tmp[i][j];
+        }
+    }
+}
+
+// encryption function of Skinny-128-384+ using the subtweakeys of TK2 and TK3 computed by ks()
+void enc_with_rtk(unsigned char* input, const unsigned char* tk1, const unsigned char* rtk23)
+{
+	unsigned char state[4][4];
+	unsigned char keyCells[4][4];
+	int i;
+
+	for(i = 0; i < 16; i++) {
+        state[i>>2][i&0x3] = input[i]&0xFF;
+        keyCells[i>>2][i&0x3] = tk1[i]&0xFF;
+	}
+
+	for(i = 0; i < N_RNDS; i++){
+        SubCell8(state);
+	    AddConstants(state, i);
+	    AddKeyWithRtk(state, keyCells, rtk23 + 8*i);
+	    ShiftRows(state);
+	    MixColumn(state);
+	}
+
+    for(i = 0; i < 16; i++)
+		input[i] = state[i>>2][i&0x3] & 0xFF;
+}
+
+void skinny_128_384_plus_ks (unsigned char* rtk23, const unsigned char* userkey) {
+ 	ks(rtk23,userkey); 
+}
+
+void skinny_128_384_plus_enc_with_rtk (unsigned char* input, const unsigned char* tk1, const unsigned char* rtk23) {
+ 	enc_with_rtk(input,tk1,rtk23); 
+}
+
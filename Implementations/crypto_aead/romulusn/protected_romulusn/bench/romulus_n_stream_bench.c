@@ -0,0 +1,171 @@
+/**
+ * Memory footprint and throughput of the Romulus-N streaming interface (see
+ * 'romulus_n_stream.h') with many concurrent streams (POSIX only, the resident
+ * memory being read from '/proc/self/statm' on Linux).
+ *
+ * Streams are opened under a few shared keys with some AD, then fed in a
+ * round-robin fashion, one update per stream per round, as a server handling
+ * many sessions would. The memory reported per stream is the growth of the
+ * resident set while opening them.
+ *
+ * Build from the 'protected_romulusn' directory (with the Skinny-128-384+
+ * assembly, i.e. for an ARMv7-M Linux host):
+ *   cc -O2 -o romulus_n_stream_bench bench/romulus_n_stream_bench.c \
+ *      romulus_n_stream.c romulus_n.c skinny128_*.s -I.
+ * Usage:
+ *   romulus_n_stream_bench [-n <streams>] [-k <keys>] [-l <message bytes>]
+ *                          [-u <bytes per update>]
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/random.h>
+#include "randombytes.h"
+#include "romulus_n_stream.h"
+
+#define BENCH_ADBYTES   16
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+/**
+ * Randomness source required by the export and import of streams.
+ */
+void randombytes(unsigned char *x, unsigned long long xlen)
+{
+    ssize_t n;
+    while (xlen > 0) {
+        n = getrandom(x, xlen > 256 ? 256 : xlen, 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            abort();
+        }
+        x += n;
+        xlen -= n;
+    }
+}
+
+/**
+ * Returns the resident set size in bytes, 0 if unknown.
+ */
+static unsigned long long rss(void)
+{
+    unsigned long long size, resident = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (f == NULL)
+        return 0;
+    if (fscanf(f, "%llu %llu", &size, &resident) != 2)
+        resident = 0;
+    fclose(f);
+    return resident * (unsigned long long)sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Fills 'buf' with arbitrary bytes (no randomness is needed here).
+ */
+static void fill(uint8_t *buf, size_t len, uint32_t seed)
+{
+    for(size_t i = 0; i < len; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        buf[i] = (uint8_t)seed;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int opt;
+    size_t i, j, nstreams = 1000000, nkeys = 16, mlen = 256, ulen = 64, n;
+    unsigned long long rss0, rss1;
+    uint8_t k[KEYBYTES], k_m[KEYBYTES], npub[BLOCKBYTES], tag[TAGBYTES];
+    uint8_t ad[BENCH_ADBYTES], *m, *c;
+    romulusn_key **keys;
+    romulusn_stream_ctx *ctx;
+    double t0, t1, t2;
+
+    while ((opt = getopt(argc, argv, "n:k:l:u:")) != -1) {
+        switch (opt) {
+        case 'n': nstreams = strtoull(optarg, NULL, 0); break;
+        case 'k': nkeys = strtoull(optarg, NULL, 0); break;
+        case 'l': mlen = strtoull(optarg, NULL, 0); break;
+        case 'u': ulen = strtoull(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-n <streams>] [-k <keys>] "
+                "[-l <message bytes>] [-u <bytes per update>]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (nstreams == 0 || nkeys == 0 || ulen == 0)
+        return 1;
+    m = malloc(mlen + 1);
+    c = malloc(mlen + 1);
+    keys = malloc(nkeys*sizeof(romulusn_key *));
+    if (m == NULL || c == NULL || keys == NULL)
+        return 1;
+    fill(m, mlen, 1);
+    fill(ad, BENCH_ADBYTES, 2);
+    fill(npub, BLOCKBYTES, 3);
+
+    rss0 = rss();
+    for(i = 0; i < nkeys; i++) {
+        fill(k, KEYBYTES, 4 + 2*i);
+        fill(k_m, KEYBYTES, 5 + 2*i);
+        if ((keys[i] = romulusn_key_new(k, k_m)) == NULL)
+            return 1;
+    }
+    t0 = now();
+    ctx = malloc(nstreams*sizeof(romulusn_stream_ctx));
+    if (ctx == NULL)
+        return 1;
+    for(i = 0; i < nstreams; i++) {
+        npub[0] = (uint8_t)i;               // distinct nonces per key
+        npub[1] = (uint8_t)(i >> 8);
+        npub[2] = (uint8_t)(i >> 16);
+        npub[3] = (uint8_t)(i >> 24);
+        romulusn_stream_init(&ctx[i], keys[i % nkeys], npub);
+        romulusn_ad_update(&ctx[i], ad, BENCH_ADBYTES);
+    }
+    t1 = now();
+    rss1 = rss();
+    // keys are now only referenced by the streams
+    for(i = 0; i < nkeys; i++)
+        romulusn_key_release(keys[i]);
+
+    for(j = 0; j < mlen; j += n) {
+        n = (mlen - j < ulen) ? mlen - j : ulen;
+        for(i = 0; i < nstreams; i++)
+            romulusn_encrypt_update(&ctx[i], c, m + j, n);
+    }
+    for(i = 0; i < nstreams; i++)
+        romulusn_encrypt_final(&ctx[i], tag);
+    t2 = now();
+
+    printf("streams             %zu under %zu key(s)\n", nstreams, nkeys);
+    printf("context size        %zu bytes per stream, %zu bytes per key\n",
+        sizeof(romulusn_stream_ctx), sizeof(romulusn_key));
+    if (rss1 > rss0)
+        printf("resident memory     %.1f bytes per stream (%.1f MB in total)\n",
+            (double)(rss1 - rss0) / nstreams, (rss1 - rss0) / 1e6);
+    printf("open                %.0f streams/s\n", nstreams / (t1 - t0));
+    printf("encrypt             %.2f MB/s, %.0f updates/s (%zu-byte messages, "
+        "%zu-byte updates)\n", (double)nstreams*mlen / (t2 - t1) / 1e6,
+        nstreams*((mlen + ulen - 1) / ulen) / (t2 - t1), mlen, ulen);
+    free(ctx);
+    free(keys);
+    free(m);
+    free(c);
+    return 0;
+}
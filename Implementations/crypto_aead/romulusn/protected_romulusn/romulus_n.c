@@ -8,6 +8,9 @@
  */
 #include "skinny128.h"
 #include "romulus_n.h"
+#include "romulus_bulk.h"
+
+unsigned long long romulus_bulk_threshold = ROMULUS_BULK_THRESHOLD;
 
 /**
  * Equivalent to 'memset(buf, 0x00, buflen)'.
@@ -115,6 +118,9 @@ void romulusn_process_ad(
  * 
  * Unmasking is performed right before storing the ciphertext in the output
  * buffer 'out'.
+ *
+ * In bulk mode (see 'romulus_bulk.h'), the input is prefetched and the output
+ * blocks, which are never read back, go through 'bulk_store_block'.
  */
 void romulusn_process_msg(
     uint8_t *out, const uint8_t *in, unsigned long long inlen,
@@ -123,8 +129,10 @@ void romulusn_process_msg(
     const int mode)
 {
     int         i;
+    int         bulk = BULK_ENABLED(inlen);
     uint32_t    tmp;
     uint8_t     tmp_blck[BLOCKBYTES];
+    uint8_t     out_blck[BLOCKBYTES];
     uint8_t     rtk1[BLOCKBYTES*8];
     tk1[0] = 0x01;          //init the 56-bit LFSR counter
     zeroize(tk1+1, TWEAKEYBYTES-1);
@@ -136,10 +144,18 @@ void romulusn_process_msg(
     } else {        //process all blocks except the last
         SET_DOMAIN(tk1, 0x04);
         while (inlen > BLOCKBYTES) {
-            if(mode == ENCRYPT_MODE)
+            if (bulk) {
+                BULK_PREFETCH(in);
+                if(mode == ENCRYPT_MODE)
+                    RHO(state, state_m, out_blck, in, tmp_blck);
+                else
+                    RHO_INV(state, state_m, in, out_blck, tmp_blck);
+                bulk_store_block(out, out_blck);
+            } else if(mode == ENCRYPT_MODE) {
                 RHO(state, state_m, out, in, tmp_blck);
-            else
+            } else {
                 RHO_INV(state, state_m, in, out, tmp_blck);
+            }
             UPDATE_CTR(tk1);
             tk_schedule_1(rtk1, tk1);
             skinny128_384_plus(state, state_m, state, state_m, rtk, rtk_m, rtk1);
@@ -147,6 +163,8 @@ void romulusn_process_msg(
             in      += BLOCKBYTES;
             inlen   -= BLOCKBYTES;
         }
+        if (bulk)
+            BULK_FENCE();
         // (eventually pad) and process the last block
         UPDATE_CTR(tk1);
         if (inlen < BLOCKBYTES) {
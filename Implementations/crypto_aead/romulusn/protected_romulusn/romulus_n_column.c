@@ -0,0 +1,145 @@
+/**
+ * Romulus-N fixed-width column encryption (w/ 1st-order masking
+ * countermeasure), see 'romulus_n_column.h'.
+ *
+ * With an empty AD and a message of nb full blocks, each cell goes through
+ * the same nb+1 Skinny calls: one with domain 0x1A to absorb the nonce (from
+ * the all-zero state), nb-1 with domain 0x04 after each message block but
+ * the last one and a final one with domain 0x14. Their TK1 round tweakeys
+ * only depend on nb and are computed upfront.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include "skinny128.h"
+#include "romulus_n_column.h"
+
+#define COLUMN_MAXBLOCKS    (ROMULUSN_COLUMN_MAXWIDTH/BLOCKBYTES)
+
+/**
+ * Equivalent to 'memset(buf, 0x00, buflen)'.
+ */
+static void zeroize(uint8_t buf[], int buflen)
+{
+  int i;
+  for(i = 0; i < buflen; i++)
+    buf[i] = 0x00;
+}
+
+/**
+ * Computes the TK1 round tweakeys of the nb+1 Skinny calls of a cell.
+ */
+static void column_rtk1(uint8_t rtk1[][BLOCKBYTES*8], int nb)
+{
+    uint32_t tmp;
+    uint8_t tk1[TWEAKEYBYTES];
+    tk1[0] = 0x01;
+    zeroize(tk1+1, TWEAKEYBYTES-1);
+    UPDATE_CTR(tk1);
+    SET_DOMAIN(tk1, 0x1A);
+    tk_schedule_1(rtk1[0], tk1);
+    tk1[0] = 0x01;                      // init the 56-bit LFSR counter
+    zeroize(tk1+1, TWEAKEYBYTES-1);
+    SET_DOMAIN(tk1, 0x04);
+    for(int j = 1; j <= nb; j++) {
+        UPDATE_CTR(tk1);
+        if (j == nb)
+            SET_DOMAIN(tk1, 0x14);
+        tk_schedule_1(rtk1[j], tk1);
+    }
+}
+
+/**
+ * Computes the round tweakeys of 'npub' and of the key, relying on the
+ * linearity of the tweakey schedule.
+ */
+static void column_rtk_23(
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS],
+    const uint8_t *npub, const romulusn_key *key)
+{
+    uint8_t zeros[TWEAKEYBYTES];
+    zeroize(zeros, TWEAKEYBYTES);
+    tks_lfsr_23(rtk_23, npub, zeros, SKINNY128_384_ROUNDS);
+    tks_perm_23_norc(rtk_23);
+    for(int i = 0; i < BLOCKBYTES*SKINNY128_384_ROUNDS/4; i++)
+        ((uint32_t *)rtk_23)[i] ^= ((const uint32_t *)key->rtk_23)[i];
+}
+
+/**
+ * Processes a cell of 'nb' blocks, leaving the final state in 'state' and
+ * 'state_m'.
+ */
+static void column_cell(
+    uint8_t *out, const uint8_t *in, int nb,
+    uint8_t state[BLOCKBYTES], uint8_t state_m[BLOCKBYTES],
+    const uint8_t *npub, const romulusn_key *key,
+    const uint8_t rtk1[][BLOCKBYTES*8], const int mode)
+{
+    uint32_t tmp;
+    uint8_t tmp_blck[BLOCKBYTES];
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS];
+    column_rtk_23(rtk_23, npub, key);
+    zeroize(state, BLOCKBYTES);
+    zeroize(state_m, BLOCKBYTES);
+    skinny128_384_plus(state, state_m, state, state_m, rtk_23, key->rtk_3m,
+        rtk1[0]);
+    for(int j = 1; j <= nb; j++) {
+        if (mode == ENCRYPT_MODE)
+            RHO(state, state_m, out, in, tmp_blck);
+        else
+            RHO_INV(state, state_m, in, out, tmp_blck);
+        skinny128_384_plus(state, state_m, state, state_m, rtk_23,
+            key->rtk_3m, rtk1[j]);
+        out += BLOCKBYTES;
+        in += BLOCKBYTES;
+    }
+}
+
+int romulusn_seal_column(
+    const romulusn_key *key,
+    const uint8_t nonces[][BLOCKBYTES],
+    const uint8_t *values, size_t width, size_t count,
+    uint8_t *out, uint8_t tags[][TAGBYTES])
+{
+    int nb = (int)(width / BLOCKBYTES);
+    uint8_t state[BLOCKBYTES], state_m[BLOCKBYTES];
+    uint8_t rtk1[COLUMN_MAXBLOCKS+1][BLOCKBYTES*8];
+    if (width == 0 || width % BLOCKBYTES || width > ROMULUSN_COLUMN_MAXWIDTH)
+        return -1;
+    column_rtk1(rtk1, nb);
+    for(size_t i = 0; i < count; i++) {
+        column_cell(out + i*width, values + i*width, nb, state, state_m,
+            nonces[i], key, (const uint8_t (*)[BLOCKBYTES*8])rtk1,
+            ENCRYPT_MODE);
+        romulusn_generate_tag(tags[i], state, state_m);
+    }
+    return 0;
+}
+
+int romulusn_open_column(
+    const romulusn_key *key,
+    const uint8_t nonces[][BLOCKBYTES],
+    const uint8_t *ciphertexts, const uint8_t tags[][TAGBYTES],
+    size_t width, size_t count,
+    uint8_t *out, uint32_t res[])
+{
+    int ret = 0, nb = (int)(width / BLOCKBYTES);
+    uint8_t state[BLOCKBYTES], state_m[BLOCKBYTES];
+    uint8_t rtk1[COLUMN_MAXBLOCKS+1][BLOCKBYTES*8];
+    if (width == 0 || width % BLOCKBYTES || width > ROMULUSN_COLUMN_MAXWIDTH)
+        return -1;
+    column_rtk1(rtk1, nb);
+    for(size_t i = 0; i < count; i++) {
+        column_cell(out + i*width, ciphertexts + i*width, nb, state, state_m,
+            nonces[i], key, (const uint8_t (*)[BLOCKBYTES*8])rtk1,
+            DECRYPT_MODE);
+        res[i] = romulusn_verify_tag(tags[i], state, state_m);
+        if (res[i]) {
+            zeroize(out + i*width, (int)width);
+            ret = 1;
+        }
+    }
+    return ret;
+}
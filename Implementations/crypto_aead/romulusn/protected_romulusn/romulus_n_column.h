@@ -0,0 +1,43 @@
+#ifndef ROMULUSN_COLUMN_H_
+#define ROMULUSN_COLUMN_H_
+
+#include <stddef.h>
+#include "romulus_n_stream.h"
+
+//Fixed-width column encryption for Romulus-N, e.g. for database cells of
+//constant width encrypted under per-row nonces without associated data.
+//
+//All arrays are contiguous (structure of arrays): the i-th cell is made of
+//'nonces[i]', 'values + i*width' (resp. 'out + i*width') and 'tags[i]'. The
+//output is the same as a call to 'crypto_aead_encrypt' per cell with an
+//empty AD, the ciphertext being split into 'out' and 'tags'. 'out' may be
+//equal to 'values' (in-place processing), partial overlaps are not supported.
+//
+//Since all cells have the same shape, the sequence of Skinny calls is fixed:
+//the round tweakeys of TK1 (counter and domain of each call) are computed
+//once per column rather than once per call, and cells are processed without
+//any length-dependent branching. Only the round tweakeys of each nonce are
+//computed per cell, from the ones of the shared key context.
+//
+//'width' must be a multiple of BLOCKBYTES no greater than
+//ROMULUSN_COLUMN_MAXWIDTH.
+#define ROMULUSN_COLUMN_MAXWIDTH    (16*BLOCKBYTES)
+
+//Returns 0, or -1 if 'width' is not supported.
+int romulusn_seal_column(
+    const romulusn_key *key,
+    const uint8_t nonces[][BLOCKBYTES],
+    const uint8_t *values, size_t width, size_t count,
+    uint8_t *out, uint8_t tags[][TAGBYTES]);
+
+//'res[i]' is set to a non-zero value if tag verification fails for the i-th
+//cell, whose plaintext is then zeroized. Returns a non-zero value if
+//verification fails for at least one cell, -1 if 'width' is not supported.
+int romulusn_open_column(
+    const romulusn_key *key,
+    const uint8_t nonces[][BLOCKBYTES],
+    const uint8_t *ciphertexts, const uint8_t tags[][TAGBYTES],
+    size_t width, size_t count,
+    uint8_t *out, uint32_t res[]);
+
+#endif  // ROMULUSN_COLUMN_H_
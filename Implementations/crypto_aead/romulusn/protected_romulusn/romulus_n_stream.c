@@ -0,0 +1,380 @@
+/**
+ * Romulus-N streaming interface (w/ 1st-order masking countermeasure).
+ *
+ * Same computations as 'romulusn_process_ad' and 'romulusn_process_msg'
+ * except that the inputs can be split across several calls, with compact
+ * per-stream contexts referring to shared per-key round tweakeys (see
+ * 'romulus_n_stream.h').
+ *
+ * Whether a full block is the last one only matters for the Skinny call that
+ * follows it: for AD, the TK1 domain is only updated before the final call
+ * with the nonce; for the message, the output block does not depend on it.
+ * Blocks are thus processed as soon as they are complete, the Skinny call
+ * following the last full message block being deferred until more input or
+ * finalization.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <stdlib.h>
+#include "skinny128.h"
+#include "randombytes.h"
+#include "romulus_n_stream.h"
+
+#define STREAM_AD_ODD       0   // odd AD blocks are xored to the state
+#define STREAM_AD_EVEN      1   // even AD blocks are passed as TK2
+#define STREAM_MSG          2
+
+#define EXPORT_PENDING      0x01
+#define EXPORT_EMPTY        0x02
+
+/**
+ * Equivalent to 'memset(buf, 0x00, buflen)'.
+ */
+static void zeroize(uint8_t buf[], int buflen)
+{
+  int i;
+  for(i = 0; i < buflen; i++)
+    buf[i] = 0x00;
+}
+
+/**
+ * Equivalent to 'memcpy(dest, src, srclen)'.
+ */
+static void copy(uint8_t dest[], const uint8_t src[], int srclen)
+{
+  int i;
+  for(i = 0; i < srclen; i++)
+    dest[i] = src[i];
+}
+
+romulusn_key *romulusn_key_new(const uint8_t *k, const uint8_t *k_m)
+{
+    uint8_t zeros[TWEAKEYBYTES];
+    romulusn_key *key = malloc(sizeof(romulusn_key));
+    if (key == NULL)
+        return NULL;
+    zeroize(zeros, TWEAKEYBYTES);
+    tks_lfsr_23(key->rtk_23, zeros, k, SKINNY128_384_ROUNDS);
+    tks_perm_23(key->rtk_23);
+    tks_lfsr_3(key->rtk_3m, k_m, SKINNY128_384_ROUNDS);
+    tks_perm_23_norc(key->rtk_3m);
+    key->refcount = 1;
+    return key;
+}
+
+void romulusn_key_retain(romulusn_key *key)
+{
+    __atomic_add_fetch(&key->refcount, 1, __ATOMIC_RELAXED);
+}
+
+void romulusn_key_release(romulusn_key *key)
+{
+    if (__atomic_sub_fetch(&key->refcount, 1, __ATOMIC_ACQ_REL) != 0)
+        return;
+    zeroize((uint8_t *)key, sizeof(romulusn_key));
+    free(key);
+}
+
+/**
+ * Computes the round tweakeys of 'tk2' and of the key, relying on the
+ * linearity of the tweakey schedule.
+ */
+static void stream_rtk_23(
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS],
+    const uint8_t *tk2, const romulusn_key *key)
+{
+    uint8_t zeros[TWEAKEYBYTES];
+    zeroize(zeros, TWEAKEYBYTES);
+    tks_lfsr_23(rtk_23, tk2, zeros, SKINNY128_384_ROUNDS);
+    tks_perm_23_norc(rtk_23);
+    for(int i = 0; i < BLOCKBYTES*SKINNY128_384_ROUNDS/4; i++)
+        ((uint32_t *)rtk_23)[i] ^= ((const uint32_t *)key->rtk_23)[i];
+}
+
+/**
+ * Encrypts the internal state with the current TK1 and 'rtk_23'.
+ */
+static void stream_block(
+    romulusn_stream_ctx *ctx,
+    const uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS])
+{
+    uint8_t tk1[TWEAKEYBYTES];
+    uint8_t rtk1[BLOCKBYTES*8];
+    copy(tk1, ctx->tk1, 8);
+    zeroize(tk1 + 8, TWEAKEYBYTES-8);
+    tk_schedule_1(rtk1, tk1);
+    skinny128_384_plus(ctx->state, ctx->state_m, ctx->state, ctx->state_m,
+        rtk_23, ctx->key->rtk_3m, rtk1);
+}
+
+void romulusn_stream_init(
+    romulusn_stream_ctx *ctx,
+    romulusn_key *key,
+    const uint8_t *npub)
+{
+    romulusn_key_retain(key);
+    ctx->key = key;
+    zeroize(ctx->state, BLOCKBYTES);
+    zeroize(ctx->state_m, BLOCKBYTES);
+    copy(ctx->npub, npub, BLOCKBYTES);
+    ctx->tk1[0] = 0x01;
+    zeroize(ctx->tk1+1, 7);
+    SET_DOMAIN(ctx->tk1, 0x08);
+    ctx->phase = STREAM_AD_ODD;
+    ctx->pos = 0;
+    ctx->pending = 0;
+    ctx->empty = 1;
+}
+
+/**
+ * Additional data absorption. Must be called before any message update.
+ */
+void romulusn_ad_update(
+    romulusn_stream_ctx *ctx,
+    const uint8_t *ad, unsigned long long adlen)
+{
+    uint32_t tmp;
+    uint32_t n;
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS];
+    while (adlen > 0) {
+        n = BLOCKBYTES - ctx->pos;
+        if (adlen < n)
+            n = (uint32_t)adlen;
+        if (ctx->phase == STREAM_AD_ODD) {
+            if (ctx->pos == 0)
+                UPDATE_CTR(ctx->tk1);
+            for(uint32_t i = 0; i < n; i++)
+                ctx->state[ctx->pos + i] ^= ad[i];
+        } else {
+            copy(ctx->buf + ctx->pos, ad, n);
+        }
+        ctx->pos += n;
+        ad += n;
+        adlen -= n;
+        ctx->empty = 0;
+        if (ctx->pos < BLOCKBYTES)
+            continue;
+        if (ctx->phase == STREAM_AD_EVEN) {
+            stream_rtk_23(rtk_23, ctx->buf, ctx->key);
+            stream_block(ctx, rtk_23);
+            UPDATE_CTR(ctx->tk1);
+        }
+        ctx->phase ^= 1;
+        ctx->pos = 0;
+    }
+}
+
+/**
+ * Processes the left-over AD block and the nonce, then prepares the context
+ * for message processing. 'rtk_23' receives the round tweakeys of the nonce.
+ */
+static void end_ad(
+    romulusn_stream_ctx *ctx,
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS])
+{
+    uint32_t tmp;
+    if (ctx->empty) {                   // AD is an empty string
+        UPDATE_CTR(ctx->tk1);
+        SET_DOMAIN(ctx->tk1, 0x1A);
+    } else if (ctx->pos == 0) {         // Left-over complete (double) block
+        SET_DOMAIN(ctx->tk1, 0x18);
+    } else if (ctx->phase == STREAM_AD_EVEN) {  // Left-over partial double block
+        zeroize(ctx->buf + ctx->pos, 15 - ctx->pos);
+        ctx->buf[15] = ctx->pos;
+        stream_rtk_23(rtk_23, ctx->buf, ctx->key);
+        stream_block(ctx, rtk_23);
+        UPDATE_CTR(ctx->tk1);
+        SET_DOMAIN(ctx->tk1, 0x1A);
+    } else {                            // Left-over partial single block
+        ctx->state[15] ^= ctx->pos;
+        SET_DOMAIN(ctx->tk1, 0x1A);
+    }
+    stream_rtk_23(rtk_23, ctx->npub, ctx->key);
+    stream_block(ctx, rtk_23);
+    ctx->tk1[0] = 0x01;                 // init the 56-bit LFSR counter
+    zeroize(ctx->tk1+1, 7);
+    SET_DOMAIN(ctx->tk1, 0x04);
+    ctx->phase = STREAM_MSG;
+    ctx->pos = 0;
+    ctx->empty = 1;
+}
+
+/**
+ * Encryption/decryption. Full blocks are processed with RHO/RHO_INV while
+ * bytes of partial blocks are processed one by one, so that the output length
+ * always matches the input length.
+ */
+static void msg_update(
+    romulusn_stream_ctx *ctx,
+    uint8_t *out, const uint8_t *in, unsigned long long inlen,
+    const int mode)
+{
+    uint32_t tmp;
+    uint32_t pos;
+    int have_rtk = 0;
+    uint8_t tmp_blck[BLOCKBYTES];
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS];
+    if (ctx->phase != STREAM_MSG) {
+        end_ad(ctx, rtk_23);
+        have_rtk = 1;
+    }
+    while (inlen > 0) {
+        if (ctx->pending) {             // the last full block was not the last one
+            if (!have_rtk) {
+                stream_rtk_23(rtk_23, ctx->npub, ctx->key);
+                have_rtk = 1;
+            }
+            UPDATE_CTR(ctx->tk1);
+            stream_block(ctx, rtk_23);
+            ctx->pending = 0;
+        }
+        pos = ctx->pos;
+        ctx->empty = 0;
+        if (pos == 0 && inlen >= BLOCKBYTES) {
+            if (mode == ENCRYPT_MODE)
+                RHO(ctx->state, ctx->state_m, out, in, tmp_blck);
+            else
+                RHO_INV(ctx->state, ctx->state_m, in, out, tmp_blck);
+            ctx->pending = 1;
+            out += BLOCKBYTES;
+            in += BLOCKBYTES;
+            inlen -= BLOCKBYTES;
+            continue;
+        }
+        tmp = in[0];                    // Use of tmp variable in case c = m
+        out[0] = in[0] ^ (ctx->state[pos] >> 1) ^ (ctx->state[pos] & 0x80) ^
+            (ctx->state[pos] << 7);
+        out[0] ^= (ctx->state_m[pos] >> 1) ^ (ctx->state_m[pos] & 0x80) ^
+            (ctx->state_m[pos] << 7);
+        ctx->state[pos] ^= (mode == ENCRYPT_MODE) ? (uint8_t)tmp : out[0];
+        if (++ctx->pos == BLOCKBYTES) {
+            ctx->pos = 0;
+            ctx->pending = 1;
+        }
+        out += 1;
+        in += 1;
+        inlen -= 1;
+    }
+}
+
+/**
+ * Processes the last message block, leaving the final state in the context.
+ * The key reference is released.
+ */
+static void msg_final(romulusn_stream_ctx *ctx)
+{
+    uint32_t tmp;
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS];
+    if (ctx->phase != STREAM_MSG)
+        end_ad(ctx, rtk_23);
+    else
+        stream_rtk_23(rtk_23, ctx->npub, ctx->key);
+    UPDATE_CTR(ctx->tk1);
+    if (ctx->pending) {                 // Last block is complete
+        SET_DOMAIN(ctx->tk1, 0x14);
+    } else {                            // Empty or partial last block
+        ctx->state[15] ^= ctx->pos;     // Padding
+        SET_DOMAIN(ctx->tk1, 0x15);
+    }
+    stream_block(ctx, rtk_23);
+    romulusn_key_release(ctx->key);
+    ctx->key = NULL;
+}
+
+void romulusn_encrypt_update(
+    romulusn_stream_ctx *ctx,
+    uint8_t *c, const uint8_t *m, unsigned long long mlen)
+{
+    msg_update(ctx, c, m, mlen, ENCRYPT_MODE);
+}
+
+void romulusn_decrypt_update(
+    romulusn_stream_ctx *ctx,
+    uint8_t *m, const uint8_t *c, unsigned long long clen)
+{
+    msg_update(ctx, m, c, clen, DECRYPT_MODE);
+}
+
+void romulusn_encrypt_final(romulusn_stream_ctx *ctx, uint8_t *tag)
+{
+    msg_final(ctx);
+    romulusn_generate_tag(tag, ctx->state, ctx->state_m);
+}
+
+uint32_t romulusn_decrypt_final(romulusn_stream_ctx *ctx, const uint8_t *tag)
+{
+    msg_final(ctx);
+    return romulusn_verify_tag(tag, ctx->state, ctx->state_m);
+}
+
+void romulusn_stream_abort(romulusn_stream_ctx *ctx)
+{
+    romulusn_key_release(ctx->key);
+    zeroize((uint8_t *)ctx, sizeof(romulusn_stream_ctx));
+}
+
+void romulusn_stream_export(
+    const romulusn_stream_ctx *ctx,
+    uint8_t out[ROMULUSN_STREAM_EXPORTBYTES])
+{
+    out[0] = 'R';
+    out[1] = 'N';
+    out[2] = 'S';
+    out[3] = 'T';
+    out[4] = ROMULUSN_STREAM_VERSION;
+    out[5] = ctx->phase;
+    out[6] = ctx->pos;
+    out[7] = (ctx->pending ? EXPORT_PENDING : 0) | (ctx->empty ? EXPORT_EMPTY : 0);
+    copy(out + 8, ctx->tk1, 8);
+    randombytes(out + 32, BLOCKBYTES);  // shares are refreshed, not unmasked
+    for(int i = 0; i < BLOCKBYTES; i++) {
+        out[16 + i] = ctx->state[i] ^ out[32 + i];
+        out[32 + i] ^= ctx->state_m[i];
+    }
+    copy(out + 48, ctx->npub, BLOCKBYTES);
+    zeroize(out + 64, BLOCKBYTES);
+    if (ctx->phase == STREAM_AD_EVEN)
+        copy(out + 64, ctx->buf, ctx->pos);
+}
+
+int romulusn_stream_import(
+    romulusn_stream_ctx *ctx,
+    romulusn_key *key,
+    const uint8_t in[ROMULUSN_STREAM_EXPORTBYTES])
+{
+    uint8_t phase = in[5], pos = in[6], flags = in[7];
+    if (in[0] != 'R' || in[1] != 'N' || in[2] != 'S' || in[3] != 'T' ||
+        in[4] != ROMULUSN_STREAM_VERSION || phase > STREAM_MSG ||
+        pos >= BLOCKBYTES || (flags & ~(EXPORT_PENDING | EXPORT_EMPTY)))
+        return -1;
+    // the domain only changes when leaving the AD phases or at finalization
+    if (in[15] != ((phase == STREAM_MSG) ? 0x04 : 0x08))
+        return -1;
+    // the 56-bit LFSR counter never reaches zero
+    if ((in[8] | in[9] | in[10] | in[11] | in[12] | in[13] | in[14]) == 0)
+        return -1;
+    // a deferred Skinny call only follows a full message block
+    if ((flags & EXPORT_PENDING) && (phase != STREAM_MSG || pos != 0))
+        return -1;
+    for(int i = (phase == STREAM_AD_EVEN) ? pos : 0; i < BLOCKBYTES; i++)
+        if (in[64 + i] != 0)
+            return -1;
+    romulusn_key_retain(key);
+    ctx->key = key;
+    randombytes(ctx->state_m, BLOCKBYTES);
+    for(int i = 0; i < BLOCKBYTES; i++) {
+        ctx->state[i] = in[16 + i] ^ ctx->state_m[i];
+        ctx->state_m[i] ^= in[32 + i];
+    }
+    copy(ctx->npub, in + 48, BLOCKBYTES);
+    copy(ctx->buf, in + 64, BLOCKBYTES);
+    copy(ctx->tk1, in + 8, 8);
+    ctx->phase = phase;
+    ctx->pos = pos;
+    ctx->pending = (flags & EXPORT_PENDING) ? 1 : 0;
+    ctx->empty = (flags & EXPORT_EMPTY) ? 1 : 0;
+    return 0;
+}
@@ -0,0 +1,109 @@
+#ifndef ROMULUSN_STREAM_H_
+#define ROMULUSN_STREAM_H_
+
+#include "romulus_n.h"
+
+//Streaming interface for Romulus-N, sized for hosts keeping up to millions of
+//streams open at once.
+//
+//Encryption:  romulusn_stream_init, romulusn_ad_update*, romulusn_encrypt_update*,
+//             romulusn_encrypt_final (outputs the tag).
+//Decryption:  romulusn_stream_init, romulusn_ad_update*, romulusn_decrypt_update*,
+//             romulusn_decrypt_final (verifies the tag). The plaintext must not
+//             be used before romulusn_decrypt_final succeeds.
+//
+//The round tweakeys of the key (1.3 KB) are computed once per key into a
+//shared, reference-counted 'romulusn_key', each stream holding a reference
+//until it is finalized. Since the tweakey schedule is linear, the round
+//tweakeys of the nonce are recomputed at most once per update call and added
+//to the ones of the key instead of being stored in the stream.
+//
+//Streams do not buffer any message byte: full AD blocks are absorbed as soon
+//as they are complete, message bytes are encrypted as they come, and only the
+//Skinny call following the last full message block is deferred, its domain
+//depending on whether more input follows. Only a partial even AD block (used
+//as TK2) is buffered.
+typedef struct {
+    uint8_t rtk_23[BLOCKBYTES*SKINNY128_384_ROUNDS];    // LFSR3(k) w/ round constants
+    uint8_t rtk_3m[BLOCKBYTES*SKINNY128_384_ROUNDS];    // LFSR3(k_m)
+    uint32_t refcount;
+} romulusn_key;
+
+typedef struct {
+    uint8_t state[BLOCKBYTES];                          // internal state (1st share)
+    uint8_t state_m[BLOCKBYTES];                        // internal state (2nd share)
+    uint8_t npub[BLOCKBYTES];
+    uint8_t buf[BLOCKBYTES];                            // partial even AD block
+    romulusn_key *key;
+    uint8_t tk1[8];                                     // counter and domain
+    uint8_t phase;
+    uint8_t pos;                                        // bytes in current block
+    uint8_t pending;                                    // deferred Skinny call
+    uint8_t empty;                                      // no input in this phase
+} romulusn_stream_ctx;
+
+//Expands the key shares into a new context whose reference is returned.
+//Returns NULL if allocation fails.
+romulusn_key *romulusn_key_new(const uint8_t *k, const uint8_t *k_m);
+
+//Reference counting is atomic, so that keys can be shared across threads.
+//The context is wiped and freed once its last reference is released.
+void romulusn_key_retain(romulusn_key *key);
+void romulusn_key_release(romulusn_key *key);
+
+//Takes a reference to 'key', released by romulusn_{en,de}crypt_final or
+//romulusn_stream_abort.
+void romulusn_stream_init(
+    romulusn_stream_ctx *ctx,
+    romulusn_key *key,
+    const uint8_t *npub);
+
+void romulusn_ad_update(
+    romulusn_stream_ctx *ctx,
+    const uint8_t *ad, unsigned long long adlen);
+
+void romulusn_encrypt_update(
+    romulusn_stream_ctx *ctx,
+    uint8_t *c, const uint8_t *m, unsigned long long mlen);
+
+void romulusn_encrypt_final(romulusn_stream_ctx *ctx, uint8_t *tag);
+
+void romulusn_decrypt_update(
+    romulusn_stream_ctx *ctx,
+    uint8_t *m, const uint8_t *c, unsigned long long clen);
+
+//Returns non-zero value if verification fails.
+uint32_t romulusn_decrypt_final(romulusn_stream_ctx *ctx, const uint8_t *tag);
+
+//Releases the key reference of a stream which is not to be finalized (e.g.
+//closed connection).
+void romulusn_stream_abort(romulusn_stream_ctx *ctx);
+
+//Export of an in-progress stream, e.g. to resume it on another host sharing
+//the key, in a stable versioned format of ROMULUSN_STREAM_EXPORTBYTES bytes:
+//  "RNST" | version | phase | pos | flags (bit 0: pending, bit 1: empty) |
+//  TK1 counter and domain (8 bytes) | internal state, 1st share (16 bytes) |
+//  internal state, 2nd share (16 bytes) | nonce (16 bytes) |
+//  partial even AD block, zero-padded (16 bytes)
+//The internal state is exported as two shares, remasked with fresh
+//randomness, so that it is never recombined. No key material is exported,
+//but both shares together determine the next keystream block: exports must
+//only travel over confidential channels.
+//The stream is left untouched and can be aborted once the export is stored.
+#define ROMULUSN_STREAM_VERSION     2
+#define ROMULUSN_STREAM_EXPORTBYTES 80
+
+void romulusn_stream_export(
+    const romulusn_stream_ctx *ctx,
+    uint8_t out[ROMULUSN_STREAM_EXPORTBYTES]);
+
+//Resumes an exported stream under 'key', of which a reference is taken as in
+//romulusn_stream_init. The shares of the internal state are refreshed with
+//fresh randomness. Returns 0 on success, -1 if 'in' is not a valid export (in
+//which case no reference is taken).
+int romulusn_stream_import(
+    romulusn_stream_ctx *ctx,
+    romulusn_key *key,
+    const uint8_t in[ROMULUSN_STREAM_EXPORTBYTES]);
+
+#endif  // ROMULUSN_STREAM_H_
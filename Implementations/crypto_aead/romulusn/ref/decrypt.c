@@ -12,6 +12,7 @@
 #include "variant.h"
 #include "skinny.h"
 #include "romulus_n.h"
+#include "romulus_usdt.h"
 
 int crypto_aead_decrypt(
 unsigned char *m,unsigned long long *mlen,
@@ -22,7 +23,10 @@ const unsigned char *npub,
 const unsigned char *k
 )
 {
-
-  return romulus_n_decrypt(m,mlen,nsec,c,clen,ad,adlen,npub,k);
+  int ret;
+  ROMULUS_PROBE3(aead_decrypt_entry,"romulus-n",adlen,clen);
+  ret = romulus_n_decrypt(m,mlen,nsec,c,clen,ad,adlen,npub,k);
+  ROMULUS_PROBE4(aead_decrypt_return,"romulus-n",adlen,clen,ret);
+  return ret;
   
 }
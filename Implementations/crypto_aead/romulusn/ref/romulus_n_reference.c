@@ -58,6 +58,7 @@ void rho_ad (const unsigned char* m,
 }
 
 // Rho(S,M): pads an M block and outputs S'= M xor S and C = M xor G(S) 
+// Only len8 bytes are written to C, so that C and M can be the same buffer
 void rho (const unsigned char* m,
 	  unsigned char* c,
 	  unsigned char* s,
@@ -65,23 +66,22 @@ void rho (const unsigned char* m,
 	  int ver) {
   int i;
   unsigned char mp [16];
+  unsigned char gs [16];
 
   pad(m,mp,ver,len8);
 
-  g8A(s,c);
+  g8A(s,gs);
   for (i = 0; i < ver; i++) {
     s[i] = s[i] ^ mp[i];
     if (i < len8) {
-      c[i] = c[i] ^ mp[i];
-    }
-    else {
-      c[i] = 0;
+      c[i] = gs[i] ^ mp[i];
     }
   }
   
 }
 
 // Inverse-Rho(S,M): pads a C block and outputs S'= C xor G(S) xor S and M = C xor G(S) 
+// Only len8 bytes are written to M, so that C and M can be the same buffer
 void irho (unsigned char* m,
 	  const unsigned char* c,
 	  unsigned char* s,
@@ -89,22 +89,20 @@ void irho (unsigned char* m,
 	  int ver) {
   int i;
   unsigned char cp [16];
+  unsigned char gs [16];
 
   pad(c,cp,ver,len8);
 
-  g8A(s,m);
+  g8A(s,gs);
   for (i = 0; i < ver; i++) {
     if (i < len8) {
-      s[i] = s[i] ^ cp[i] ^ m[i];
+      s[i] = s[i] ^ cp[i] ^ gs[i];
     }
     else {
       s[i] = s[i] ^ cp[i];
     }
     if (i < len8) {
-      m[i] = m[i] ^ cp[i];
-    }
-    else {
-      m[i] = 0;
+      m[i] = gs[i] ^ cp[i];
     }
   }
   
@@ -179,17 +177,38 @@ void block_cipher(unsigned char* s,
 
 }
 
-// Calls the TBC using the nonce as part of the tweakey
-void nonce_encryption (const unsigned char* N,
-		       unsigned char* CNT,
-		       unsigned char*s, const unsigned char* k,
-		       int t, unsigned char D) {
-  unsigned char T [16];
-  int i;  
-  for (i = 0; i < t; i++) {
+// Precomputes the subtweakeys of TK2 || TK3 = N || K, which are the same for all the TBC calls
+// using the nonce
+void nonce_key_schedule (unsigned char* rtk23,
+			 const unsigned char* N,
+			 const unsigned char* k) {
+  unsigned char T [32];
+  int i;
+  for (i = 0; i < 16; i++) {
     T[i] = N[i];
-  }  
-  block_cipher(s,k,T,CNT,D,t);
+    T[i+16] = k[i];
+  }
+  skinny_128_384_plus_ks(rtk23,T);
+
+}
+
+// Calls the TBC using the nonce as part of the tweakey, from the subtweakeys computed by
+// nonce_key_schedule: only TK1 (counter and domain bits) is composed for each call
+void nonce_encryption (const unsigned char* rtk23,
+		       unsigned char* CNT,
+		       unsigned char*s,
+		       unsigned char D) {
+  unsigned char KT [16];
+  int i;
+
+  for (i = 0; i < 7; i++) {
+    KT[i] = CNT[i];
+  }
+  KT[i] = D;
+  for (i = 8; i < 16; i++) {
+    KT[i] = 0x00;
+  }
+  skinny_128_384_plus_enc_with_rtk(s,KT,rtk23);
 
 }
 
@@ -205,10 +224,10 @@ void generate_tag (unsigned char** c, unsigned char* s,
 
 // Absorbs and encrypts the message blocks.
 unsigned long long msg_encryption (const unsigned char** M, unsigned char** c,
-				   const unsigned char* N,
+				   const unsigned char* rtk23,
 				   unsigned char* CNT,
-				   unsigned char*s, const unsigned char* k,
-				   unsigned int n, unsigned int t, unsigned char D,
+				   unsigned char*s,
+				   unsigned int n, unsigned char D,
 				   unsigned long long mlen, char d) {
   int len8;
 
@@ -230,7 +249,7 @@ unsigned long long msg_encryption (const unsigned char** M, unsigned char** c,
   *c = *c + len8;
   *M = *M + len8;
   lfsr_gf56(CNT);
-  nonce_encryption(N,CNT,s,k,t,D);
+  nonce_encryption(rtk23,CNT,s,D);
   return mlen;
 }
 
@@ -287,6 +306,7 @@ int romulus_n (
   unsigned char s[16];
   unsigned char CNT[7];
   unsigned char T[16];
+  unsigned char rtk23[SKINNY_RTK23_BYTES];
   const unsigned char* A;
   const unsigned char* I;
   const unsigned char* N;
@@ -304,27 +324,29 @@ int romulus_n (
     s[i] = 0;
   }      
   reset_lfsr_gf56(CNT);
+  // TK2 and TK3 are fixed to N and K in all the calls to nonce_encryption
+  nonce_key_schedule(rtk23,N,k);
 
   if (adlen == 0) { // AD is an empty string
     lfsr_gf56(CNT);
-    nonce_encryption(N,CNT,s,k,t,0x1a);
+    nonce_encryption(rtk23,CNT,s,0x1a);
   }
   else while (adlen > 0) {
       if (adlen < n) { // The last block of AD is odd and incomplete
 	adlen = ad_encryption(&A,s,k,adlen,CNT,0x08,n,t);
-	nonce_encryption(N,CNT,s,k,t,0x1a);
+	nonce_encryption(rtk23,CNT,s,0x1a);
       }
       else if (adlen == n) { // The last block of AD is odd and complete
 	adlen = ad_encryption(&A,s,k,adlen,CNT,0x08,n,t);
-	nonce_encryption(N,CNT,s,k,t,0x18); 
+	nonce_encryption(rtk23,CNT,s,0x18); 
       }    
       else if (adlen < (n+t)) { // The last block of AD is even and incomplete
 	adlen = ad_encryption(&A,s,k,adlen,CNT,0x08,n,t);
-	nonce_encryption(N,CNT,s,k,t,0x1a); 
+	nonce_encryption(rtk23,CNT,s,0x1a); 
       }
       else if (adlen == (n+t)) { // The last block of AD is even and complete
 	adlen = ad_encryption(&A,s,k,adlen,CNT,0x08,n,t);
-	nonce_encryption(N,CNT,s,k,t,0x18); 
+	nonce_encryption(rtk23,CNT,s,0x18); 
       }
       else { // A normal full pair of blocks of AD
 	adlen = ad_encryption(&A,s,k,adlen,CNT,0x08,n,t);
@@ -344,17 +366,17 @@ int romulus_n (
   
   if (mlen == 0) { // M is an empty string
     lfsr_gf56(CNT);
-    nonce_encryption(N,CNT,s,k,t,0x15);
+    nonce_encryption(rtk23,CNT,s,0x15);
   }  
   else while (mlen > 0) {
     if (mlen < n) { // The last block of M is incomplete
-      mlen = msg_encryption(&I,&c,N,CNT,s,k,n,t,0x15,mlen,d);
+      mlen = msg_encryption(&I,&c,rtk23,CNT,s,n,0x15,mlen,d);
     }
     else if (mlen == n) { // The last block of M is complete
-      mlen = msg_encryption(&I,&c,N,CNT,s,k,n,t,0x14,mlen,d);
+      mlen = msg_encryption(&I,&c,rtk23,CNT,s,n,0x14,mlen,d);
     }
     else { // A normal full message block
-      mlen = msg_encryption(&I,&c,N,CNT,s,k,n,t,0x04,mlen,d);
+      mlen = msg_encryption(&I,&c,rtk23,CNT,s,n,0x04,mlen,d);
     }
   }
 
@@ -0,0 +1,125 @@
+/*
+ * In-place encryption and decryption (c == m) checked against the KAT file.
+ *
+ * For each test vector, the plaintext is encrypted and the ciphertext then
+ * decrypted within a single buffer, the ciphertext being expected to match
+ * the KAT and the plaintext to be recovered. The KAT covers all plaintext
+ * lengths up to 32 bytes, so every partial last block is exercised, where a
+ * full padded block used to be written over the tag on in-place decryption.
+ * The tag is also altered once in place to check that decryption fails.
+ *
+ * Build from the 'ref' directory ('crypto_aead.h' comes with the framework):
+ *   cc -O2 -I. -o inplace_kat test/inplace_kat.c encrypt.c decrypt.c \
+ *      romulus_n_reference.c skinny_reference.c
+ * Usage:
+ *   inplace_kat ../LWC_AEAD_KAT_128_128.txt
+ *
+ * Date: October 2026
+ * Contact: Alexandre Adomnicai (alex.adomnicai@gmail.com)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "crypto_aead.h"
+#include "api.h"
+
+#define MAX_MSGBYTES  32
+#define MAX_ADBYTES   32
+#define MAX_LINEBYTES 256
+
+// Parses the hex string after 'prefix' in 'line' into 'out', returns its length
+// in bytes, or -1 if 'line' does not start with 'prefix' or is too long
+static int parse_hex(const char* line,
+                     const char* prefix,
+                     unsigned char* out,
+                     int maxlen) {
+  int len = 0;
+  unsigned int v;
+
+  if (strncmp(line,prefix,strlen(prefix))) {
+    return -1;
+  }
+  line += strlen(prefix);
+  while (sscanf(line,"%2x",&v) == 1) {
+    if (len == maxlen) {
+      return -1;
+    }
+    out[len++] = (unsigned char)v;
+    line += 2;
+  }
+  return len;
+}
+
+// Returns 0 if the vector passes in place, prints the failure otherwise
+static int check_vector(int count,
+                        const unsigned char* pt, int ptlen,
+                        const unsigned char* ad, int adlen,
+                        const unsigned char* ct, int ctlen,
+                        const unsigned char* npub,
+                        const unsigned char* k) {
+  unsigned char buf[MAX_MSGBYTES+CRYPTO_ABYTES];
+  unsigned long long len;
+
+  memcpy(buf,pt,ptlen);
+  crypto_aead_encrypt(buf,&len,buf,ptlen,ad,adlen,NULL,npub,k);
+  if (len != (unsigned long long)ctlen || memcmp(buf,ct,ctlen)) {
+    printf("Count = %d: in-place encryption mismatch\n",count);
+    return 1;
+  }
+  if (crypto_aead_decrypt(buf,&len,NULL,buf,ctlen,ad,adlen,npub,k) ||
+      len != (unsigned long long)ptlen || memcmp(buf,pt,ptlen)) {
+    printf("Count = %d: in-place decryption failed\n",count);
+    return 1;
+  }
+  memcpy(buf,ct,ctlen);
+  buf[ctlen-1] ^= 0x01;
+  if (!crypto_aead_decrypt(buf,&len,NULL,buf,ctlen,ad,adlen,npub,k)) {
+    printf("Count = %d: altered tag accepted in place\n",count);
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  unsigned char k[CRYPTO_KEYBYTES];
+  unsigned char npub[CRYPTO_NPUBBYTES];
+  unsigned char pt[MAX_MSGBYTES];
+  unsigned char ad[MAX_ADBYTES];
+  unsigned char ct[MAX_MSGBYTES+CRYPTO_ABYTES];
+  char line[MAX_LINEBYTES];
+  int count = 0, ptlen = 0, adlen = 0, ctlen;
+  int vectors = 0, failures = 0;
+  FILE* f;
+
+  if (argc != 2 || (f = fopen(argv[1],"r")) == NULL) {
+    fprintf(stderr,"usage: %s <LWC_AEAD_KAT file>\n",argv[0]);
+    return 2;
+  }
+  while (fgets(line,sizeof(line),f) != NULL) {
+    if (sscanf(line,"Count = %d",&count) == 1) {
+      continue;
+    }
+    parse_hex(line,"Key = ",k,CRYPTO_KEYBYTES);
+    parse_hex(line,"Nonce = ",npub,CRYPTO_NPUBBYTES);
+    if (!strncmp(line,"PT = ",5)) {
+      ptlen = parse_hex(line,"PT = ",pt,MAX_MSGBYTES);
+    }
+    if (!strncmp(line,"AD = ",5)) {
+      adlen = parse_hex(line,"AD = ",ad,MAX_ADBYTES);
+    }
+    ctlen = parse_hex(line,"CT = ",ct,MAX_MSGBYTES+CRYPTO_ABYTES);
+    if (ctlen < 0) {
+      continue;
+    }
+    if (ptlen < 0 || adlen < 0 || ctlen != ptlen + CRYPTO_ABYTES) {
+      printf("Count = %d: malformed vector\n",count);
+      fclose(f);
+      return 2;
+    }
+    failures += check_vector(count,pt,ptlen,ad,adlen,ct,ctlen,npub,k);
+    vectors++;
+  }
+  fclose(f);
+  printf("%d vectors, %d in-place failures\n",vectors,failures);
+  return failures != 0;
+}
@@ -0,0 +1,560 @@
+/**
+ * Romulus-T portable C implementation (w/ d-th order masking countermeasure,
+ * d = MASKING_ORDER being 1 by default)
+ * following the API defined in the Call for Protected Software Implementations
+ * of Finalists in the NIST Lightweight Cryptography Standardization Process
+ * by George Mason Univeristy: https://cryptography.gmu.edu/athena/LWC/Call_for
+ * _Protected_Software_Implementations.pdf
+ * 
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ * 
+ * @date        October 2026
+ */
+#include "romulus_t.h"
+#include "randombytes.h"
+#include "crypto_aead_shared.h"
+#include "romulus_usdt.h"
+
+#define VARIANT "romulus-t"
+
+// keys whose shares are expanded together by romulus_expand_keys (8 shares at
+// most, at least one key)
+#define EXPAND_KEYS ((NUM_SHARES_KEY < 8) ? 8 / NUM_SHARES_KEY : 1)
+
+static romulus_call_hook call_hook = NULL;
+static void *call_hook_arg = NULL;
+
+void romulus_set_call_hook(romulus_call_hook hook, void *arg)
+{
+    __atomic_store_n(&call_hook_arg, arg, __ATOMIC_RELAXED);
+    __atomic_store_n(&call_hook, hook, __ATOMIC_RELEASE);
+}
+
+/**
+ * Invokes the hook registered with 'romulus_set_call_hook', if any.
+ */
+static inline void run_call_hook(int op, const void *key,
+    unsigned long long adlen, unsigned long long len)
+{
+    romulus_call_hook hook = __atomic_load_n(&call_hook, __ATOMIC_ACQUIRE);
+    if (__builtin_expect(hook != NULL, 0))
+        hook(__atomic_load_n(&call_hook_arg, __ATOMIC_RELAXED), op, key, adlen,
+            len);
+}
+
+/**
+ * Wrapper for compliance with the API defined in the call for protected
+ * implementations from GMU.
+ * 
+ * Converts an array with 4 mask_*_uint32_t element into NUM_SHARES_KEY 16-byte
+ * byte arrays.
+ * The j-th output array contains the j-th shares in a byte-wise representation.
+ * 
+ * Useful to pass the 16-byte block to mask the internal state and the 16-byte
+ * key share as inputs to the Romulus functions.
+ */
+static void shares_to_bytearr_n(
+    uint8_t bytearr[NUM_SHARES_KEY][BLOCKBYTES],
+    const mask_key_uint32_t *ks)
+{
+    int i, j;
+    // pack the j-th shares into bytearr[j]
+    // use a distinct loop per share to avoid potential HD-based leakages
+    for(j = 0; j < NUM_SHARES_KEY; j++) {
+        for(i = 0; i < BLOCKBYTES/4; i++) {
+            bytearr[j][i*4 + 0] = (uint8_t)((ks[i].shares[j] >> 0)  & 0xff);
+            bytearr[j][i*4 + 1] = (uint8_t)((ks[i].shares[j] >> 8)  & 0xff);
+            bytearr[j][i*4 + 2] = (uint8_t)((ks[i].shares[j] >> 16) & 0xff);
+            bytearr[j][i*4 + 3] = (uint8_t)((ks[i].shares[j] >> 24) & 0xff);
+        }
+    }
+}
+
+/**
+ * Splits a 16-byte value into NUM_SHARES_KEY shares.
+ */
+static void bytearr_to_shares_n(
+    mask_key_uint32_t *ks,
+    const unsigned char *k)
+{
+    int i, j;
+    for(j = 1; j < NUM_SHARES_KEY; j++)
+        for(i = 0; i < BLOCKBYTES/4; i++)
+            randombytes((uint8_t *)(&(ks[i].shares[j])), 4);
+    for(i = 0; i < BLOCKBYTES/4; i++) {
+        ks[i].shares[0] = ((uint32_t *)k)[i];
+        for(j = 1; j < NUM_SHARES_KEY; j++)
+            ks[i].shares[0] ^= ks[i].shares[j];
+    }
+}
+
+/**
+ * Same as 'shares_to_bytearr_n' but with no masking => only one output buffer.
+ */
+static void shares_to_bytearr(
+    uint8_t bytearr[],
+    const mask_m_uint32_t *ms, unsigned long long mlen)
+{
+    unsigned long long i, r;
+    r = mlen % 4;
+    for(i = 0; i < mlen/4; i++) {
+        bytearr[i*4 + 0] = (uint8_t)((ms[i].shares[0] >> 0)  & 0xff);
+        bytearr[i*4 + 1] = (uint8_t)((ms[i].shares[0] >> 8)  & 0xff);
+        bytearr[i*4 + 2] = (uint8_t)((ms[i].shares[0] >> 16) & 0xff);
+        bytearr[i*4 + 3] = (uint8_t)((ms[i].shares[0] >> 24) & 0xff);
+    }
+    for(i = 0; i < r; i++)
+        bytearr[mlen - r + i] = (uint8_t)((ms[mlen/4].shares[0] >> 8*i)  & 0xff);
+}
+
+/**
+ * Split the encryption key into shares and pack the other inputs according
+ * to the call for protected software implementations from GMU.
+ */
+void generate_shares_encrypt(
+    const unsigned char *m, mask_m_uint32_t *ms, const unsigned long long mlen,
+    const unsigned char *ad, mask_ad_uint32_t *ads , const unsigned long long adlen,
+    const unsigned char *npub, mask_npub_uint32_t *npubs,
+    const unsigned char *k, mask_key_uint32_t *ks)
+{
+    unsigned long long i, r;
+
+    // msg is not split into shares, simple copy
+    r = mlen % 4;
+    for(i = 0; i < mlen/4; i++) {
+        ms[i].shares[0]  = (uint32_t)(m[i*4 + 0] << 0);
+        ms[i].shares[0] |= (uint32_t)(m[i*4 + 1] << 8);
+        ms[i].shares[0] |= (uint32_t)(m[i*4 + 2] << 16);
+        ms[i].shares[0] |= (uint32_t)(m[i*4 + 3] << 24);
+    }
+    // pad with 0s for the last incomplete word
+    if (r) {
+        ms[mlen/4 + 1].shares[0]  = 0x00000000;
+        for(i = 0; i < r; i++)
+            ms[mlen/4].shares[0] |= (uint32_t)(m[mlen - r + i] << 8*i);
+    }
+
+    // ad is not split into shares, simple copy
+    r = adlen % 4;
+    for(i = 0; i < adlen/4; i++) {
+        ads[i].shares[0]  = (uint32_t)(ad[i*4 + 0] << 0);
+        ads[i].shares[0] |= (uint32_t)(ad[i*4 + 1] << 8);
+        ads[i].shares[0] |= (uint32_t)(ad[i*4 + 2] << 16);
+        ads[i].shares[0] |= (uint32_t)(ad[i*4 + 3] << 24);
+    }
+    // pad with 0s for the last incomplete word
+    if (r) {
+        ads[adlen/4 + 1].shares[0]  = 0x00000000;
+        for(i = 0; i < r; i++)
+            ads[adlen/4].shares[0] |= (uint32_t)(ad[adlen - r + i] << 8*i);
+    }
+
+    // public nonce is split into NUM_SHARES_NPUB shares
+    bytearr_to_shares_n((mask_key_uint32_t *)npubs, npub);
+
+    // encryption key is split into NUM_SHARES_KEY shares
+    bytearr_to_shares_n(ks, k);
+}
+
+/**
+ * Split the encryption key into shares and pack the other inputs according
+ * to the call for protected software implementations from GMU.
+ */
+void generate_shares_decrypt(
+    const unsigned char *c, mask_m_uint32_t *cs, const unsigned long long clen,
+    const unsigned char *ad, mask_ad_uint32_t *ads , const unsigned long long adlen,
+    const unsigned char *npub, mask_npub_uint32_t *npubs,
+    const unsigned char *k, mask_key_uint32_t *ks)
+{
+    unsigned long long i, r;
+
+    // msg is not split into shares, simple copy
+    r = clen % 4;
+    for(i = 0; i < clen/4; i++) {
+        cs[i].shares[0]  = (uint32_t)(c[i*4 + 0] << 0);
+        cs[i].shares[0] |= (uint32_t)(c[i*4 + 1] << 8);
+        cs[i].shares[0] |= (uint32_t)(c[i*4 + 2] << 16);
+        cs[i].shares[0] |= (uint32_t)(c[i*4 + 3] << 24);
+    }
+    // pad with 0s for the last incomplete word
+    if (r) {
+        cs[clen/4 + 1].shares[0]  = 0x00000000;
+        for(i = 0; i < r; i++)
+            cs[clen/4].shares[0] |= (uint32_t)(c[clen - r + i] << 8*i);
+    }
+
+    // ad is not split into shares, simple copy
+    r = adlen % 4;
+    for(i = 0; i < adlen/4; i++) {
+        ads[i].shares[0]  = (uint32_t)(ad[i*4 + 0] << 0);
+        ads[i].shares[0] |= (uint32_t)(ad[i*4 + 1] << 8);
+        ads[i].shares[0] |= (uint32_t)(ad[i*4 + 2] << 16);
+        ads[i].shares[0] |= (uint32_t)(ad[i*4 + 3] << 24);
+    }
+    // pad with 0s for the last incomplete word
+    if (r) {
+        ads[adlen/4 + 1].shares[0]  = 0x00000000;
+        for(i = 0; i < r; i++)
+            ads[adlen/4].shares[0] |= (uint32_t)(ad[adlen - r + i] << 8*i);
+    }
+
+    // public nonce is split into NUM_SHARES_NPUB shares
+    bytearr_to_shares_n((mask_key_uint32_t *)npubs, npub);
+
+    // encryption key is split into NUM_SHARES_KEY shares
+    bytearr_to_shares_n(ks, k);
+}
+
+/**
+ * Combine the shares into the output ciphertext buffer.
+ */
+void combine_shares_encrypt(
+    const mask_c_uint32_t *cs, unsigned char *c, unsigned long long clen) {
+    shares_to_bytearr(c, (mask_m_uint32_t *)cs, clen);
+}
+
+/**
+ * Combine the shares into the output plaintext buffer.
+ */
+void combine_shares_decrypt(
+    const mask_m_uint32_t *ms, unsigned char *m, unsigned long long mlen) {
+    shares_to_bytearr(m, ms, mlen);
+}
+
+/**
+ * Expands the key-only round tweakeys of 'n' keys into 'ctx' (one context per
+ * key), where 'ks' contains 4 consecutive mask_key_uint32_t elements per key.
+ *
+ * The TK3 schedules of all shares are computed 8 at a time, across keys (e.g.
+ * both shares of 4 keys at 1st order), through 'tks_3_x8'. Contexts do not
+ * share any state so that disjoint ranges can be expanded concurrently by
+ * different threads (see 'romulus_pool_expand_keys').
+ */
+void romulus_expand_keys(
+    romulust_key_ctx *ctx,
+    const mask_key_uint32_t *ks,
+    size_t n)
+{
+    size_t i;
+    int j, s, m, l;
+    uint8_t k[EXPAND_KEYS][NUM_SHARES_KEY][TWEAKEYBYTES];   // key shares
+    uint8_t *rtk[8];
+    const uint8_t *tk[8];
+    uint32_t rc;
+    for(i = 0; i < n; i += m) {
+        m = (n - i < EXPAND_KEYS) ? (int)(n - i) : EXPAND_KEYS;
+        l = 0;
+        rc = 0;
+        for(j = 0; j < m; j++) {
+            shares_to_bytearr_n(k[j], ks + 4*(i + j));
+            for(s = 0; s < NUM_SHARES_KEY; s++) {
+                if (s == 0)     // only the 1st share includes the constants
+                    rc |= 1U << l;
+                rtk[l] = ctx[i + j].rtk_3[s];
+                tk[l++] = k[j][s];
+                if (l == 8) {
+                    tks_3_x8(rtk, tk, rc, l);
+                    l = 0;
+                    rc = 0;
+                }
+            }
+        }
+        if (l > 0)
+            tks_3_x8(rtk, tk, rc, l);
+    }
+    zeroize((uint8_t *)k, sizeof(k));
+}
+
+/**
+ * Encryption and authentication using Romulus-T w/ d-th order masking from a
+ * key context, without probes.
+ */
+static int encrypt_ctx(
+    mask_c_uint32_t* cs, unsigned long long *clen,
+    const mask_m_uint32_t *ms, unsigned long long mlen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const romulust_key_ctx *ctx)
+{
+    uint8_t state[BLOCKBYTES];      // internal state
+    uint8_t tk1[BLOCKBYTES];
+    uint8_t npub[NUM_SHARES_NPUB][TWEAKEYBYTES];    // public nonce shares
+
+    // put the 128-bit npub shares into npub
+    shares_to_bytearr_n(npub, (mask_key_uint32_t *)npubs);
+    *clen = mlen + TAGBYTES;
+    zeroize(tk1, BLOCKBYTES);
+    romulust_kdf(state, tk1, npub, ctx);
+    romulust_process_msg(state, tk1, npub[0], (uint8_t *)cs, (uint8_t *)ms, mlen);
+    romulust_generate_tag(
+        (uint8_t *)cs + mlen,
+        tk1,
+        (uint8_t *)ads, adlen,
+        (uint8_t *)cs, mlen,
+        npub,
+        ctx);
+    return 0;
+}
+
+/**
+ * Decryption and tag verification using Romulus-T w/ d-th order masking from a
+ * key context, without probes.
+ */
+static int decrypt_ctx(
+    mask_m_uint32_t* ms, unsigned long long *mlen,
+    const mask_c_uint32_t *cs, unsigned long long clen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const romulust_key_ctx *ctx)
+{
+    uint8_t state[BLOCKBYTES];      // internal state
+    uint8_t tk1[BLOCKBYTES];
+    uint8_t npub[NUM_SHARES_NPUB][TWEAKEYBYTES];    // public nonce shares
+    uint8_t tmp = 0x00;
+
+    if (clen < TAGBYTES)
+        return -1;
+
+    // put the 128-bit npub shares into npub
+    shares_to_bytearr_n(npub, (mask_key_uint32_t *)npubs);
+    *mlen = clen - TAGBYTES;
+    // unmask npub for tag generation
+    for(int i = 0; i < BLOCKBYTES; i++)
+        for(int j = 1; j < NUM_SHARES_NPUB; j++)
+            npub[0][i] ^= npub[j][i];
+    zeroize(tk1, BLOCKBYTES);
+    romulust_generate_tag(
+        state,
+        tk1,
+        (uint8_t *)ads, adlen,
+        (uint8_t *)cs, *mlen,
+        npub,
+        ctx);
+    // tag verification
+    for(int i = 0; i < TAGBYTES; i++)
+        tmp |= state[i] ^ ((uint8_t *)cs)[clen-TAGBYTES+i];   //constant-time tag comparison
+    if (tmp)
+      return -1;
+    zeroize(tk1, BLOCKBYTES);
+    romulust_kdf(state, tk1, npub, ctx);
+    romulust_process_msg(state, tk1, npub[0], (uint8_t *)ms, (uint8_t *)cs, *mlen);
+    return 0;
+}
+
+/**
+ * Encryption and authentication using Romulus-T w/ d-th order masking from a
+ * key context precomputed by 'romulus_expand_keys'.
+ */
+int crypto_aead_encrypt_shared_ctx(
+    mask_c_uint32_t* cs, unsigned long long *clen,
+    const mask_m_uint32_t *ms, unsigned long long mlen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const romulust_key_ctx *ctx)
+{
+    int ret;
+    ROMULUS_PROBE3(aead_encrypt_entry, VARIANT, adlen, mlen);
+    run_call_hook(ROMULUS_HOOK_ENCRYPT, ctx, adlen, mlen);
+    ret = encrypt_ctx(cs, clen, ms, mlen, ads, adlen, npubs, ctx);
+    ROMULUS_PROBE4(aead_encrypt_return, VARIANT, adlen, mlen, ret);
+    return ret;
+}
+
+/**
+ * Decryption and tag verification using Romulus-T w/ d-th order masking from a
+ * key context precomputed by 'romulus_expand_keys'.
+ * 
+ * If tag verification fails, return a non-zero value.
+ */
+int crypto_aead_decrypt_shared_ctx(
+    mask_m_uint32_t* ms, unsigned long long *mlen,
+    const mask_c_uint32_t *cs, unsigned long long clen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const romulust_key_ctx *ctx)
+{
+    int ret;
+    ROMULUS_PROBE3(aead_decrypt_entry, VARIANT, adlen, clen);
+    run_call_hook(ROMULUS_HOOK_DECRYPT, ctx, adlen, clen);
+    ret = decrypt_ctx(ms, mlen, cs, clen, ads, adlen, npubs, ctx);
+    ROMULUS_PROBE4(aead_decrypt_return, VARIANT, adlen, clen, ret);
+    return ret;
+}
+
+/**
+ * Encryption and authentication of 'n' independent messages using Romulus-T
+ * w/ d-th order masking, the i-th message being processed as by
+ * 'crypto_aead_encrypt_shared_ctx' with the i-th element of each array.
+ * 
+ * Messages are processed by groups of ROMULUST_BATCH so that the masked
+ * Skinny-128-384+ calls (KDF and tag generation) of a group run in parallel.
+ */
+int crypto_aead_encrypt_shared_batch(
+    mask_c_uint32_t *const cs[], unsigned long long clen[],
+    const mask_m_uint32_t *const ms[], const unsigned long long mlen[],
+    const mask_ad_uint32_t *const ads[], const unsigned long long adlen[],
+    const mask_npub_uint32_t *const npubs[],
+    const romulust_key_ctx *const ctx[],
+    size_t n)
+{
+    size_t i;
+    int b, nb;
+    uint8_t state[ROMULUST_BATCH][BLOCKBYTES];      // internal states
+    uint8_t tk1[ROMULUST_BATCH][BLOCKBYTES];
+    uint8_t tag[ROMULUST_BATCH][BLOCKBYTES];
+    uint8_t npub[ROMULUST_BATCH][NUM_SHARES_NPUB][TWEAKEYBYTES];
+    const uint8_t *ad[ROMULUST_BATCH], *c[ROMULUST_BATCH], *m[ROMULUST_BATCH];
+    const uint8_t *pnpub[ROMULUST_BATCH];
+
+    ROMULUS_PROBE2(aead_encrypt_batch_entry, VARIANT, n);
+    for(i = 0; i < n; i++)
+        run_call_hook(ROMULUS_HOOK_ENCRYPT, ctx[i], adlen[i], mlen[i]);
+    for(i = 0; i < n; i += nb) {
+        nb = (n - i < ROMULUST_BATCH) ? (int)(n - i) : ROMULUST_BATCH;
+        for(b = 0; b < nb; b++) {
+            shares_to_bytearr_n(npub[b], (mask_key_uint32_t *)npubs[i+b]);
+            clen[i+b] = mlen[i+b] + TAGBYTES;
+            zeroize(tk1[b], BLOCKBYTES);
+            ad[b] = (const uint8_t *)ads[i+b];
+            c[b] = (const uint8_t *)cs[i+b];
+        }
+        romulust_kdf_x8(state, tk1, npub, ctx + i, nb);
+        for(b = 0; b < nb; b++) {
+            pnpub[b] = npub[b][0];
+            m[b] = (const uint8_t *)ms[i+b];
+        }
+        romulust_process_msg_x8(state, tk1, pnpub, (uint8_t *const *)c, m,
+            mlen + i, nb);
+        romulust_generate_tag_x8(tag, tk1, ad, adlen + i, c, mlen + i, npub,
+            ctx + i, nb);
+        for(b = 0; b < nb; b++)
+            for(int j = 0; j < TAGBYTES; j++)
+                ((uint8_t *)cs[i+b])[mlen[i+b] + j] = tag[b][j];
+    }
+    ROMULUS_PROBE3(aead_encrypt_batch_return, VARIANT, n, 0);
+    return 0;
+}
+
+/**
+ * Decryption and tag verification of 'n' independent messages using
+ * Romulus-T w/ d-th order masking (see 'crypto_aead_encrypt_shared_batch').
+ * 
+ * 'res[i]' is set to a non-zero value if tag verification fails for the i-th
+ * message, in which case no plaintext is released for it. Returns a non-zero
+ * value if tag verification fails for at least one message.
+ */
+int crypto_aead_decrypt_shared_batch(
+    mask_m_uint32_t *const ms[], unsigned long long mlen[],
+    const mask_c_uint32_t *const cs[], const unsigned long long clen[],
+    const mask_ad_uint32_t *const ads[], const unsigned long long adlen[],
+    const mask_npub_uint32_t *const npubs[],
+    const romulust_key_ctx *const ctx[],
+    int res[],
+    size_t n)
+{
+    size_t i;
+    int b, k, nb, ret = 0;
+    uint8_t state[ROMULUST_BATCH][BLOCKBYTES];      // internal states
+    uint8_t tk1[ROMULUST_BATCH][BLOCKBYTES];
+    uint8_t npub[ROMULUST_BATCH][NUM_SHARES_NPUB][TWEAKEYBYTES];
+    const uint8_t *ad[ROMULUST_BATCH], *c[ROMULUST_BATCH];
+    const uint8_t *pnpub[ROMULUST_BATCH];
+    const uint8_t *tag;
+    uint8_t *m[ROMULUST_BATCH];
+    unsigned long long len[ROMULUST_BATCH];
+    uint8_t tmp;
+
+    ROMULUS_PROBE2(aead_decrypt_batch_entry, VARIANT, n);
+    for(i = 0; i < n; i++)
+        run_call_hook(ROMULUS_HOOK_DECRYPT, ctx[i], adlen[i], clen[i]);
+    for(i = 0; i < n; i += nb) {
+        nb = (n - i < ROMULUST_BATCH) ? (int)(n - i) : ROMULUST_BATCH;
+        for(b = 0; b < nb; b++) {
+            // messages shorter than the tag are processed as empty ones but
+            // always rejected
+            mlen[i+b] = (clen[i+b] < TAGBYTES) ? 0 : clen[i+b] - TAGBYTES;
+            shares_to_bytearr_n(npub[b], (mask_key_uint32_t *)npubs[i+b]);
+            // unmask npub for tag generation
+            for(k = 0; k < BLOCKBYTES; k++)
+                for(int j = 1; j < NUM_SHARES_NPUB; j++)
+                    npub[b][0][k] ^= npub[b][j][k];
+            zeroize(tk1[b], BLOCKBYTES);
+            ad[b] = (const uint8_t *)ads[i+b];
+            c[b] = (const uint8_t *)cs[i+b];
+        }
+        romulust_generate_tag_x8(state, tk1, ad, adlen + i, c, mlen + i, npub,
+            ctx + i, nb);
+        // tag verification
+        for(b = 0; b < nb; b++) {
+            // constant-time tag comparison: all bytes are always compared,
+            // against the computed tag itself if the input is too short
+            tag = (clen[i+b] < TAGBYTES) ? state[b] : c[b] + mlen[i+b];
+            tmp = (clen[i+b] < TAGBYTES);
+            for(int j = 0; j < TAGBYTES; j++)
+                tmp |= state[b][j] ^ tag[j];
+            res[i+b] = tmp ? -1 : 0;
+            ret |= res[i+b];
+            zeroize(tk1[b], BLOCKBYTES);
+        }
+        romulust_kdf_x8(state, tk1, npub, ctx + i, nb);
+        // only decrypt the verified messages, packed at the front
+        for(b = 0, k = 0; b < nb; b++) {
+            if (res[i+b])
+                continue;
+            for(int j = 0; j < BLOCKBYTES; j++) {
+                state[k][j] = state[b][j];
+                tk1[k][j] = tk1[b][j];
+            }
+            pnpub[k] = npub[b][0];
+            m[k] = (uint8_t *)ms[i+b];
+            c[k] = (const uint8_t *)cs[i+b];
+            len[k++] = mlen[i+b];
+        }
+        romulust_process_msg_x8(state, tk1, pnpub, m, c, len, k);
+    }
+    ROMULUS_PROBE3(aead_decrypt_batch_return, VARIANT, n, ret);
+    return ret;
+}
+
+/**
+ * Encryption and authentication using Romulus-T w/ d-th order masking.
+ */
+int crypto_aead_encrypt_shared(
+    mask_c_uint32_t* cs, unsigned long long *clen,
+    const mask_m_uint32_t *ms, unsigned long long mlen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const mask_key_uint32_t *ks)
+{
+    romulust_key_ctx ctx;
+    int ret;
+    ROMULUS_PROBE3(aead_encrypt_entry, VARIANT, adlen, mlen);
+    run_call_hook(ROMULUS_HOOK_ENCRYPT, NULL, adlen, mlen);
+    romulus_expand_keys(&ctx, ks, 1);
+    ret = encrypt_ctx(cs, clen, ms, mlen, ads, adlen, npubs, &ctx);
+    ROMULUS_PROBE4(aead_encrypt_return, VARIANT, adlen, mlen, ret);
+    return ret;
+}
+
+/**
+ * Decryption and tag verification using Romulus-T w/ d-th order masking.
+ * 
+ * If tag verification fails, return a non-zero value.
+ */
+int crypto_aead_decrypt_shared(
+    mask_m_uint32_t* ms, unsigned long long *mlen,
+    const mask_c_uint32_t *cs, unsigned long long clen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const mask_key_uint32_t *ks)
+{
+    romulust_key_ctx ctx;
+    int ret;
+    ROMULUS_PROBE3(aead_decrypt_entry, VARIANT, adlen, clen);
+    run_call_hook(ROMULUS_HOOK_DECRYPT, NULL, adlen, clen);
+    romulus_expand_keys(&ctx, ks, 1);
+    ret = decrypt_ctx(ms, mlen, cs, clen, ads, adlen, npubs, &ctx);
+    ROMULUS_PROBE4(aead_decrypt_return, VARIANT, adlen, clen, ret);
+    return ret;
+}
@@ -0,0 +1,16 @@
+#define CRYPTO_KEYBYTES     16
+#define CRYPTO_NSECBYTES    0
+#define CRYPTO_NPUBBYTES    16
+#define CRYPTO_ABYTES       16
+// in-place processing (c == m) is supported, partial overlaps are not
+#define CRYPTO_NOOVERLAP    1
+#define CRYPTO_BYTES        32
+
+#define NUM_SHARES_M 		1
+#define NUM_SHARES_C 		1
+#define NUM_SHARES_AD 		1
+#ifndef MASKING_ORDER
+#define MASKING_ORDER       1 // 1st-order masking by default
+#endif
+#define NUM_SHARES_NPUB 	(MASKING_ORDER + 1) // d-th order masking => d+1 shares
+#define NUM_SHARES_KEY 		(MASKING_ORDER + 1) // d-th order masking => d+1 shares
\ No newline at end of file
@@ -0,0 +1,287 @@
+/**
+ * Asynchronous front end (Linux only, see 'romulus_async.h').
+ *
+ * Offloaded Romulus-T jobs are submitted to the worker pool as regular batch
+ * jobs, so that concurrent ones are processed together by the batch API.
+ * Romulus-N/M jobs are submitted as POOL_CALL jobs, the backend being called
+ * from the completion callback. Completed jobs are appended to a list and the
+ * eventfd is signaled, the job memory being released once its result is
+ * polled.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "randombytes.h"
+#include "pool/romulus_pool.h"
+#include "romulus_async.h"
+
+typedef struct async_job {
+    romulus_pool_job pj;
+    mask_npub_uint32_t npub[4];
+    romulus_async_req req;
+    romulus_async_result res;
+    romulus_async *q;
+    struct async_job *next;
+} async_job;
+
+struct romulus_async {
+    romulus_pool *pool;
+    int efd;
+    size_t inline_max;
+    romulus_async_encrypt_fn encrypt[2];    // Romulus-N/M backends
+    romulus_async_decrypt_fn decrypt[2];
+    pthread_mutex_t lock;
+    async_job *head;                        // completed, not polled yet
+    async_job *tail;
+    uint64_t inline_jobs;
+    uint64_t inline_bytes;
+    uint64_t offloaded_jobs;
+    uint64_t offloaded_bytes;
+    uint64_t pending;
+};
+
+/**
+ * Splits the public nonce into NUM_SHARES_NPUB shares as required by the
+ * masked API.
+ */
+static void split_npub(mask_npub_uint32_t npubs[4], const uint8_t npub[16])
+{
+    int i, j;
+    randombytes((unsigned char *)npubs, 4*sizeof(mask_npub_uint32_t));
+    for(i = 0; i < 4; i++) {
+        npubs[i].shares[0] = (uint32_t)npub[4*i] | (uint32_t)npub[4*i+1] << 8 |
+            (uint32_t)npub[4*i+2] << 16 | (uint32_t)npub[4*i+3] << 24;
+        for(j = 1; j < NUM_SHARES_NPUB; j++)
+            npubs[i].shares[0] ^= npubs[i].shares[j];
+    }
+}
+
+/**
+ * Processes a job in the calling thread.
+ */
+static void run_job(romulus_async *q, const romulus_async_req *req,
+    const mask_npub_uint32_t npubs[4], romulus_async_result *res)
+{
+    int ret;
+    res->cookie = req->cookie;
+    res->outlen = 0;
+    if (req->alg == ASYNC_ROMULUS_T) {
+        if (req->op == ASYNC_ENCRYPT)
+            ret = crypto_aead_encrypt_shared_ctx(
+                (mask_c_uint32_t *)req->out, &res->outlen,
+                (const mask_m_uint32_t *)req->in, req->inlen,
+                (const mask_ad_uint32_t *)req->ad, req->adlen,
+                npubs, (const romulust_key_ctx *)req->key);
+        else
+            ret = crypto_aead_decrypt_shared_ctx(
+                (mask_m_uint32_t *)req->out, &res->outlen,
+                (const mask_c_uint32_t *)req->in, req->inlen,
+                (const mask_ad_uint32_t *)req->ad, req->adlen,
+                npubs, (const romulust_key_ctx *)req->key);
+    } else if (req->op == ASYNC_ENCRYPT) {
+        ret = q->encrypt[req->alg](req->out, &res->outlen, req->in, req->inlen,
+            req->ad, req->adlen, NULL, req->npub, req->key);
+    } else {
+        ret = q->decrypt[req->alg](req->out, &res->outlen, NULL, req->in,
+            req->inlen, req->ad, req->adlen, req->npub, req->key);
+    }
+    if (ret) {
+        res->status = ASYNC_EVERIFY;
+        res->outlen = 0;
+    } else {
+        res->status = ASYNC_OK;
+    }
+}
+
+/**
+ * Completion callback of offloaded jobs, called from a worker thread.
+ */
+static void on_done(romulus_pool_job *pj, void *arg)
+{
+    async_job *j = arg;
+    romulus_async *q = j->q;
+    uint64_t one = 1;
+    (void)pj;
+    if (j->pj.op == POOL_CALL) {
+        run_job(q, &j->req, j->npub, &j->res);
+    } else {
+        j->res.cookie = j->req.cookie;
+        j->res.status = j->pj.res ? ASYNC_EVERIFY : ASYNC_OK;
+        j->res.outlen = j->pj.res ? 0 : j->pj.outlen;
+    }
+    j->next = NULL;
+    pthread_mutex_lock(&q->lock);
+    if (q->head == NULL)
+        q->head = j;
+    else
+        q->tail->next = j;
+    q->tail = j;
+    pthread_mutex_unlock(&q->lock);
+    if (write(q->efd, &one, sizeof(one)) < 0)
+        return;
+}
+
+romulus_async *romulus_async_create(const romulus_async_cfg *cfg)
+{
+    romulus_pool_cfg pcfg = {0};
+    romulus_async *q = calloc(1, sizeof(romulus_async));
+    if (q == NULL)
+        return NULL;
+    q->inline_max = cfg->inline_max ? cfg->inline_max :
+        ASYNC_DEFAULT_INLINE_MAX;
+    pcfg.workers_per_node = cfg->workers_per_node;
+    pcfg.emulate_nodes = cfg->emulate_nodes;
+    q->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    q->pool = romulus_pool_create(&pcfg);
+    if (q->efd < 0 || q->pool == NULL) {
+        if (q->efd >= 0)
+            close(q->efd);
+        romulus_pool_destroy(q->pool);
+        free(q);
+        return NULL;
+    }
+    pthread_mutex_init(&q->lock, NULL);
+    return q;
+}
+
+void romulus_async_destroy(romulus_async *q)
+{
+    async_job *j;
+    if (q == NULL)
+        return;
+    romulus_pool_destroy(q->pool);
+    while ((j = q->head) != NULL) {
+        q->head = j->next;
+        free(j);
+    }
+    pthread_mutex_destroy(&q->lock);
+    close(q->efd);
+    free(q);
+}
+
+int romulus_async_set_backend(romulus_async *q, uint32_t alg,
+    romulus_async_encrypt_fn encrypt, romulus_async_decrypt_fn decrypt)
+{
+    if (alg > ASYNC_ROMULUS_M)
+        return -1;
+    q->encrypt[alg] = encrypt;
+    q->decrypt[alg] = decrypt;
+    return 0;
+}
+
+void romulus_async_set_inline_max(romulus_async *q, size_t inline_max)
+{
+    __atomic_store_n(&q->inline_max, inline_max, __ATOMIC_RELAXED);
+}
+
+int romulus_async_submit(romulus_async *q, const romulus_async_req *req,
+    romulus_async_result *res)
+{
+    async_job *j;
+    romulus_pool_job *pj;
+    mask_npub_uint32_t npubs[4];
+
+    res->cookie = req->cookie;
+    res->outlen = 0;
+    if (req->op > ASYNC_DECRYPT || req->alg > ASYNC_ROMULUS_T ||
+        (req->op == ASYNC_DECRYPT && req->inlen < ASYNC_TAGBYTES)) {
+        res->status = ASYNC_EINVAL;
+        return ASYNC_INLINE;
+    }
+    if (req->alg != ASYNC_ROMULUS_T && (q->encrypt[req->alg] == NULL ||
+        q->decrypt[req->alg] == NULL)) {
+        res->status = ASYNC_ENOTSUP;
+        return ASYNC_INLINE;
+    }
+
+    if (req->inlen <= __atomic_load_n(&q->inline_max, __ATOMIC_RELAXED) ||
+        (j = malloc(sizeof(async_job))) == NULL) {
+        if (req->alg == ASYNC_ROMULUS_T)
+            split_npub(npubs, req->npub);
+        run_job(q, req, npubs, res);
+        __atomic_add_fetch(&q->inline_jobs, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&q->inline_bytes, req->inlen, __ATOMIC_RELAXED);
+        return ASYNC_INLINE;
+    }
+
+    j->q = q;
+    j->req = *req;
+    j->pj.ctx = NULL;
+    if (req->alg == ASYNC_ROMULUS_T) {
+        split_npub(j->npub, req->npub);
+        j->pj.op = (req->op == ASYNC_ENCRYPT) ? POOL_ENCRYPT : POOL_DECRYPT;
+        j->pj.ctx = (const romulust_key_ctx *)req->key;
+    } else {
+        j->pj.op = POOL_CALL;
+    }
+    j->pj.node = POOL_ANY_NODE;
+    j->pj.out = (mask_c_uint32_t *)req->out;
+    j->pj.in = (const mask_m_uint32_t *)req->in;
+    j->pj.inlen = req->inlen;
+    j->pj.ad = (const mask_ad_uint32_t *)req->ad;
+    j->pj.adlen = req->adlen;
+    j->pj.npub = j->npub;
+    j->pj.done = on_done;
+    j->pj.arg = j;
+    __atomic_add_fetch(&q->offloaded_jobs, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&q->offloaded_bytes, req->inlen, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&q->pending, 1, __ATOMIC_RELAXED);
+    pj = &j->pj;
+    romulus_pool_submit(q->pool, &pj, 1);
+    return ASYNC_QUEUED;
+}
+
+int romulus_async_fd(const romulus_async *q)
+{
+    return q->efd;
+}
+
+/**
+ * The eventfd is reset before the list is drained, and signaled again if
+ * results are left, so that no completion goes unnoticed.
+ */
+int romulus_async_poll(romulus_async *q, romulus_async_result *res, int n)
+{
+    int i = 0;
+    uint64_t cnt, one = 1;
+    async_job *j, *done = NULL;
+
+    if (read(q->efd, &cnt, sizeof(cnt)) < 0)
+        cnt = 0;
+    pthread_mutex_lock(&q->lock);
+    while (i < n && (j = q->head) != NULL) {
+        q->head = j->next;
+        j->next = done;
+        done = j;
+        res[i++] = j->res;
+    }
+    if (q->head == NULL)
+        q->tail = NULL;
+    else if (write(q->efd, &one, sizeof(one)) < 0)
+        cnt = 0;
+    pthread_mutex_unlock(&q->lock);
+    while ((j = done) != NULL) {
+        done = j->next;
+        free(j);
+    }
+    __atomic_sub_fetch(&q->pending, i, __ATOMIC_RELAXED);
+    return i;
+}
+
+void romulus_async_get_stats(const romulus_async *q, romulus_async_stats *st)
+{
+    st->inline_max = __atomic_load_n(&q->inline_max, __ATOMIC_RELAXED);
+    st->inline_jobs = __atomic_load_n(&q->inline_jobs, __ATOMIC_RELAXED);
+    st->inline_bytes = __atomic_load_n(&q->inline_bytes, __ATOMIC_RELAXED);
+    st->offloaded_jobs = __atomic_load_n(&q->offloaded_jobs, __ATOMIC_RELAXED);
+    st->offloaded_bytes = __atomic_load_n(&q->offloaded_bytes,
+        __ATOMIC_RELAXED);
+    st->pending = __atomic_load_n(&q->pending, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,134 @@
+#ifndef ROMULUS_ASYNC_H_
+#define ROMULUS_ASYNC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Asynchronous front end for event loops (Linux only).
+//
+//Jobs whose input is at most 'inline_max' bytes long are processed within
+//'romulus_async_submit', larger ones are handed to a worker pool (see
+//'pool/romulus_pool.h') and their completions are queued. An eventfd becomes
+//readable whenever completions are pending, so that it can be watched by the
+//reactor alongside its sockets and drained with 'romulus_async_poll'.
+//
+//Romulus-T is built in and processed through the masked key-context API,
+//offloaded jobs going through the batch API. Romulus-N/M are served once
+//backends with the NIST LWC API are registered (e.g. the reference
+//implementations built with -Dcrypto_aead_encrypt=romulusn_encrypt, etc.).
+#define ASYNC_ENCRYPT       0
+#define ASYNC_DECRYPT       1
+
+#define ASYNC_ROMULUS_N     0
+#define ASYNC_ROMULUS_M     1
+#define ASYNC_ROMULUS_T     2
+
+#define ASYNC_KEYBYTES      16
+#define ASYNC_NPUBBYTES     16
+#define ASYNC_TAGBYTES      16
+
+//Job status
+#define ASYNC_OK            0
+#define ASYNC_EVERIFY       (-1)            // tag verification failed
+#define ASYNC_EINVAL        (-2)            // malformed job
+#define ASYNC_ENOTSUP       (-4)            // no backend for the algorithm
+
+//Return values of 'romulus_async_submit'
+#define ASYNC_INLINE        0               // completed, result available
+#define ASYNC_QUEUED        1               // result delivered by polling
+
+typedef struct {
+    uint32_t op;
+    uint32_t alg;
+    const void *key;                        // romulust_key_ctx for Romulus-T
+                                            // (see 'romulus_expand_keys'),
+                                            // ASYNC_KEYBYTES bytes otherwise
+    const uint8_t *npub;                    // ASYNC_NPUBBYTES bytes
+    const uint8_t *ad;
+    unsigned long long adlen;
+    const uint8_t *in;
+    unsigned long long inlen;
+    uint8_t *out;                           // may be equal to 'in'
+    uint64_t cookie;                        // opaque, returned with the result
+} romulus_async_req;
+
+typedef struct {
+    uint64_t cookie;
+    int32_t status;
+    unsigned long long outlen;              // bytes written to 'out'
+} romulus_async_result;
+
+typedef struct {
+    size_t inline_max;                      // inline/offload size cutoff
+    uint64_t inline_jobs;
+    uint64_t inline_bytes;
+    uint64_t offloaded_jobs;
+    uint64_t offloaded_bytes;
+    uint64_t pending;                       // offloaded, not polled yet
+} romulus_async_stats;
+
+typedef struct {
+    size_t inline_max;                      // 0: ASYNC_DEFAULT_INLINE_MAX
+    int workers_per_node;                   // see 'romulus_pool_cfg'
+    int emulate_nodes;
+} romulus_async_cfg;
+
+#define ASYNC_DEFAULT_INLINE_MAX    4096
+
+//NIST LWC API
+typedef int (*romulus_async_encrypt_fn)(
+    unsigned char *c, unsigned long long *clen,
+    const unsigned char *m, unsigned long long mlen,
+    const unsigned char *ad, unsigned long long adlen,
+    const unsigned char *nsec,
+    const unsigned char *npub,
+    const unsigned char *k);
+
+typedef int (*romulus_async_decrypt_fn)(
+    unsigned char *m, unsigned long long *mlen,
+    unsigned char *nsec,
+    const unsigned char *c, unsigned long long clen,
+    const unsigned char *ad, unsigned long long adlen,
+    const unsigned char *npub,
+    const unsigned char *k);
+
+typedef struct romulus_async romulus_async;
+
+romulus_async *romulus_async_create(const romulus_async_cfg *cfg);
+
+//Waits for offloaded jobs to complete. Results which were not polled are lost.
+void romulus_async_destroy(romulus_async *q);
+
+//Registers the Romulus-N or Romulus-M implementation to be used, which must
+//be thread-safe. Must be called before submitting jobs for 'alg'.
+int romulus_async_set_backend(romulus_async *q, uint32_t alg,
+    romulus_async_encrypt_fn encrypt, romulus_async_decrypt_fn decrypt);
+
+void romulus_async_set_inline_max(romulus_async *q, size_t inline_max);
+
+//Returns ASYNC_INLINE if the job has been processed, in which case its result
+//is written to 'res', or ASYNC_QUEUED if it has been offloaded, in which case
+//'req' may be reused right away but its buffers must remain valid until its
+//result is polled. 'out' must hold inlen + ASYNC_TAGBYTES bytes (encryption)
+//or inlen - ASYNC_TAGBYTES bytes (decryption).
+int romulus_async_submit(romulus_async *q, const romulus_async_req *req,
+    romulus_async_result *res);
+
+//Eventfd readable while offloaded results are pending
+int romulus_async_fd(const romulus_async *q);
+
+//Retrieves up to 'n' results of offloaded jobs without blocking. Returns the
+//number of results.
+int romulus_async_poll(romulus_async *q, romulus_async_result *res, int n);
+
+void romulus_async_get_stats(const romulus_async *q, romulus_async_stats *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ROMULUS_ASYNC_H_
@@ -0,0 +1,115 @@
+#ifndef ROMULUS_ASYNC_HPP_
+#define ROMULUS_ASYNC_HPP_
+
+#include <coroutine>
+#include <cstdint>
+#include <span>
+#include "romulus_async.h"
+
+//C++20 awaiters on top of 'romulus_async.h'.
+//
+//  auto r = co_await romulus::seal(q, ASYNC_ROMULUS_T, &ctx, npub, ad, m, out);
+//
+//Jobs processed inline complete without suspending the coroutine. Otherwise,
+//the coroutine is resumed by 'romulus::drain', to be called by the reactor
+//thread whenever 'romulus_async_fd(q)' is readable, so that coroutines are
+//always resumed on the reactor thread.
+namespace romulus {
+
+struct result {
+    int status;                             // ASYNC_OK, ASYNC_EVERIFY, ...
+    unsigned long long outlen;
+    explicit operator bool() const noexcept { return status == ASYNC_OK; }
+};
+
+class op_awaiter {
+public:
+    op_awaiter(romulus_async *q, const romulus_async_req &req) noexcept
+        : q_(q), req_(req) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept
+    {
+        handle_ = h;
+        req_.cookie = reinterpret_cast<std::uintptr_t>(this);
+        // the result may be polled by the reactor only once this coroutine is
+        // suspended, since both run on the same thread
+        return romulus_async_submit(q_, &req_, &res_) == ASYNC_QUEUED;
+    }
+
+    result await_resume() const noexcept
+    {
+        return result{res_.status, res_.outlen};
+    }
+
+private:
+    friend std::size_t drain(romulus_async *q, std::size_t max);
+
+    romulus_async *q_;
+    romulus_async_req req_;
+    romulus_async_result res_{};
+    std::coroutine_handle<> handle_;
+};
+
+inline op_awaiter make_op(romulus_async *q, std::uint32_t op, std::uint32_t alg,
+    const void *key, std::span<const std::uint8_t, ASYNC_NPUBBYTES> npub,
+    std::span<const std::uint8_t> ad, std::span<const std::uint8_t> in,
+    std::uint8_t *out) noexcept
+{
+    romulus_async_req req{};
+    req.op = op;
+    req.alg = alg;
+    req.key = key;
+    req.npub = npub.data();
+    req.ad = ad.data();
+    req.adlen = ad.size();
+    req.in = in.data();
+    req.inlen = in.size();
+    req.out = out;
+    return op_awaiter(q, req);
+}
+
+//Encryption: 'out' must hold m.size() + ASYNC_TAGBYTES bytes
+inline op_awaiter seal(romulus_async *q, std::uint32_t alg, const void *key,
+    std::span<const std::uint8_t, ASYNC_NPUBBYTES> npub,
+    std::span<const std::uint8_t> ad, std::span<const std::uint8_t> m,
+    std::uint8_t *out) noexcept
+{
+    return make_op(q, ASYNC_ENCRYPT, alg, key, npub, ad, m, out);
+}
+
+//Decryption: 'out' must hold c.size() - ASYNC_TAGBYTES bytes
+inline op_awaiter open(romulus_async *q, std::uint32_t alg, const void *key,
+    std::span<const std::uint8_t, ASYNC_NPUBBYTES> npub,
+    std::span<const std::uint8_t> ad, std::span<const std::uint8_t> c,
+    std::uint8_t *out) noexcept
+{
+    return make_op(q, ASYNC_DECRYPT, alg, key, npub, ad, c, out);
+}
+
+//Resumes the coroutines of up to 'max' completed jobs. Returns the number of
+//coroutines resumed.
+inline std::size_t drain(romulus_async *q, std::size_t max = SIZE_MAX)
+{
+    romulus_async_result res[32];
+    std::size_t total = 0;
+    int n;
+    while (total < max) {
+        n = romulus_async_poll(q, res,
+            max - total < 32 ? static_cast<int>(max - total) : 32);
+        if (n <= 0)
+            break;
+        for(int i = 0; i < n; i++) {
+            auto *a = reinterpret_cast<op_awaiter *>(res[i].cookie);
+            a->res_ = res[i];
+            a->handle_.resume();
+        }
+        total += n;
+    }
+    return total;
+}
+
+}  // namespace romulus
+
+#endif  // ROMULUS_ASYNC_HPP_
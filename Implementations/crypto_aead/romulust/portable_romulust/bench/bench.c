@@ -0,0 +1,163 @@
+/**
+ * Benchmark harness shared by the micro- and end-to-end benchmarks (see
+ * 'bench.h').
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/random.h>
+#include "skinny128.h"
+#include "randombytes.h"
+#include "bench.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static int format = BENCH_TEXT;
+static const char *suite = "";
+static int header_done = 0;
+
+/**
+ * Randomness source required by the masked implementation.
+ */
+void randombytes(unsigned char *x, unsigned long long xlen)
+{
+    ssize_t n;
+    while (xlen > 0) {
+        n = getrandom(x, xlen > 256 ? 256 : xlen, 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            abort();
+        }
+        x += n;
+        xlen -= n;
+    }
+}
+
+uint64_t bench_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    // prevents the TSC from being read before previous instructions complete
+    _mm_lfence();
+    return __rdtsc();
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec*1000000000 + t.tv_nsec;
+#endif
+}
+
+const char *bench_tick_unit(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+double bench_now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+static int cmp_ticks(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+double bench_measure(bench_fn fn, void *arg)
+{
+    uint64_t t, s[BENCH_SAMPLES];
+    size_t iters = 1;
+    int i;
+
+    fn(arg, iters);     // warm-up (caches, lazy feature detection)
+    for(;;) {
+        t = bench_ticks();
+        fn(arg, iters);
+        t = bench_ticks() - t;
+        if (t >= BENCH_MIN_TICKS || iters >= ((size_t)1 << 30))
+            break;
+        iters *= 2;
+    }
+    for(i = 0; i < BENCH_SAMPLES; i++) {
+        t = bench_ticks();
+        fn(arg, iters);
+        s[i] = bench_ticks() - t;
+    }
+    qsort(s, BENCH_SAMPLES, sizeof(uint64_t), cmp_ticks);
+    return (double)s[BENCH_SAMPLES/2] / iters;
+}
+
+int bench_parse_format(const char *s)
+{
+    if (strcmp(s, "text") == 0)
+        return BENCH_TEXT;
+    if (strcmp(s, "csv") == 0)
+        return BENCH_CSV;
+    if (strcmp(s, "json") == 0)
+        return BENCH_JSON;
+    return -1;
+}
+
+void bench_init(int fmt, const char *name)
+{
+    format = fmt;
+    suite = name;
+    header_done = 0;
+}
+
+void bench_report(const bench_result *r)
+{
+    switch (format) {
+    case BENCH_CSV:
+        if (!header_done)
+            printf("suite,name,backend,mode,size,size_unit,value,unit,"
+                "features\n");
+        printf("%s,%s,%s,%s,%llu,%s,%.2f,%s,\"%s\"\n", suite, r->name,
+            r->backend, r->mode, r->size, r->size_unit, r->value, r->unit,
+            bench_features());
+        break;
+    case BENCH_JSON:
+        printf("{\"suite\":\"%s\",\"name\":\"%s\",\"backend\":\"%s\","
+            "\"mode\":\"%s\",\"size\":%llu,\"size_unit\":\"%s\","
+            "\"value\":%.2f,\"unit\":\"%s\",\"features\":\"%s\"}\n", suite,
+            r->name, r->backend, r->mode, r->size, r->size_unit, r->value,
+            r->unit, bench_features());
+        break;
+    default:
+        if (!header_done)
+            printf("# %s (CPU features: %s)\n%-24s %-14s %-11s %10s %-8s "
+                "%12s %s\n", suite, bench_features(), "name", "backend",
+                "mode", "size", "", "value", "unit");
+        printf("%-24s %-14s %-11s %10llu %-8s %12.2f %s\n", r->name,
+            r->backend, r->mode, r->size, r->size_unit, r->value, r->unit);
+        break;
+    }
+    header_done = 1;
+    fflush(stdout);
+}
+
+const char *bench_features(void)
+{
+    static char buf[32];
+    buf[0] = '\0';
+    if (gfni_available())
+        strcat(buf, "gfni");
+    if (avx2_available())
+        strcat(buf, buf[0] ? ",avx2" : "avx2");
+    return buf[0] ? buf : "none";
+}
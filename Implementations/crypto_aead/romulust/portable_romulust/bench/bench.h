@@ -0,0 +1,65 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+//Harness shared by the benchmarks of the portable implementation: the
+//micro-benchmarks of the Skinny primitives ('skinny128_bench.c') and the
+//end-to-end ones ('romulus_aead_bench.c', 'romulus_bulk_bench.c',
+//'../pool/romulus_pool_bench.c', '../sched/romulus_sched_bench.c').
+//
+//Timings are read from the TSC on x86, i.e. in reference cycles which only
+//match core cycles when frequency scaling and turbo are disabled, and from
+//CLOCK_MONOTONIC (in nanoseconds) elsewhere. Each measurement is the median
+//of BENCH_SAMPLES samples, the number of iterations per sample being doubled
+//until a sample lasts at least BENCH_MIN_TICKS ticks.
+//
+//Results are printed as a table, as CSV or as JSON lines (one object per
+//result), along with the CPU features driving the runtime dispatch. The
+//'randombytes' function required by the masked implementation is provided as
+//well (see 'randombytes.h').
+#define BENCH_SAMPLES       15
+#define BENCH_MIN_TICKS     (1 << 20)
+
+#define BENCH_TEXT          0
+#define BENCH_CSV           1
+#define BENCH_JSON          2
+
+typedef struct {
+    const char *name;                       // function or primitive
+    const char *backend;
+    const char *mode;                       // e.g. "latency", "throughput"
+    unsigned long long size;                // processed per call
+    const char *size_unit;                  // e.g. "blocks", "bytes"
+    double value;
+    const char *unit;                       // e.g. "cycles/call", "MB/s"
+} bench_result;
+
+//Runs 'iters' iterations of the benchmarked operation
+typedef void (*bench_fn)(void *arg, size_t iters);
+
+uint64_t bench_ticks(void);
+
+//"cycles" or "ns", depending on the source of 'bench_ticks'
+const char *bench_tick_unit(void);
+
+//Wall-clock time in seconds
+double bench_now(void);
+
+//Returns the median number of ticks per iteration of 'fn'
+double bench_measure(bench_fn fn, void *arg);
+
+//Parses "text", "csv" or "json". Returns -1 if 's' is none of them.
+int bench_parse_format(const char *s);
+
+//Selects the output format, 'suite' being reported along with each result
+void bench_init(int format, const char *suite);
+
+void bench_report(const bench_result *r);
+
+//Comma-separated CPU features relevant to the runtime dispatch (e.g.
+//"gfni,avx2"), "none" if there is none.
+const char *bench_features(void);
+
+#endif  // BENCH_H_
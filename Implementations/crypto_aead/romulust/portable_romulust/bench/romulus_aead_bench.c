@@ -0,0 +1,181 @@
+/**
+ * End-to-end benchmarks of the masked Romulus-T API, in ticks per byte (see
+ * 'bench.h') for increasing message sizes:
+ *  - latency: a single message per call, with the key expanded within the
+ *    call ('crypto_aead_{en,de}crypt_shared') or beforehand ('_ctx'),
+ *  - throughput: ROMULUST_BATCH messages under distinct keys per call
+ *    ('_batch').
+ * Messages come with as many bytes of AD, which are accounted for in the
+ * processed size.
+ *
+ * Build from the 'portable_romulust' directory:
+ *   cc -O2 -o romulus_aead_bench bench/romulus_aead_bench.c bench/bench.c \
+ *      aead.c romulus_t.c skinny128_*.c -I.
+ * Usage:
+ *   romulus_aead_bench [-f text|csv|json] [-s <max message bytes>]
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "randombytes.h"
+#include "crypto_aead_shared.h"
+#include "bench.h"
+
+typedef struct {
+    unsigned long long len;
+    uint8_t *m[ROMULUST_BATCH];
+    uint8_t *c[ROMULUST_BATCH];
+    mask_npub_uint32_t npub[ROMULUST_BATCH][4];
+    mask_key_uint32_t k[4];
+    romulust_key_ctx *ctx;                  // ROMULUST_BATCH contexts
+    unsigned long long mlen[ROMULUST_BATCH];
+    unsigned long long clen[ROMULUST_BATCH];
+    int res[ROMULUST_BATCH];
+} aead_data;
+
+static void enc(void *arg, size_t iters)
+{
+    aead_data *a = arg;
+    unsigned long long clen;
+    for(size_t i = 0; i < iters; i++)
+        crypto_aead_encrypt_shared((mask_c_uint32_t *)a->c[0], &clen,
+            (const mask_m_uint32_t *)a->m[0], a->len,
+            (const mask_ad_uint32_t *)a->m[0], a->len, a->npub[0], a->k);
+}
+
+static void enc_ctx(void *arg, size_t iters)
+{
+    aead_data *a = arg;
+    unsigned long long clen;
+    for(size_t i = 0; i < iters; i++)
+        crypto_aead_encrypt_shared_ctx((mask_c_uint32_t *)a->c[0], &clen,
+            (const mask_m_uint32_t *)a->m[0], a->len,
+            (const mask_ad_uint32_t *)a->m[0], a->len, a->npub[0], a->ctx);
+}
+
+static void dec_ctx(void *arg, size_t iters)
+{
+    aead_data *a = arg;
+    unsigned long long mlen;
+    for(size_t i = 0; i < iters; i++)
+        if (crypto_aead_decrypt_shared_ctx(
+            (mask_m_uint32_t *)(a->m[0] + a->len), &mlen,
+            (const mask_c_uint32_t *)a->c[0], a->len + TAGBYTES,
+            (const mask_ad_uint32_t *)a->m[0], a->len, a->npub[0], a->ctx))
+            abort();
+}
+
+static void enc_batch(void *arg, size_t iters)
+{
+    aead_data *a = arg;
+    const romulust_key_ctx *ctx[ROMULUST_BATCH];
+    const mask_npub_uint32_t *npub[ROMULUST_BATCH];
+    for(int b = 0; b < ROMULUST_BATCH; b++) {
+        ctx[b] = &a->ctx[b];
+        npub[b] = a->npub[b];
+    }
+    for(size_t i = 0; i < iters; i++)
+        crypto_aead_encrypt_shared_batch((mask_c_uint32_t *const *)a->c,
+            a->clen, (const mask_m_uint32_t *const *)a->m, a->mlen,
+            (const mask_ad_uint32_t *const *)a->m, a->mlen, npub, ctx,
+            ROMULUST_BATCH);
+}
+
+static void dec_batch(void *arg, size_t iters)
+{
+    aead_data *a = arg;
+    const romulust_key_ctx *ctx[ROMULUST_BATCH];
+    const mask_npub_uint32_t *npub[ROMULUST_BATCH];
+    uint8_t *m[ROMULUST_BATCH];
+    unsigned long long mlen[ROMULUST_BATCH];
+    for(int b = 0; b < ROMULUST_BATCH; b++) {
+        ctx[b] = &a->ctx[b];
+        npub[b] = a->npub[b];
+        m[b] = a->m[b] + a->len;            // AD left untouched
+    }
+    for(size_t i = 0; i < iters; i++)
+        if (crypto_aead_decrypt_shared_batch((mask_m_uint32_t *const *)m,
+            mlen, (const mask_c_uint32_t *const *)a->c, a->clen,
+            (const mask_ad_uint32_t *const *)a->m, a->mlen, npub, ctx,
+            a->res, ROMULUST_BATCH))
+            abort();
+}
+
+int main(int argc, char *argv[])
+{
+    int opt, b, fmt = BENCH_TEXT;
+    unsigned long long len, max = 16384;
+    aead_data a;
+    mask_key_uint32_t ks[4*ROMULUST_BATCH];
+    char unit[32];
+    bench_result r;
+
+    while ((opt = getopt(argc, argv, "f:s:")) != -1) {
+        if (opt == 's')
+            max = strtoull(optarg, NULL, 0);
+        else if (opt != 'f' || (fmt = bench_parse_format(optarg)) < 0) {
+            fprintf(stderr, "usage: %s [-f text|csv|json] "
+                "[-s <max message bytes>]\n", argv[0]);
+            return 1;
+        }
+    }
+    // messages are followed by room for their decrypted copy
+    for(b = 0; b < ROMULUST_BATCH; b++) {
+        a.m[b] = malloc(2*max + TAGBYTES);
+        a.c[b] = malloc(max + TAGBYTES);
+        if (a.m[b] == NULL || a.c[b] == NULL)
+            return 1;
+        randombytes(a.m[b], 2*max + TAGBYTES);
+    }
+    a.ctx = aligned_alloc(64, ROMULUST_BATCH*sizeof(romulust_key_ctx));
+    if (a.ctx == NULL)
+        return 1;
+    randombytes((uint8_t *)ks, sizeof(ks));
+    randombytes((uint8_t *)a.npub, sizeof(a.npub));
+    for(b = 0; b < 4; b++)
+        a.k[b] = ks[b];
+    romulus_expand_keys(a.ctx, ks, ROMULUST_BATCH);
+
+    snprintf(unit, sizeof(unit), "%s/byte", bench_tick_unit());
+    bench_init(fmt, "romulus-t");
+    r.backend = "portable";
+    r.size_unit = "bytes";
+    r.unit = unit;
+    for(len = 16; len <= max; len *= 4) {
+        a.len = len;
+        for(b = 0; b < ROMULUST_BATCH; b++)
+            a.mlen[b] = len;
+        // ciphertexts to be decrypted
+        enc_batch(&a, 1);
+        r.size = 2*len;
+        r.mode = "latency";
+        r.name = "encrypt_shared";
+        r.value = bench_measure(enc, &a) / r.size;
+        bench_report(&r);
+        r.name = "encrypt_shared_ctx";
+        r.value = bench_measure(enc_ctx, &a) / r.size;
+        bench_report(&r);
+        r.name = "decrypt_shared_ctx";
+        r.value = bench_measure(dec_ctx, &a) / r.size;
+        bench_report(&r);
+        r.mode = "throughput";
+        r.size = 2*len*ROMULUST_BATCH;
+        r.name = "encrypt_shared_batch";
+        r.value = bench_measure(enc_batch, &a) / r.size;
+        bench_report(&r);
+        r.name = "decrypt_shared_batch";
+        r.value = bench_measure(dec_batch, &a) / r.size;
+        bench_report(&r);
+    }
+    for(b = 0; b < ROMULUST_BATCH; b++) {
+        free(a.m[b]);
+        free(a.c[b]);
+    }
+    free(a.ctx);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * Benchmark of the bulk mode (see 'romulus_bulk.h') against the default
+ * message loops, on messages larger than the last-level cache.
+ *
+ * For each mode, a message is encrypted and decrypted through the '_ctx' API
+ * (in ticks per byte, see 'bench.h'), then a working set of half the L2 size,
+ * which was hot before the call, is read again to estimate how much of it has
+ * been evicted (in ticks per cache line). Each figure is the median of several
+ * runs since a single call already lasts seconds.
+ *
+ * Build from the 'portable_romulust' directory:
+ *   cc -O2 -o romulus_bulk_bench bench/romulus_bulk_bench.c bench/bench.c \
+ *      aead.c romulus_t.c skinny128_*.c -I.
+ * Usage:
+ *   romulus_bulk_bench [-f text|csv|json] [-s <message bytes>] [-r <runs>]
+ * The message size defaults to twice the last-level cache size.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "randombytes.h"
+#include "crypto_aead_shared.h"
+#include "romulus_bulk.h"
+#include "bench.h"
+
+#define BULK_LINEBYTES  64
+#define BULK_MAXRUNS    15
+
+/**
+ * Reads one byte per cache line of 'buf'. Returns the number of ticks taken.
+ */
+static uint64_t walk(const volatile uint8_t *buf, size_t len)
+{
+    uint64_t t = bench_ticks();
+    uint8_t acc = 0;
+    for(size_t i = 0; i < len; i += BULK_LINEBYTES)
+        acc ^= buf[i];
+    (void)acc;
+    return bench_ticks() - t;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static long cache_size(int name, long fallback)
+{
+    long s = sysconf(name);
+    return (s > 0) ? s : fallback;
+}
+
+int main(int argc, char *argv[])
+{
+    int opt, op, mode, i, runs = 3, fmt = BENCH_TEXT;
+    unsigned long long len = 0, outlen;
+    size_t wlen;
+    uint8_t *m, *c, *w;
+    mask_key_uint32_t k[4];
+    mask_npub_uint32_t npub[4];
+    romulust_key_ctx *ctx;
+    uint64_t t, call[BULK_MAXRUNS], reload[BULK_MAXRUNS];
+    char unit[32], line_unit[32];
+    static const char *modes[] = { "default", "bulk" };
+    static const char *names[] = { "encrypt_shared_ctx", "decrypt_shared_ctx" };
+    bench_result r;
+
+    while ((opt = getopt(argc, argv, "f:s:r:")) != -1) {
+        if (opt == 's')
+            len = strtoull(optarg, NULL, 0);
+        else if (opt == 'r')
+            runs = atoi(optarg);
+        else if (opt != 'f' || (fmt = bench_parse_format(optarg)) < 0)
+            runs = 0;
+    }
+    if (runs < 1 || runs > BULK_MAXRUNS) {
+        fprintf(stderr, "usage: %s [-f text|csv|json] [-s <message bytes>] "
+            "[-r <runs, up to %d>]\n", argv[0], BULK_MAXRUNS);
+        return 1;
+    }
+    if (len == 0)
+        len = 2*(unsigned long long)cache_size(_SC_LEVEL3_CACHE_SIZE, 32 << 20);
+    wlen = cache_size(_SC_LEVEL2_CACHE_SIZE, 1 << 20) / 2;
+    m = malloc(len + TAGBYTES);
+    c = malloc(len + TAGBYTES);
+    w = malloc(wlen);
+    ctx = aligned_alloc(64, sizeof(romulust_key_ctx));
+    if (m == NULL || c == NULL || w == NULL || ctx == NULL)
+        return 1;
+    randombytes(m, len);
+    randombytes(w, wlen);
+    randombytes((uint8_t *)k, sizeof(k));
+    randombytes((uint8_t *)npub, sizeof(npub));
+    romulus_expand_keys(ctx, k, 1);
+    fprintf(stderr, "%llu-byte messages, %zu-byte working set, %d run(s)\n",
+        len, wlen, runs);
+
+    snprintf(unit, sizeof(unit), "%s/byte", bench_tick_unit());
+    snprintf(line_unit, sizeof(line_unit), "%s/line", bench_tick_unit());
+    bench_init(fmt, "romulus-t-bulk");
+    r.backend = "portable";
+    r.size = len;
+    r.size_unit = "bytes";
+    for(mode = 0; mode < 2; mode++) {
+        romulus_bulk_threshold = mode ? 1 : 0;
+        r.mode = modes[mode];
+        for(op = 0; op < 2; op++) {
+            for(i = 0; i < runs; i++) {
+                walk(w, wlen);
+                t = bench_ticks();
+                if (op == 0)
+                    crypto_aead_encrypt_shared_ctx((mask_c_uint32_t *)c,
+                        &outlen, (const mask_m_uint32_t *)m, len, NULL, 0,
+                        npub, ctx);
+                else if (crypto_aead_decrypt_shared_ctx((mask_m_uint32_t *)m,
+                        &outlen, (const mask_c_uint32_t *)c, len + TAGBYTES,
+                        NULL, 0, npub, ctx))
+                    abort();
+                call[i] = bench_ticks() - t;
+                reload[i] = walk(w, wlen);
+            }
+            qsort(call, runs, sizeof(uint64_t), cmp_u64);
+            qsort(reload, runs, sizeof(uint64_t), cmp_u64);
+            r.name = names[op];
+            r.value = (double)call[runs/2] / len;
+            r.unit = unit;
+            bench_report(&r);
+            r.name = (op == 0) ? "reload_after_encrypt" : "reload_after_decrypt";
+            r.value = (double)reload[runs/2] / (wlen / BULK_LINEBYTES);
+            r.unit = line_unit;
+            bench_report(&r);
+        }
+    }
+    free(m);
+    free(c);
+    free(w);
+    free(ctx);
+    return 0;
+}
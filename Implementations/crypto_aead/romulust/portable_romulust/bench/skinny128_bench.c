@@ -0,0 +1,491 @@
+/**
+ * Micro-benchmarks of the Skinny-128-384+ primitives and tweakey schedule
+ * stages, for every backend available on the CPU.
+ *
+ * Each primitive is timed in isolation, in ticks per call (see 'bench.h'):
+ *  - latency: each call takes the output of the previous one as input, so
+ *    that calls cannot overlap,
+ *  - throughput: consecutive calls work on distinct buffers, so that the CPU
+ *    is free to overlap them.
+ * Multi-block backends report the number of blocks processed per call.
+ * 'hirose_128_128_256' is the compression function of Romulus-H as computed
+ * in 'romulusht_x8' for a single input (tweakey schedule and both
+ * Skinny-128-384+ calls).
+ *
+ * Build from the 'portable_romulust' directory:
+ *   cc -O2 -o skinny128_bench bench/skinny128_bench.c bench/bench.c \
+ *      skinny128_*.c romulus_t.c -I.
+ * Usage:
+ *   skinny128_bench [-f text|csv|json]
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "randombytes.h"
+#include "skinny128.h"
+#include "bench.h"
+
+#define SLOTS       8       // independent buffers for throughput runs
+#define BS_BLOCKS   256     // blocks per call of the bitsliced backend
+
+typedef struct {
+    uint8_t rtk_1[SLOTS][TKPERMORDER*BLOCKBYTES];
+    uint8_t rtk_23[SLOTS][SKINNY128_384_ROUNDS*BLOCKBYTES];
+    uint8_t rtk_3m[SLOTS][SKINNY128_384_ROUNDS*BLOCKBYTES];
+    uint8_t tk[3][SLOTS][TWEAKEYBYTES];
+    uint8_t in[2*SLOTS][BLOCKBYTES];
+    uint8_t out[2*SLOTS][BLOCKBYTES];
+    uint8_t min[2*SLOTS][2][BLOCKBYTES];    // masked blocks (2 shares)
+    uint8_t mout[2*SLOTS][2][BLOCKBYTES];
+    uint8_t hin[2][MASKING_SHARES][BLOCKBYTES];
+    uint8_t h[SLOTS][BLOCKBYTES];           // Hirose chaining values
+    uint8_t g[SLOTS][BLOCKBYTES];
+    uint8_t hm[SLOTS][2*BLOCKBYTES];        // Hirose message blocks
+    uint8_t bs_in[BS_BLOCKS][BLOCKBYTES];
+    uint8_t bs_out[BS_BLOCKS][BLOCKBYTES];
+    uint8_t bs_tk[3][BS_BLOCKS][TWEAKEYBYTES];
+    uint32_t rnd[HOM_RAND_WORDS];
+    // pointer arrays for the 8-way backends (2 groups of 8 blocks)
+    uint8_t *out8[2][8];
+    const uint8_t *in8[2][8];
+    const uint8_t *rtk_1_8[8];
+    const uint8_t *rtk_23_8[8];
+    const uint8_t *rtk_3m_8[8];
+    const uint8_t *rtk_3h[MASKING_SHARES];
+} __attribute__((aligned(64))) bench_data;
+
+static bench_data d;
+
+/******************************************************************************
+* skinny128_384_plus
+******************************************************************************/
+static void lat_skinny(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus(d.in[0], d.in[0], d.rtk_1[0], d.rtk_23[0]);
+}
+
+static void thr_skinny(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        skinny128_384_plus(d.out[j], d.in[j], d.rtk_1[j], d.rtk_23[j]);
+    }
+}
+
+static void lat_skinny_x2(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_x2(d.in[0], d.in[1], d.in[0], d.in[1],
+            d.rtk_1[0], d.rtk_23[0], d.rtk_1[1], d.rtk_23[1]);
+}
+
+static void thr_skinny_x2(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = 2*(i % SLOTS);
+        skinny128_384_plus_x2(d.out[j], d.out[j+1], d.in[j], d.in[j+1],
+            d.rtk_1[j/2], d.rtk_23[j/2], d.rtk_1[j/2], d.rtk_23[j/2]);
+    }
+}
+
+static void lat_skinny_x8(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_x8(d.out8[0], (const uint8_t *const *)d.out8[0],
+            d.rtk_1_8, d.rtk_23_8, 8);
+}
+
+static void thr_skinny_x8(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_x8(d.out8[i & 1], d.in8[i & 1], d.rtk_1_8,
+            d.rtk_23_8, 8);
+}
+
+static void lat_skinny_bs(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_bs(d.bs_in, (const uint8_t (*)[BLOCKBYTES])d.bs_in,
+            (const uint8_t (*)[TWEAKEYBYTES])d.bs_tk[0],
+            (const uint8_t (*)[TWEAKEYBYTES])d.bs_tk[1],
+            (const uint8_t (*)[TWEAKEYBYTES])d.bs_tk[2], BS_BLOCKS);
+}
+
+static void thr_skinny_bs(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_bs(d.bs_out, (const uint8_t (*)[BLOCKBYTES])d.bs_in,
+            (const uint8_t (*)[TWEAKEYBYTES])d.bs_tk[0],
+            (const uint8_t (*)[TWEAKEYBYTES])d.bs_tk[1],
+            (const uint8_t (*)[TWEAKEYBYTES])d.bs_tk[2], BS_BLOCKS);
+}
+
+/******************************************************************************
+* skinny128_384_plus_m
+******************************************************************************/
+static void lat_skinny_m(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_m(d.min[0][0], d.min[0][1], d.min[0][0],
+            d.min[0][1], d.rtk_23[0], d.rtk_3m[0], d.rtk_1[0]);
+}
+
+static void thr_skinny_m(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        skinny128_384_plus_m(d.mout[j][0], d.mout[j][1], d.min[j][0],
+            d.min[j][1], d.rtk_23[j], d.rtk_3m[j], d.rtk_1[j]);
+    }
+}
+
+static void lat_skinny_m_x8(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_m_x8(d.min, (const uint8_t (*)[2][BLOCKBYTES])d.min,
+            d.rtk_23_8, d.rtk_3m_8, d.rtk_1_8, 8);
+}
+
+static void thr_skinny_m_x8(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = 8*(i & 1);
+        skinny128_384_plus_m_x8(d.mout + j,
+            (const uint8_t (*)[2][BLOCKBYTES])d.min + j, d.rtk_23_8,
+            d.rtk_3m_8, d.rtk_1_8, 8);
+    }
+}
+
+static void lat_skinny_hom(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_hom(d.hin[i & 1],
+            (const uint8_t (*)[BLOCKBYTES])d.hin[~i & 1], d.rtk_3h, d.rtk_1[0],
+            d.rnd);
+}
+
+static void thr_skinny_hom(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        skinny128_384_plus_hom(d.hin[1], (const uint8_t (*)[BLOCKBYTES])d.hin[0],
+            d.rtk_3h, d.rtk_1[0], d.rnd);
+}
+
+/******************************************************************************
+* Tweakey schedule stages
+******************************************************************************/
+static void lat_tks_lfsr_23(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_lfsr_23(d.rtk_23[i & 1], d.rtk_23[~i & 1],
+            d.rtk_23[~i & 1] + TWEAKEYBYTES, SKINNY128_384_ROUNDS);
+}
+
+static void thr_tks_lfsr_23(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        tks_lfsr_23(d.rtk_23[j], d.tk[1][j], d.tk[2][j], SKINNY128_384_ROUNDS);
+    }
+}
+
+static void lat_tks_lfsr_3(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_lfsr_3(d.rtk_23[i & 1], d.rtk_23[~i & 1], SKINNY128_384_ROUNDS);
+}
+
+static void thr_tks_lfsr_3(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        tks_lfsr_3(d.rtk_23[j], d.tk[2][j], SKINNY128_384_ROUNDS);
+    }
+}
+
+static void lat_tks_perm_23(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_perm_23(d.rtk_23[0]);
+}
+
+static void thr_tks_perm_23(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_perm_23(d.rtk_23[i % SLOTS]);
+}
+
+static void lat_tks_perm_23_norc(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_perm_23_norc(d.rtk_23[0]);
+}
+
+static void thr_tks_perm_23_norc(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_perm_23_norc(d.rtk_23[i % SLOTS]);
+}
+
+static void lat_tks_perm_1(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_perm_1(d.rtk_1[i & 1], d.rtk_1[~i & 1]);
+}
+
+static void thr_tks_perm_1(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        tks_perm_1(d.rtk_1[j], d.tk[0][j]);
+    }
+}
+
+static void lat_tks_perm_1_gfni(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_perm_1_gfni(d.rtk_1[i & 1], d.rtk_1[~i & 1]);
+}
+
+static void thr_tks_perm_1_gfni(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        tks_perm_1_gfni(d.rtk_1[j], d.tk[0][j]);
+    }
+}
+
+// full TK2/TK3 schedule, as computed by 'tks_23' without GFNI
+static void lat_tks_23(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        tks_lfsr_23(d.rtk_23[i & 1], d.rtk_23[~i & 1],
+            d.rtk_23[~i & 1] + TWEAKEYBYTES, SKINNY128_384_ROUNDS);
+        tks_perm_23(d.rtk_23[i & 1]);
+    }
+}
+
+static void thr_tks_23(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        tks_lfsr_23(d.rtk_23[j], d.tk[1][j], d.tk[2][j], SKINNY128_384_ROUNDS);
+        tks_perm_23(d.rtk_23[j]);
+    }
+}
+
+static void lat_tks_23_gfni(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        tks_23_gfni(d.rtk_23[i & 1], d.rtk_23[~i & 1],
+            d.rtk_23[~i & 1] + TWEAKEYBYTES);
+}
+
+static void thr_tks_23_gfni(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        tks_23_gfni(d.rtk_23[j], d.tk[1][j], d.tk[2][j]);
+    }
+}
+
+/******************************************************************************
+* hirose_128_128_256
+******************************************************************************/
+/**
+ * Hirose's double-block length compression function as computed in
+ * 'romulusht_x8': g is used as TK1 and the 32-byte message block as TK2/TK3,
+ * both Skinny-128-384+ calls sharing the same tweakey.
+ */
+static void hirose_128_128_256(
+    uint8_t h[BLOCKBYTES],
+    uint8_t g[BLOCKBYTES],
+    const uint8_t m[2*BLOCKBYTES])
+{
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES];
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES];
+    uint8_t h1[BLOCKBYTES], tmp[BLOCKBYTES];
+    int j;
+    tk_schedule_123(rtk_1, rtk_23, g, m, m + BLOCKBYTES);
+    for(j = 0; j < BLOCKBYTES; j++)
+        h1[j] = h[j];
+    h1[0] ^= 0x01;
+    skinny128_384_plus_x2(tmp, g, h, h1, rtk_1, rtk_23, rtk_1, rtk_23);
+    h[0] ^= 0x01;
+    for(j = 0; j < BLOCKBYTES; j++) {
+        g[j] ^= h[j];
+        h[j] ^= tmp[j];
+    }
+    h[0] ^= 0x01;
+}
+
+static void lat_hirose(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++)
+        hirose_128_128_256(d.h[0], d.g[0], d.hm[0]);
+}
+
+static void thr_hirose(void *arg, size_t iters)
+{
+    (void)arg;
+    for(size_t i = 0; i < iters; i++) {
+        int j = i % SLOTS;
+        hirose_128_128_256(d.h[j], d.g[j], d.hm[j]);
+    }
+}
+
+/******************************************************************************
+* Driver
+******************************************************************************/
+typedef struct {
+    const char *name;
+    const char *backend;
+    int blocks;                             // blocks per call
+    int (*available)(void);                 // NULL: always available
+    bench_fn lat;
+    bench_fn thr;
+} kernel;
+
+static int has_avx2(void)
+{
+    return avx2_available();
+}
+
+static int lacks_avx2(void)
+{
+    return !avx2_available();
+}
+
+static const kernel kernels[] = {
+    { "skinny128_384_plus", "fixsliced", 1, NULL,
+      lat_skinny, thr_skinny },
+    { "skinny128_384_plus", "x2", 2, NULL,
+      lat_skinny_x2, thr_skinny_x2 },
+    { "skinny128_384_plus", "x8-avx2", 8, has_avx2,
+      lat_skinny_x8, thr_skinny_x8 },
+    { "skinny128_384_plus", "x8-pairs", 8, lacks_avx2,
+      lat_skinny_x8, thr_skinny_x8 },
+    { "skinny128_384_plus", "bitsliced", BS_BLOCKS, NULL,
+      lat_skinny_bs, thr_skinny_bs },
+    { "skinny128_384_plus_m", "fixsliced", 1, NULL,
+      lat_skinny_m, thr_skinny_m },
+    { "skinny128_384_plus_m", "x8-avx2", 8, has_avx2,
+      lat_skinny_m_x8, thr_skinny_m_x8 },
+    { "skinny128_384_plus_m", "x8-serial", 8, lacks_avx2,
+      lat_skinny_m_x8, thr_skinny_m_x8 },
+    { "skinny128_384_plus_m", "hom", 1, NULL,
+      lat_skinny_hom, thr_skinny_hom },
+    { "tks_lfsr_23", "portable", 1, NULL,
+      lat_tks_lfsr_23, thr_tks_lfsr_23 },
+    { "tks_lfsr_3", "portable", 1, NULL,
+      lat_tks_lfsr_3, thr_tks_lfsr_3 },
+    { "tks_perm_23", "portable", 1, NULL,
+      lat_tks_perm_23, thr_tks_perm_23 },
+    { "tks_perm_23_norc", "portable", 1, NULL,
+      lat_tks_perm_23_norc, thr_tks_perm_23_norc },
+    { "tks_perm_1", "portable", 1, NULL,
+      lat_tks_perm_1, thr_tks_perm_1 },
+    { "tks_perm_1", "gfni", 1, gfni_available,
+      lat_tks_perm_1_gfni, thr_tks_perm_1_gfni },
+    { "tks_23", "portable", 1, NULL,
+      lat_tks_23, thr_tks_23 },
+    { "tks_23", "gfni", 1, gfni_available,
+      lat_tks_23_gfni, thr_tks_23_gfni },
+    { "hirose_128_128_256", "x2", 1, NULL,
+      lat_hirose, thr_hirose },
+};
+
+static void init_data(void)
+{
+    int i;
+    randombytes((uint8_t *)&d, sizeof(d));
+    for(i = 0; i < SLOTS; i++) {
+        tks_perm_1(d.rtk_1[i], d.tk[0][i]);
+        tks_23(d.rtk_23[i], d.tk[1][i], d.tk[2][i], 1);
+        tks_23(d.rtk_3m[i], NULL, d.tk[0][i], 0);
+    }
+    for(i = 0; i < 8; i++) {
+        d.out8[0][i] = d.out[i];
+        d.out8[1][i] = d.out[8 + i];
+        d.in8[0][i] = d.in[i];
+        d.in8[1][i] = d.in[8 + i];
+        d.rtk_1_8[i] = d.rtk_1[i];
+        d.rtk_23_8[i] = d.rtk_23[i];
+        d.rtk_3m_8[i] = d.rtk_3m[i];
+    }
+    for(i = 0; i < MASKING_SHARES; i++)
+        d.rtk_3h[i] = (i == 0) ? d.rtk_23[0] : d.rtk_3m[i % SLOTS];
+}
+
+int main(int argc, char *argv[])
+{
+    int opt, fmt = BENCH_TEXT;
+    size_t i;
+    char unit[32], hom[32];
+    bench_result r;
+
+    while ((opt = getopt(argc, argv, "f:")) != -1) {
+        if (opt != 'f' || (fmt = bench_parse_format(optarg)) < 0) {
+            fprintf(stderr, "usage: %s [-f text|csv|json]\n", argv[0]);
+            return 1;
+        }
+    }
+    init_data();
+    snprintf(unit, sizeof(unit), "%s/call", bench_tick_unit());
+    snprintf(hom, sizeof(hom), "hom-d%d", MASKING_ORDER);
+    bench_init(fmt, "skinny128");
+    for(i = 0; i < sizeof(kernels)/sizeof(kernels[0]); i++) {
+        const kernel *k = &kernels[i];
+        if (k->available && !k->available())
+            continue;
+        r.name = k->name;
+        r.backend = (k->lat == lat_skinny_hom) ? hom : k->backend;
+        r.size = k->blocks;
+        r.size_unit = "blocks";
+        r.unit = unit;
+        r.mode = "latency";
+        r.value = bench_measure(k->lat, NULL);
+        bench_report(&r);
+        r.mode = "throughput";
+        r.value = bench_measure(k->thr, NULL);
+        bench_report(&r);
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * API defined by the Cryptographic Engineering Research Group (CREG) from
+ * George Mason University (GMU) in their call for protected software
+ * implementations of NIST LWC finalists.
+ */ 
+#include "api.h"
+#include "romulus_t.h"
+
+typedef struct {
+    uint32_t shares[NUM_SHARES_M];
+} mask_m_uint32_t;
+
+typedef struct {
+    uint32_t shares[NUM_SHARES_C];
+} mask_c_uint32_t;
+
+typedef struct {
+    uint32_t shares[NUM_SHARES_AD];
+} mask_ad_uint32_t;
+
+typedef struct {
+    uint32_t shares[NUM_SHARES_NPUB];
+} mask_npub_uint32_t;
+
+typedef struct {
+    uint32_t shares[NUM_SHARES_KEY];
+} mask_key_uint32_t;
+
+
+int crypto_aead_encrypt_shared(
+    mask_c_uint32_t* cs, unsigned long long *clen,
+    const mask_m_uint32_t *ms, unsigned long long mlen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const mask_key_uint32_t *ks
+);
+
+int crypto_aead_decrypt_shared(
+    mask_m_uint32_t* ms, unsigned long long *mlen,
+    const mask_c_uint32_t *cs, unsigned long long clen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const mask_key_uint32_t *ks
+);
+
+/**
+ * Key-context variants so that the key schedule is computed once per key.
+ */
+void romulus_expand_keys(
+    romulust_key_ctx *ctx,
+    const mask_key_uint32_t *ks,
+    size_t n
+);
+
+int crypto_aead_encrypt_shared_ctx(
+    mask_c_uint32_t* cs, unsigned long long *clen,
+    const mask_m_uint32_t *ms, unsigned long long mlen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const romulust_key_ctx *ctx
+);
+
+int crypto_aead_decrypt_shared_ctx(
+    mask_m_uint32_t* ms, unsigned long long *mlen,
+    const mask_c_uint32_t *cs, unsigned long long clen,
+    const mask_ad_uint32_t *ads, unsigned long long adlen,
+    const mask_npub_uint32_t *npubs,
+    const romulust_key_ctx *ctx
+);
+
+/**
+ * Batch variants for 'n' independent messages, possibly under different keys.
+ * 'res[i]' is set to a non-zero value if tag verification fails for the i-th
+ * message.
+ */
+int crypto_aead_encrypt_shared_batch(
+    mask_c_uint32_t *const cs[], unsigned long long clen[],
+    const mask_m_uint32_t *const ms[], const unsigned long long mlen[],
+    const mask_ad_uint32_t *const ads[], const unsigned long long adlen[],
+    const mask_npub_uint32_t *const npubs[],
+    const romulust_key_ctx *const ctx[],
+    size_t n
+);
+
+int crypto_aead_decrypt_shared_batch(
+    mask_m_uint32_t *const ms[], unsigned long long mlen[],
+    const mask_c_uint32_t *const cs[], const unsigned long long clen[],
+    const mask_ad_uint32_t *const ads[], const unsigned long long adlen[],
+    const mask_npub_uint32_t *const npubs[],
+    const romulust_key_ctx *const ctx[],
+    int res[],
+    size_t n
+);
+
+/**
+ * Optional hook called at entry of the encryption/decryption functions above
+ * (once per message for the batch variants), e.g. to capture workload traces
+ * (see 'trace/romulus_trace.h'). 'key' is the key context, NULL if the key is
+ * expanded within the call, and 'len' is mlen (encryption) or clen
+ * (decryption). The hook must be thread-safe. Calls in flight may still
+ * invoke the previous hook after it is replaced, so that 'arg' must remain
+ * valid until they complete. A NULL hook disables it.
+ */
+#define ROMULUS_HOOK_ENCRYPT    0
+#define ROMULUS_HOOK_DECRYPT    1
+
+typedef void (*romulus_call_hook)(void *arg, int op, const void *key,
+    unsigned long long adlen, unsigned long long len);
+
+void romulus_set_call_hook(romulus_call_hook hook, void *arg);
+
+void generate_shares_encrypt(
+    const unsigned char *m, mask_m_uint32_t *ms, const unsigned long long mlen,
+    const unsigned char *ad, mask_ad_uint32_t *ads, const unsigned long long adlen,
+    const unsigned char *npub, mask_npub_uint32_t *npubs,
+    const unsigned char *k, mask_key_uint32_t *ks
+);
+
+void generate_shares_decrypt(
+    const unsigned char *c, mask_m_uint32_t *cs, const unsigned long long clen,
+    const unsigned char *ad, mask_ad_uint32_t *ads, const unsigned long long adlen,
+    const unsigned char *npub, mask_npub_uint32_t *npubs,
+    const unsigned char *k, mask_key_uint32_t *ks
+);
+
+void combine_shares_encrypt(
+    const mask_c_uint32_t *cs, unsigned char *c, unsigned long long clen
+);
+
+void combine_shares_decrypt(
+    const mask_m_uint32_t *ms, unsigned char *m, unsigned long long mlen
+);
@@ -0,0 +1,136 @@
+#ifndef ROMULUS_OFFLOAD_H_
+#define ROMULUS_OFFLOAD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+//Local crypto offload: clients submit AEAD jobs to 'romulus_offloadd' through
+//a shared-memory region holding a pool of job slots and two single-producer
+//single-consumer rings of slot indices (submissions and completions).
+//
+//A client connects to the daemon's UNIX socket and receives 3 file
+//descriptors via SCM_RIGHTS: the memfd backing the region, an eventfd to
+//notify submissions and an eventfd notified on completions. Keys never leave
+//the daemon: jobs refer to them by the index given in the daemon's key file.
+#define OFFLOAD_MAGIC       0x524f4d31      // "ROM1"
+#define OFFLOAD_SLOTS       256             // power of 2
+#define OFFLOAD_MAXDATA     4096            // max adlen + inlen per job
+#define OFFLOAD_TAGBYTES    16
+#define OFFLOAD_NPUBBYTES   16
+
+//Operations
+#define OFFLOAD_ENCRYPT     0
+#define OFFLOAD_DECRYPT     1
+
+//Algorithms
+#define OFFLOAD_ROMULUS_N   0
+#define OFFLOAD_ROMULUS_M   1
+#define OFFLOAD_ROMULUS_T   2
+
+//Job status
+#define OFFLOAD_OK          0
+#define OFFLOAD_EVERIFY     (-1)            // tag verification failed
+#define OFFLOAD_EINVAL      (-2)            // malformed job
+#define OFFLOAD_ENOKEY      (-3)            // unknown key index
+#define OFFLOAD_ENOTSUP     (-4)            // algorithm not served
+
+//Job slot: the input (ad || in) is replaced by the output in place
+typedef struct {
+    uint64_t cookie;                        // opaque to the daemon
+    uint32_t op;
+    uint32_t alg;
+    uint32_t key_id;
+    uint32_t adlen;
+    uint32_t inlen;
+    uint32_t outlen;                        // set by the daemon
+    int32_t status;                         // set by the daemon
+    uint8_t npub[OFFLOAD_NPUBBYTES];
+    uint8_t data[OFFLOAD_MAXDATA + OFFLOAD_TAGBYTES] __attribute__((aligned(8)));
+} offload_slot;
+
+//SPSC ring of slot indices, head and tail on distinct cache lines
+typedef struct {
+    uint32_t head __attribute__((aligned(64)));     // written by the consumer
+    uint32_t tail __attribute__((aligned(64)));     // written by the producer
+    uint32_t idx[OFFLOAD_SLOTS] __attribute__((aligned(64)));
+} offload_ring;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t nslots;
+    offload_ring sq;                        // client -> daemon
+    offload_ring cq;                        // daemon -> client
+    offload_slot slots[OFFLOAD_SLOTS];
+} offload_region;
+
+//Lock-free SPSC helpers (release on publication, acquire on consumption)
+static inline int offload_ring_push(offload_ring *r, uint32_t v)
+{
+    uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);
+    if (tail - __atomic_load_n(&r->head, __ATOMIC_ACQUIRE) == OFFLOAD_SLOTS)
+        return -1;
+    r->idx[tail % OFFLOAD_SLOTS] = v;
+    __atomic_store_n(&r->tail, tail + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+static inline int offload_ring_pop(offload_ring *r, uint32_t *v)
+{
+    uint32_t head = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+    if (head == __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE))
+        return -1;
+    *v = r->idx[head % OFFLOAD_SLOTS];
+    __atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+//Client library (see 'romulus_offload_client.c')
+typedef struct romulus_offload romulus_offload;
+
+typedef struct {
+    uint64_t cookie;
+    int32_t status;
+    uint32_t outlen;                        // bytes written to 'out'
+} romulus_offload_result;
+
+int romulus_offload_connect(romulus_offload **c, const char *path);
+
+void romulus_offload_close(romulus_offload *c);
+
+//Queues a job without waiting. 'out' must hold inlen + OFFLOAD_TAGBYTES bytes
+//(encryption) or inlen - OFFLOAD_TAGBYTES bytes (decryption) and must remain
+//valid until the job completes. Returns -1 if all slots are in use or if the
+//job does not fit in a slot.
+int romulus_offload_submit(
+    romulus_offload *c,
+    uint32_t op, uint32_t alg, uint32_t key_id,
+    const uint8_t npub[OFFLOAD_NPUBBYTES],
+    const uint8_t *ad, uint32_t adlen,
+    const uint8_t *in, uint32_t inlen,
+    uint8_t *out,
+    uint64_t cookie);
+
+//Retrieves up to 'n' completed jobs, blocking up to 'timeout_ms' milliseconds
+//(-1: forever) if none is available. Returns the number of results or -1 on
+//error.
+int romulus_offload_poll(
+    romulus_offload *c,
+    romulus_offload_result *res, int n,
+    int timeout_ms);
+
+//Synchronous helpers (submit + wait), returning the job status
+int romulus_offload_encrypt(
+    romulus_offload *c, uint32_t alg, uint32_t key_id,
+    uint8_t *out, uint32_t *outlen,
+    const uint8_t *m, uint32_t mlen,
+    const uint8_t *ad, uint32_t adlen,
+    const uint8_t npub[OFFLOAD_NPUBBYTES]);
+
+int romulus_offload_decrypt(
+    romulus_offload *c, uint32_t alg, uint32_t key_id,
+    uint8_t *out, uint32_t *outlen,
+    const uint8_t *ct, uint32_t ctlen,
+    const uint8_t *ad, uint32_t adlen,
+    const uint8_t npub[OFFLOAD_NPUBBYTES]);
+
+#endif  // ROMULUS_OFFLOAD_H_
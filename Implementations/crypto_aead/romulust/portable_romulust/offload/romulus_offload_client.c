@@ -0,0 +1,239 @@
+/**
+ * Client side of the local crypto offload (see 'romulus_offload.h').
+ *
+ * A client owns the slots of its shared region: free slots are tracked
+ * locally, filled with a job and published on the submission ring. The
+ * daemon writes the output into the same slot and publishes its index on the
+ * completion ring, after which the slot is returned to the free list.
+ * A client handle must not be used by several threads concurrently.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "romulus_offload.h"
+
+struct romulus_offload {
+    int sock;
+    int sq_efd;                             // submission doorbell
+    int cq_efd;                             // completion notifications
+    offload_region *region;
+    uint32_t nfree;
+    uint32_t free_slots[OFFLOAD_SLOTS];
+    uint8_t *out[OFFLOAD_SLOTS];            // destination of each pending job
+};
+
+/**
+ * Receives the region memfd and both eventfds from the daemon.
+ */
+static int recv_fds(int sock, int fds[3])
+{
+    char byte;
+    char cbuf[CMSG_SPACE(3*sizeof(int))];
+    struct iovec iov = { .iov_base = &byte, .iov_len = 1 };
+    struct msghdr msg = {
+        .msg_iov = &iov, .msg_iovlen = 1,
+        .msg_control = cbuf, .msg_controllen = sizeof(cbuf)
+    };
+    struct cmsghdr *cmsg;
+    if (recvmsg(sock, &msg, MSG_CMSG_CLOEXEC) != 1)
+        return -1;
+    cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg == NULL || cmsg->cmsg_level != SOL_SOCKET ||
+        cmsg->cmsg_type != SCM_RIGHTS ||
+        cmsg->cmsg_len != CMSG_LEN(3*sizeof(int)))
+        return -1;
+    memcpy(fds, CMSG_DATA(cmsg), 3*sizeof(int));
+    return 0;
+}
+
+/**
+ * Connects to the daemon listening on the UNIX socket 'path'.
+ *
+ * Returns a non-zero value on failure.
+ */
+int romulus_offload_connect(romulus_offload **c, const char *path)
+{
+    struct sockaddr_un addr;
+    romulus_offload *cl;
+    void *p;
+    int fds[3];
+    uint32_t i;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+        return -1;
+    cl = calloc(1, sizeof(*cl));
+    if (cl == NULL)
+        return -1;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    cl->sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (cl->sock < 0)
+        goto err_free;
+    if (connect(cl->sock, (struct sockaddr *)&addr, sizeof(addr)) ||
+        recv_fds(cl->sock, fds))
+        goto err_sock;
+    p = mmap(NULL, sizeof(offload_region), PROT_READ | PROT_WRITE,
+        MAP_SHARED, fds[0], 0);
+    close(fds[0]);
+    if (p == MAP_FAILED)
+        goto err_fds;
+    cl->region = p;
+    if (cl->region->magic != OFFLOAD_MAGIC ||
+        cl->region->nslots != OFFLOAD_SLOTS) {
+        munmap(p, sizeof(offload_region));
+        goto err_fds;
+    }
+    cl->sq_efd = fds[1];
+    cl->cq_efd = fds[2];
+    for(i = 0; i < OFFLOAD_SLOTS; i++)
+        cl->free_slots[i] = OFFLOAD_SLOTS - 1 - i;
+    cl->nfree = OFFLOAD_SLOTS;
+    *c = cl;
+    return 0;
+err_fds:
+    close(fds[1]);
+    close(fds[2]);
+err_sock:
+    close(cl->sock);
+err_free:
+    free(cl);
+    return -1;
+}
+
+/**
+ * Disconnects from the daemon. Pending jobs are discarded.
+ */
+void romulus_offload_close(romulus_offload *c)
+{
+    munmap(c->region, sizeof(offload_region));
+    close(c->sq_efd);
+    close(c->cq_efd);
+    close(c->sock);
+    free(c);
+}
+
+int romulus_offload_submit(
+    romulus_offload *c,
+    uint32_t op, uint32_t alg, uint32_t key_id,
+    const uint8_t npub[OFFLOAD_NPUBBYTES],
+    const uint8_t *ad, uint32_t adlen,
+    const uint8_t *in, uint32_t inlen,
+    uint8_t *out,
+    uint64_t cookie)
+{
+    uint64_t one = 1;
+    uint32_t i;
+    offload_slot *s;
+
+    if (c->nfree == 0 || adlen > OFFLOAD_MAXDATA ||
+        inlen > OFFLOAD_MAXDATA - adlen + (op == OFFLOAD_DECRYPT ?
+            OFFLOAD_TAGBYTES : 0))
+        return -1;
+    i = c->free_slots[--c->nfree];
+    s = &c->region->slots[i];
+    s->cookie = cookie;
+    s->op = op;
+    s->alg = alg;
+    s->key_id = key_id;
+    s->adlen = adlen;
+    s->inlen = inlen;
+    memcpy(s->npub, npub, OFFLOAD_NPUBBYTES);
+    memcpy(s->data, ad, adlen);
+    memcpy(s->data + adlen, in, inlen);
+    c->out[i] = out;
+    // cannot fail since the ring is as large as the slot pool
+    offload_ring_push(&c->region->sq, i);
+    if (write(c->sq_efd, &one, sizeof(one)) != sizeof(one))
+        return -1;
+    return 0;
+}
+
+int romulus_offload_poll(
+    romulus_offload *c,
+    romulus_offload_result *res, int n,
+    int timeout_ms)
+{
+    struct pollfd pfd = { .fd = c->cq_efd, .events = POLLIN };
+    uint64_t cnt;
+    uint32_t i;
+    int k = 0, r;
+    offload_slot *s;
+
+    for(;;) {
+        while (k < n && !offload_ring_pop(&c->region->cq, &i)) {
+            s = &c->region->slots[i];
+            res[k].cookie = s->cookie;
+            res[k].status = s->status;
+            res[k].outlen = (s->status == OFFLOAD_OK) ? s->outlen : 0;
+            // the output replaces the input right after the AD
+            memcpy(c->out[i], s->data + s->adlen, res[k].outlen);
+            c->free_slots[c->nfree++] = i;
+            k++;
+        }
+        if (k > 0 || timeout_ms == 0)
+            return k;
+        // the daemon notifies after publishing, so that no completion is
+        // missed between the ring check and poll()
+        r = poll(&pfd, 1, timeout_ms);
+        if (r < 0 && errno != EINTR)
+            return -1;
+        if (r == 0)
+            return 0;
+        if (r > 0 && read(c->cq_efd, &cnt, sizeof(cnt)) < 0 && errno != EAGAIN)
+            return -1;
+    }
+}
+
+/**
+ * Submits a single job and waits for its completion. Must not be mixed with
+ * pending asynchronous jobs on the same handle.
+ */
+static int offload_sync(
+    romulus_offload *c, uint32_t op, uint32_t alg, uint32_t key_id,
+    uint8_t *out, uint32_t *outlen,
+    const uint8_t *in, uint32_t inlen,
+    const uint8_t *ad, uint32_t adlen,
+    const uint8_t npub[OFFLOAD_NPUBBYTES])
+{
+    romulus_offload_result res;
+    if (romulus_offload_submit(c, op, alg, key_id, npub, ad, adlen, in, inlen,
+            out, 0))
+        return OFFLOAD_EINVAL;
+    while (romulus_offload_poll(c, &res, 1, -1) != 1)
+        ;
+    *outlen = res.outlen;
+    return res.status;
+}
+
+int romulus_offload_encrypt(
+    romulus_offload *c, uint32_t alg, uint32_t key_id,
+    uint8_t *out, uint32_t *outlen,
+    const uint8_t *m, uint32_t mlen,
+    const uint8_t *ad, uint32_t adlen,
+    const uint8_t npub[OFFLOAD_NPUBBYTES])
+{
+    return offload_sync(c, OFFLOAD_ENCRYPT, alg, key_id, out, outlen,
+        m, mlen, ad, adlen, npub);
+}
+
+int romulus_offload_decrypt(
+    romulus_offload *c, uint32_t alg, uint32_t key_id,
+    uint8_t *out, uint32_t *outlen,
+    const uint8_t *ct, uint32_t ctlen,
+    const uint8_t *ad, uint32_t adlen,
+    const uint8_t npub[OFFLOAD_NPUBBYTES])
+{
+    return offload_sync(c, OFFLOAD_DECRYPT, alg, key_id, out, outlen,
+        ct, ctlen, ad, adlen, npub);
+}
@@ -0,0 +1,489 @@
+/**
+ * Local crypto offload daemon (Linux only, see 'romulus_offload.h').
+ *
+ * Jobs submitted by all connected clients are coalesced and processed by
+ * groups through 'crypto_aead_{en,de}crypt_shared_batch', so that the 8-way
+ * AVX2 masked Skinny-128-384+ core is filled even if each client only sends a
+ * few small messages. Keys are read once from a key file (one 32-hex-digit key
+ * per line, the line number being the key index), expanded into key contexts
+ * and wiped.
+ *
+ * Only Romulus-T is served: the Romulus-N/M implementations of this repository
+ * are either ARMv7-M specific or unbatched reference code, so jobs for them
+ * complete with OFFLOAD_ENOTSUP. They can be plugged into 'backends' once a
+ * batch interface is available.
+ *
+ * Build from the 'portable_romulust' directory:
+ *   cc -O2 -o romulus_offloadd offload/romulus_offloadd.c aead.c romulus_t.c \
+ *      skinny128_*.c -I.
+ * Usage:
+ *   romulus_offloadd -s <socket path> -k <key file> [-b <max batch>]
+ *                    [-l <linger in microseconds>]
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/random.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "crypto_aead_shared.h"
+#include "randombytes.h"
+#include "romulus_offload.h"
+
+#define MAX_CLIENTS     64
+#define MAX_BATCH       (MAX_CLIENTS*OFFLOAD_SLOTS)
+
+//epoll tags: listening socket, control socket or submission eventfd of a client
+#define EV_LISTEN       (~0ULL)
+#define EV_SOCK(c)      (2*(uint64_t)(c))
+#define EV_SQ(c)        (2*(uint64_t)(c) + 1)
+
+typedef struct {
+    int sock;                               // -1 if unused
+    int sq_efd;
+    int cq_efd;
+    offload_region *region;
+    int touched;                            // completions to notify
+} client;
+
+//Snapshot of a job header, so that a client cannot alter lengths while its
+//job is being processed
+typedef struct {
+    client *cl;
+    uint32_t slot;
+    uint32_t op;
+    uint32_t key_id;
+    unsigned long long adlen;
+    unsigned long long inlen;
+    offload_slot *s;
+} job;
+
+typedef struct {
+    uint32_t alg;
+    int (*encrypt)(
+        mask_c_uint32_t *const cs[], unsigned long long clen[],
+        const mask_m_uint32_t *const ms[], const unsigned long long mlen[],
+        const mask_ad_uint32_t *const ads[], const unsigned long long adlen[],
+        const mask_npub_uint32_t *const npubs[],
+        const romulust_key_ctx *const ctx[],
+        size_t n);
+    int (*decrypt)(
+        mask_m_uint32_t *const ms[], unsigned long long mlen[],
+        const mask_c_uint32_t *const cs[], const unsigned long long clen[],
+        const mask_ad_uint32_t *const ads[], const unsigned long long adlen[],
+        const mask_npub_uint32_t *const npubs[],
+        const romulust_key_ctx *const ctx[],
+        int res[],
+        size_t n);
+} backend;
+
+static const backend backends[] = {
+    { OFFLOAD_ROMULUS_T, crypto_aead_encrypt_shared_batch,
+        crypto_aead_decrypt_shared_batch },
+};
+
+static client clients[MAX_CLIENTS];
+static romulust_key_ctx *keys;
+static uint32_t nkeys;
+static volatile sig_atomic_t stop;
+
+/**
+ * Randomness source required by the masked implementation.
+ */
+void randombytes(unsigned char *x, unsigned long long xlen)
+{
+    ssize_t n;
+    while (xlen > 0) {
+        n = getrandom(x, xlen > 256 ? 256 : xlen, 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            abort();
+        }
+        x += n;
+        xlen -= n;
+    }
+}
+
+/**
+ * Splits a 16-byte value into NUM_SHARES_KEY shares (key or public nonce).
+ */
+static void split_shares(mask_key_uint32_t ks[4], const uint8_t x[16])
+{
+    int i, j;
+    randombytes((unsigned char *)ks, 4*sizeof(mask_key_uint32_t));
+    for(i = 0; i < 4; i++) {
+        ks[i].shares[0] = (uint32_t)x[4*i] | (uint32_t)x[4*i+1] << 8 |
+            (uint32_t)x[4*i+2] << 16 | (uint32_t)x[4*i+3] << 24;
+        for(j = 1; j < NUM_SHARES_KEY; j++)
+            ks[i].shares[0] ^= ks[i].shares[j];
+    }
+}
+
+/**
+ * Loads and expands the keys, wiping the raw key material afterwards.
+ */
+static int load_keys(const char *path)
+{
+    FILE *f;
+    char line[128];
+    unsigned char k[CRYPTO_KEYBYTES];
+    mask_key_uint32_t ks[4];
+    uint32_t cap = 16;
+    int i = CRYPTO_KEYBYTES;
+
+    f = fopen(path, "r");
+    if (f == NULL)
+        return -1;
+    keys = aligned_alloc(64, cap*sizeof(romulust_key_ctx));
+    while (keys != NULL && fgets(line, sizeof(line), f)) {
+        if (line[0] == '\n' || line[0] == '#')
+            continue;
+        for(i = 0; i < CRYPTO_KEYBYTES; i++)
+            if (sscanf(line + 2*i, "%2hhx", &k[i]) != 1)
+                break;
+        if (i != CRYPTO_KEYBYTES) {
+            fprintf(stderr, "invalid key at index %u\n", nkeys);
+            break;
+        }
+        if (nkeys == cap) {
+            romulust_key_ctx *p = aligned_alloc(64,
+                2*cap*sizeof(romulust_key_ctx));
+            if (p != NULL)
+                memcpy(p, keys, cap*sizeof(romulust_key_ctx));
+            free(keys);
+            keys = p;
+            cap *= 2;
+            if (keys == NULL)
+                break;
+        }
+        split_shares(ks, k);
+        romulus_expand_keys(keys + nkeys++, ks, 1);
+    }
+    explicit_bzero(line, sizeof(line));
+    explicit_bzero(k, sizeof(k));
+    explicit_bzero(ks, sizeof(ks));
+    fclose(f);
+    return (keys == NULL || i != CRYPTO_KEYBYTES) ? -1 : 0;
+}
+
+static int send_fds(int sock, const int fds[3])
+{
+    char byte = 0;
+    char cbuf[CMSG_SPACE(3*sizeof(int))];
+    struct iovec iov = { .iov_base = &byte, .iov_len = 1 };
+    struct msghdr msg = {
+        .msg_iov = &iov, .msg_iovlen = 1,
+        .msg_control = cbuf, .msg_controllen = sizeof(cbuf)
+    };
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(3*sizeof(int));
+    memcpy(CMSG_DATA(cmsg), fds, 3*sizeof(int));
+    return (sendmsg(sock, &msg, MSG_NOSIGNAL) == 1) ? 0 : -1;
+}
+
+static void drop_client(int epfd, client *cl)
+{
+    epoll_ctl(epfd, EPOLL_CTL_DEL, cl->sock, NULL);
+    epoll_ctl(epfd, EPOLL_CTL_DEL, cl->sq_efd, NULL);
+    munmap(cl->region, sizeof(offload_region));
+    close(cl->sq_efd);
+    close(cl->cq_efd);
+    close(cl->sock);
+    cl->sock = -1;
+}
+
+/**
+ * Sets up the shared region and eventfds of a new client.
+ */
+static void accept_client(int epfd, int lsock)
+{
+    struct epoll_event ev;
+    client *cl = NULL;
+    int fds[3] = {-1, -1, -1};
+    int sock, i;
+
+    sock = accept4(lsock, NULL, NULL, SOCK_CLOEXEC);
+    if (sock < 0)
+        return;
+    for(i = 0; i < MAX_CLIENTS && cl == NULL; i++)
+        if (clients[i].sock < 0)
+            cl = &clients[i];
+    if (cl == NULL)
+        goto err;
+    fds[0] = memfd_create("romulus_offload", MFD_CLOEXEC);
+    fds[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    fds[2] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fds[0] < 0 || fds[1] < 0 || fds[2] < 0 ||
+        ftruncate(fds[0], sizeof(offload_region)))
+        goto err;
+    cl->region = mmap(NULL, sizeof(offload_region), PROT_READ | PROT_WRITE,
+        MAP_SHARED, fds[0], 0);
+    if (cl->region == MAP_FAILED)
+        goto err;
+    cl->region->magic = OFFLOAD_MAGIC;
+    cl->region->nslots = OFFLOAD_SLOTS;
+    if (send_fds(sock, fds)) {
+        munmap(cl->region, sizeof(offload_region));
+        goto err;
+    }
+    close(fds[0]);
+    cl->sock = sock;
+    cl->sq_efd = fds[1];
+    cl->cq_efd = fds[2];
+    cl->touched = 0;
+    ev.events = EPOLLIN;
+    ev.data.u64 = EV_SOCK(cl - clients);
+    epoll_ctl(epfd, EPOLL_CTL_ADD, sock, &ev);
+    ev.data.u64 = EV_SQ(cl - clients);
+    epoll_ctl(epfd, EPOLL_CTL_ADD, cl->sq_efd, &ev);
+    return;
+err:
+    for(i = 0; i < 3; i++)
+        if (fds[i] >= 0)
+            close(fds[i]);
+    close(sock);
+}
+
+static void complete(job *j, int32_t status, uint32_t outlen)
+{
+    j->s->status = status;
+    j->s->outlen = outlen;
+    // cannot fail since the ring is as large as the slot pool
+    offload_ring_push(&j->cl->region->cq, j->slot);
+    j->cl->touched = 1;
+}
+
+/**
+ * Moves the submitted jobs of all clients into 'jobs', rejecting malformed
+ * ones right away. Returns the number of jobs appended.
+ */
+static size_t collect(job *jobs, size_t njobs, size_t max)
+{
+    size_t n = 0;
+    uint32_t i, alg;
+    size_t b;
+    job *j;
+    for(int c = 0; c < MAX_CLIENTS; c++) {
+        client *cl = &clients[c];
+        if (cl->sock < 0)
+            continue;
+        while (njobs + n < max && !offload_ring_pop(&cl->region->sq, &i)) {
+            j = &jobs[njobs + n];
+            j->cl = cl;
+            j->slot = i % OFFLOAD_SLOTS;
+            j->s = &cl->region->slots[j->slot];
+            j->op = __atomic_load_n(&j->s->op, __ATOMIC_RELAXED);
+            alg = __atomic_load_n(&j->s->alg, __ATOMIC_RELAXED);
+            j->key_id = __atomic_load_n(&j->s->key_id, __ATOMIC_RELAXED);
+            j->adlen = __atomic_load_n(&j->s->adlen, __ATOMIC_RELAXED);
+            j->inlen = __atomic_load_n(&j->s->inlen, __ATOMIC_RELAXED);
+            for(b = 0; b < sizeof(backends)/sizeof(backends[0]); b++)
+                if (backends[b].alg == alg)
+                    break;
+            if (j->op > OFFLOAD_DECRYPT || j->adlen > OFFLOAD_MAXDATA ||
+                j->adlen + j->inlen > OFFLOAD_MAXDATA +
+                    (j->op == OFFLOAD_DECRYPT ? OFFLOAD_TAGBYTES : 0))
+                complete(j, OFFLOAD_EINVAL, 0);
+            else if (b == sizeof(backends)/sizeof(backends[0]))
+                complete(j, OFFLOAD_ENOTSUP, 0);
+            else if (j->key_id >= nkeys)
+                complete(j, OFFLOAD_ENOKEY, 0);
+            else
+                n++;
+        }
+    }
+    return n;
+}
+
+/**
+ * Processes all collected jobs with the batch API, encryptions and
+ * decryptions being dispatched separately. Jobs are processed in place.
+ */
+static void process(job *jobs, size_t njobs)
+{
+    static mask_c_uint32_t *cs[MAX_BATCH];
+    static const mask_m_uint32_t *ms[MAX_BATCH];
+    static const mask_ad_uint32_t *ads[MAX_BATCH];
+    static const mask_npub_uint32_t *npubs[MAX_BATCH];
+    static const romulust_key_ctx *ctx[MAX_BATCH];
+    static mask_npub_uint32_t npub[MAX_BATCH][4];
+    static unsigned long long adlen[MAX_BATCH], inlen[MAX_BATCH];
+    static unsigned long long outlen[MAX_BATCH];
+    static int res[MAX_BATCH];
+    static job *sel[MAX_BATCH];
+    size_t i, n;
+    uint32_t op;
+
+    for(op = OFFLOAD_ENCRYPT; op <= OFFLOAD_DECRYPT; op++) {
+        n = 0;
+        for(i = 0; i < njobs; i++) {
+            job *j = &jobs[i];
+            if (j->op != op)
+                continue;
+            sel[n] = j;
+            // the public nonce is split into shares as required by the API
+            split_shares((mask_key_uint32_t *)npub[n], j->s->npub);
+            npubs[n] = npub[n];
+            ads[n] = (const mask_ad_uint32_t *)j->s->data;
+            cs[n] = (mask_c_uint32_t *)(j->s->data + j->adlen);
+            ms[n] = (const mask_m_uint32_t *)cs[n];
+            adlen[n] = j->adlen;
+            inlen[n] = j->inlen;
+            ctx[n] = keys + j->key_id;
+            n++;
+        }
+        if (n == 0)
+            continue;
+        // single backend for now: all jobs go through Romulus-T
+        if (op == OFFLOAD_ENCRYPT)
+            backends[0].encrypt(cs, outlen, ms, inlen, ads, adlen, npubs, ctx,
+                n);
+        else
+            backends[0].decrypt((mask_m_uint32_t *const *)cs, outlen,
+                (const mask_c_uint32_t *const *)ms, inlen, ads, adlen, npubs,
+                ctx, res, n);
+        for(i = 0; i < n; i++) {
+            if (op == OFFLOAD_DECRYPT && res[i])
+                complete(sel[i], OFFLOAD_EVERIFY, 0);
+            else
+                complete(sel[i], OFFLOAD_OK, (uint32_t)outlen[i]);
+        }
+    }
+}
+
+/**
+ * Returns 1 if a client has queued jobs which have not been collected yet.
+ */
+static int pending(void)
+{
+    for(int c = 0; c < MAX_CLIENTS; c++)
+        if (clients[c].sock >= 0 && clients[c].region->sq.head !=
+            __atomic_load_n(&clients[c].region->sq.tail, __ATOMIC_ACQUIRE))
+            return 1;
+    return 0;
+}
+
+static long long elapsed_us(const struct timespec *t0)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (t.tv_sec - t0->tv_sec)*1000000LL + (t.tv_nsec - t0->tv_nsec)/1000;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+int main(int argc, char *argv[])
+{
+    static job jobs[MAX_BATCH];
+    struct sockaddr_un addr;
+    struct epoll_event ev, evs[2*MAX_CLIENTS + 1];
+    struct timespec t0;
+    const char *sock_path = NULL, *key_path = NULL;
+    size_t max_batch = 64, njobs;
+    long linger = 0;
+    uint64_t cnt, one = 1;
+    int opt, epfd, lsock, n, i;
+
+    while ((opt = getopt(argc, argv, "s:k:b:l:")) != -1) {
+        switch (opt) {
+        case 's': sock_path = optarg; break;
+        case 'k': key_path = optarg; break;
+        case 'b': max_batch = strtoul(optarg, NULL, 0); break;
+        case 'l': linger = strtol(optarg, NULL, 0); break;
+        default: sock_path = NULL; key_path = NULL; optind = argc; break;
+        }
+    }
+    if (sock_path == NULL || key_path == NULL || max_batch == 0 ||
+        max_batch > MAX_BATCH || strlen(sock_path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "usage: %s -s <socket> -k <key file> "
+            "[-b <max batch>] [-l <linger us>]\n", argv[0]);
+        return 1;
+    }
+    if (load_keys(key_path)) {
+        fprintf(stderr, "cannot load keys from %s\n", key_path);
+        return 1;
+    }
+    for(i = 0; i < MAX_CLIENTS; i++)
+        clients[i].sock = -1;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, sock_path);
+    unlink(sock_path);
+    lsock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (lsock < 0 || bind(lsock, (struct sockaddr *)&addr, sizeof(addr)) ||
+        listen(lsock, 16)) {
+        perror("socket");
+        return 1;
+    }
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    ev.events = EPOLLIN;
+    ev.data.u64 = EV_LISTEN;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, lsock, &ev);
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    while (!stop) {
+        // do not sleep if jobs were queued while processing the last batch
+        n = epoll_wait(epfd, evs, sizeof(evs)/sizeof(evs[0]),
+            pending() ? 0 : -1);
+        if (n < 0 && errno != EINTR)
+            break;
+        for(i = 0; i < n; i++) {
+            uint64_t tag = evs[i].data.u64;
+            if (tag == EV_LISTEN) {
+                accept_client(epfd, lsock);
+            } else if ((tag & 1) == 0) {
+                // any data or hang-up on the control socket ends the session
+                if (clients[tag/2].sock >= 0)
+                    drop_client(epfd, &clients[tag/2]);
+            } else if (clients[tag/2].sock >= 0) {
+                // reset the submission doorbell, rings are drained below
+                if (read(clients[tag/2].sq_efd, &cnt, sizeof(cnt)) < 0)
+                    continue;
+            }
+        }
+        // coalesce jobs from all clients, waiting up to 'linger' us for more
+        // submissions if the batch is not full
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        njobs = collect(jobs, 0, max_batch);
+        while (njobs > 0 && njobs < max_batch && elapsed_us(&t0) < linger)
+            njobs += collect(jobs, njobs, max_batch);
+        if (njobs > 0)
+            process(jobs, njobs);
+        for(i = 0; i < MAX_CLIENTS; i++) {
+            if (clients[i].sock >= 0 && clients[i].touched) {
+                clients[i].touched = 0;
+                if (write(clients[i].cq_efd, &one, sizeof(one)) < 0)
+                    continue;
+            }
+        }
+    }
+    for(i = 0; i < MAX_CLIENTS; i++)
+        if (clients[i].sock >= 0)
+            drop_client(epfd, &clients[i]);
+    explicit_bzero(keys, nkeys*sizeof(romulust_key_ctx));
+    free(keys);
+    close(lsock);
+    unlink(sock_path);
+    return 0;
+}
@@ -0,0 +1,593 @@
+/**
+ * NUMA-aware worker pool for the batch API (Linux only, see 'romulus_pool.h').
+ *
+ * Each node has a queue (singly-linked list of jobs) protected by a mutex, on
+ * which its idle workers sleep. A worker takes up to ROMULUST_BATCH jobs of
+ * the same operation at once so that they go through the batch API together,
+ * first from its own queue and then from the queues of the other nodes.
+ *
+ * Lost wake-ups are avoided with a pool-wide epoch incremented after each
+ * submission: a worker only goes to sleep if no job was submitted since it
+ * started scanning the queues. A submission wakes an idle worker of the
+ * target node, or of another node if there is none.
+ *
+ * libnuma is not required: node binding and lookup rely on the 'mbind' and
+ * 'get_mempolicy' system calls, and the topology is read from sysfs.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "romulus_pool.h"
+
+#define MPOL_PREFERRED      1
+#define MPOL_F_NODE         (1 << 0)
+#define MPOL_F_ADDR         (1 << 1)
+
+#define POOL_MAX_REGIONS    256
+
+// key expansion: smallest chunk, and chunks per worker and per batch of jobs
+#define EXPAND_MINKEYS      64
+#define EXPAND_SPREAD       (4*ROMULUST_BATCH)
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    romulus_pool_job *head;
+    romulus_pool_job *tail;
+    int nidle;
+    int id;                                 // sysfs node id, -1 if emulated
+    cpu_set_t cpus;
+} __attribute__((aligned(64))) pool_node;
+
+//Buffers allocated on emulated nodes
+typedef struct {
+    uintptr_t start;
+    uintptr_t end;
+    int node;
+} pool_region;
+
+//Jobs submitted by a single call to 'romulus_pool_run'
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    size_t pending;
+    int ret;
+} pool_group;
+
+typedef struct {
+    romulus_pool *p;
+    int node;
+} pool_worker;
+
+struct romulus_pool {
+    int nnodes;
+    int nqueues;                            // 1 if POOL_NOAFFINITY
+    int nworkers;
+    int emulated;
+    int flags;
+    int stop;
+    uint64_t epoch;
+    pthread_t *threads;
+    pool_worker *workers;
+    pthread_mutex_t rlock;
+    int nregions;
+    pool_region regions[POOL_MAX_REGIONS];
+    pool_node node[POOL_MAX_NODES];
+};
+
+/**
+ * Parses a sysfs CPU list such as "0-3,8-11" into 'set'.
+ */
+static void parse_cpulist(cpu_set_t *set, const char *s)
+{
+    char *end;
+    long a, b;
+    CPU_ZERO(set);
+    while (*s) {
+        a = strtol(s, &end, 10);
+        if (end == s)
+            break;
+        b = a;
+        if (*end == '-')
+            b = strtol(end + 1, &end, 10);
+        for(; a <= b && a < CPU_SETSIZE; a++)
+            CPU_SET(a, set);
+        s = (*end == ',') ? end + 1 : end;
+    }
+}
+
+static int read_line(const char *path, char *buf, int len)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+        return -1;
+    if (fgets(buf, len, f) == NULL)
+        buf[0] = '\0';
+    fclose(f);
+    return 0;
+}
+
+/**
+ * Reads the nodes with CPUs available to the process, or splits these CPUs
+ * into 'emulate' nodes. Falls back to a single node if sysfs is unavailable.
+ */
+static void read_topology(romulus_pool *p, int emulate)
+{
+    char path[64], buf[4096];
+    cpu_set_t avail, set;
+    int i, k, ncpus, cpu[CPU_SETSIZE];
+
+    sched_getaffinity(0, sizeof(avail), &avail);
+    p->nnodes = 0;
+    if (emulate > 0) {
+        for(i = 0, ncpus = 0; i < CPU_SETSIZE; i++)
+            if (CPU_ISSET(i, &avail))
+                cpu[ncpus++] = i;
+        p->emulated = 1;
+        p->nnodes = emulate > POOL_MAX_NODES ? POOL_MAX_NODES : emulate;
+        for(k = 0; k < p->nnodes; k++) {
+            CPU_ZERO(&p->node[k].cpus);
+            for(i = k*ncpus/p->nnodes; i < (k+1)*ncpus/p->nnodes; i++)
+                CPU_SET(cpu[i], &p->node[k].cpus);
+            // fewer CPUs than nodes: nodes share CPUs
+            if (CPU_COUNT(&p->node[k].cpus) == 0)
+                CPU_SET(cpu[k % ncpus], &p->node[k].cpus);
+            p->node[k].id = -1;
+        }
+        return;
+    }
+    for(i = 0; i < 1024 && p->nnodes < POOL_MAX_NODES; i++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+            i);
+        if (read_line(path, buf, sizeof(buf)))
+            continue;
+        parse_cpulist(&set, buf);
+        CPU_AND(&set, &set, &avail);
+        // memory-only nodes get no workers
+        if (CPU_COUNT(&set) == 0)
+            continue;
+        p->node[p->nnodes].cpus = set;
+        p->node[p->nnodes++].id = i;
+    }
+    if (p->nnodes == 0) {
+        p->nnodes = 1;
+        p->node[0].cpus = avail;
+        p->node[0].id = -1;
+    }
+}
+
+/**
+ * Returns the index of the node running the calling thread.
+ */
+static int current_node(const romulus_pool *p)
+{
+    int k, cpu = sched_getcpu();
+    for(k = 0; cpu >= 0 && k < p->nnodes; k++)
+        if (CPU_ISSET(cpu, &p->node[k].cpus))
+            return k;
+    return 0;
+}
+
+/**
+ * Returns the index of the node holding 'addr'.
+ */
+static int node_of(romulus_pool *p, const void *addr)
+{
+    int k, id = -1;
+    uintptr_t a = (uintptr_t)addr;
+    if (p->nqueues == 1)
+        return 0;
+    if (p->emulated) {
+        pthread_mutex_lock(&p->rlock);
+        for(k = 0; k < p->nregions; k++)
+            if (a >= p->regions[k].start && a < p->regions[k].end) {
+                id = p->regions[k].node;
+                break;
+            }
+        pthread_mutex_unlock(&p->rlock);
+        return (id >= 0) ? id : current_node(p);
+    }
+    if (syscall(SYS_get_mempolicy, &id, NULL, 0, addr,
+            MPOL_F_NODE | MPOL_F_ADDR) == 0)
+        for(k = 0; k < p->nnodes; k++)
+            if (p->node[k].id == id)
+                return k;
+    return current_node(p);
+}
+
+void *romulus_pool_alloc(romulus_pool *p, int node, size_t len)
+{
+    unsigned long mask;
+    void *ptr = mmap(NULL, len, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        return NULL;
+    if (p->nqueues == 1 || node < 0 || node >= p->nnodes)
+        return ptr;
+    if (p->emulated) {
+        pthread_mutex_lock(&p->rlock);
+        if (p->nregions < POOL_MAX_REGIONS) {
+            p->regions[p->nregions].start = (uintptr_t)ptr;
+            p->regions[p->nregions].end = (uintptr_t)ptr + len;
+            p->regions[p->nregions++].node = node;
+        }
+        pthread_mutex_unlock(&p->rlock);
+    } else if (p->node[node].id < 8*(int)sizeof(mask)) {
+        // pages are not touched yet, so that they are all placed on the node
+        mask = 1UL << p->node[node].id;
+        syscall(SYS_mbind, ptr, len, MPOL_PREFERRED, &mask, 8*sizeof(mask), 0);
+    }
+    return ptr;
+}
+
+void romulus_pool_free(romulus_pool *p, void *ptr, size_t len)
+{
+    int k;
+    if (ptr == NULL)
+        return;
+    if (p->emulated) {
+        pthread_mutex_lock(&p->rlock);
+        for(k = 0; k < p->nregions; k++)
+            if (p->regions[k].start == (uintptr_t)ptr) {
+                p->regions[k] = p->regions[--p->nregions];
+                break;
+            }
+        pthread_mutex_unlock(&p->rlock);
+    }
+    munmap(ptr, len);
+}
+
+/**
+ * Removes up to ROMULUST_BATCH jobs of the same operation from a queue.
+ */
+static int take(pool_node *nd, romulus_pool_job *batch[ROMULUST_BATCH])
+{
+    int n = 0;
+    romulus_pool_job *j, *next, *prev = NULL;
+    pthread_mutex_lock(&nd->lock);
+    for(j = nd->head; j != NULL && n < ROMULUST_BATCH; j = next) {
+        next = j->next;
+        if (n > 0 && j->op != batch[0]->op) {
+            prev = j;
+            continue;
+        }
+        if (prev == NULL)
+            nd->head = next;
+        else
+            prev->next = next;
+        if (nd->tail == j)
+            nd->tail = prev;
+        batch[n++] = j;
+    }
+    pthread_mutex_unlock(&nd->lock);
+    return n;
+}
+
+/**
+ * The job may be released by its callback, so that it is not accessed after.
+ */
+static void complete(romulus_pool_job *j)
+{
+    pool_group *g = j->grp;
+    int failed = (j->op == POOL_DECRYPT && j->res);
+    if (j->done != NULL)
+        j->done(j, j->arg);
+    if (g == NULL)
+        return;
+    pthread_mutex_lock(&g->lock);
+    if (failed)
+        g->ret = -1;
+    if (--g->pending == 0)
+        pthread_cond_signal(&g->cond);
+    pthread_mutex_unlock(&g->lock);
+}
+
+/**
+ * Processes jobs of the same operation through the batch API. All arrays live
+ * on the stack of the worker, hence on its node.
+ */
+static void process(romulus_pool_job *batch[], int n)
+{
+    int i;
+    mask_c_uint32_t *cs[ROMULUST_BATCH];
+    const mask_m_uint32_t *ms[ROMULUST_BATCH];
+    const mask_ad_uint32_t *ads[ROMULUST_BATCH];
+    const mask_npub_uint32_t *npubs[ROMULUST_BATCH];
+    const romulust_key_ctx *ctx[ROMULUST_BATCH];
+    unsigned long long adlen[ROMULUST_BATCH], inlen[ROMULUST_BATCH];
+    unsigned long long outlen[ROMULUST_BATCH];
+    int res[ROMULUST_BATCH];
+
+    if (batch[0]->op == POOL_CALL) {
+        for(i = 0; i < n; i++)
+            complete(batch[i]);
+        return;
+    }
+    for(i = 0; i < n; i++) {
+        cs[i] = batch[i]->out;
+        ms[i] = batch[i]->in;
+        ads[i] = batch[i]->ad;
+        npubs[i] = batch[i]->npub;
+        ctx[i] = batch[i]->ctx;
+        adlen[i] = batch[i]->adlen;
+        inlen[i] = batch[i]->inlen;
+        res[i] = 0;
+    }
+    if (batch[0]->op == POOL_ENCRYPT)
+        crypto_aead_encrypt_shared_batch(cs, outlen, ms, inlen, ads, adlen,
+            npubs, ctx, n);
+    else
+        crypto_aead_decrypt_shared_batch((mask_m_uint32_t *const *)cs, outlen,
+            (const mask_c_uint32_t *const *)ms, inlen, ads, adlen, npubs, ctx,
+            res, n);
+    for(i = 0; i < n; i++) {
+        batch[i]->outlen = outlen[i];
+        batch[i]->res = res[i];
+        complete(batch[i]);
+    }
+}
+
+static void *worker(void *arg)
+{
+    pool_worker *w = arg;
+    romulus_pool *p = w->p;
+    pool_node *nd = &p->node[w->node];
+    romulus_pool_job *batch[ROMULUST_BATCH];
+    uint64_t epoch;
+    int k, n, stop;
+
+    for(;;) {
+        stop = __atomic_load_n(&p->stop, __ATOMIC_ACQUIRE);
+        epoch = __atomic_load_n(&p->epoch, __ATOMIC_ACQUIRE);
+        n = take(nd, batch);
+        // steal from the other nodes only when idle
+        for(k = 1; n == 0 && k < p->nqueues; k++)
+            n = take(&p->node[(w->node + k) % p->nqueues], batch);
+        if (n > 0) {
+            process(batch, n);
+            continue;
+        }
+        if (stop)
+            break;
+        pthread_mutex_lock(&nd->lock);
+        nd->nidle++;
+        if (nd->head == NULL && !__atomic_load_n(&p->stop, __ATOMIC_ACQUIRE) &&
+            epoch == __atomic_load_n(&p->epoch, __ATOMIC_ACQUIRE))
+            pthread_cond_wait(&nd->cond, &nd->lock);
+        nd->nidle--;
+        pthread_mutex_unlock(&nd->lock);
+    }
+    return NULL;
+}
+
+romulus_pool *romulus_pool_create(const romulus_pool_cfg *cfg)
+{
+    romulus_pool *p;
+    pthread_attr_t attr;
+    int k, i, nw, per_node;
+
+    p = calloc(1, sizeof(romulus_pool));
+    if (p == NULL)
+        return NULL;
+    p->flags = cfg->flags;
+    read_topology(p, cfg->emulate_nodes);
+    p->nqueues = (p->flags & POOL_NOAFFINITY) ? 1 : p->nnodes;
+    pthread_mutex_init(&p->rlock, NULL);
+    for(k = 0; k < p->nnodes; k++) {
+        pthread_mutex_init(&p->node[k].lock, NULL);
+        pthread_cond_init(&p->node[k].cond, NULL);
+    }
+    for(k = 0, nw = 0; k < p->nnodes; k++)
+        nw += cfg->workers_per_node > 0 ? cfg->workers_per_node :
+            CPU_COUNT(&p->node[k].cpus);
+    p->threads = calloc(nw, sizeof(pthread_t));
+    p->workers = calloc(nw, sizeof(pool_worker));
+    if (p->threads == NULL || p->workers == NULL) {
+        romulus_pool_destroy(p);
+        return NULL;
+    }
+    for(k = 0; k < p->nnodes; k++) {
+        per_node = cfg->workers_per_node > 0 ? cfg->workers_per_node :
+            CPU_COUNT(&p->node[k].cpus);
+        for(i = 0; i < per_node; i++) {
+            // workers start on their node so that their stack is local
+            pthread_attr_init(&attr);
+            if (!(p->flags & POOL_NOAFFINITY))
+                pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t),
+                    &p->node[k].cpus);
+            p->workers[p->nworkers].p = p;
+            p->workers[p->nworkers].node = (p->nqueues == 1) ? 0 : k;
+            if (pthread_create(&p->threads[p->nworkers], &attr, worker,
+                    &p->workers[p->nworkers]) == 0)
+                p->nworkers++;
+            pthread_attr_destroy(&attr);
+        }
+    }
+    if (p->nworkers == 0) {
+        romulus_pool_destroy(p);
+        return NULL;
+    }
+    return p;
+}
+
+void romulus_pool_destroy(romulus_pool *p)
+{
+    int k;
+    if (p == NULL)
+        return;
+    __atomic_store_n(&p->stop, 1, __ATOMIC_RELEASE);
+    for(k = 0; k < p->nqueues; k++) {
+        pthread_mutex_lock(&p->node[k].lock);
+        pthread_cond_broadcast(&p->node[k].cond);
+        pthread_mutex_unlock(&p->node[k].lock);
+    }
+    for(k = 0; k < p->nworkers; k++)
+        pthread_join(p->threads[k], NULL);
+    for(k = 0; k < p->nnodes; k++) {
+        pthread_mutex_destroy(&p->node[k].lock);
+        pthread_cond_destroy(&p->node[k].cond);
+    }
+    pthread_mutex_destroy(&p->rlock);
+    free(p->threads);
+    free(p->workers);
+    free(p);
+}
+
+int romulus_pool_nodes(const romulus_pool *p)
+{
+    return p->nnodes;
+}
+
+int romulus_pool_workers(const romulus_pool *p)
+{
+    return p->nworkers;
+}
+
+/**
+ * Appends the jobs to the queues of their nodes, then wakes idle workers of
+ * these nodes or, if there is none, of another node.
+ */
+static void submit(romulus_pool *p, romulus_pool_job *const jobs[], size_t n,
+    pool_group *g)
+{
+    size_t i;
+    int k, q, nidle;
+    size_t cnt[POOL_MAX_NODES] = {0};
+    romulus_pool_job *head[POOL_MAX_NODES], *tail[POOL_MAX_NODES];
+
+    for(i = 0; i < n; i++) {
+        if (p->nqueues == 1)
+            q = 0;
+        else if (jobs[i]->node >= 0)
+            q = jobs[i]->node % p->nqueues;
+        else
+            q = node_of(p, jobs[i]->in);
+        jobs[i]->next = NULL;
+        jobs[i]->grp = g;
+        if (cnt[q]++ == 0)
+            head[q] = jobs[i];
+        else
+            tail[q]->next = jobs[i];
+        tail[q] = jobs[i];
+    }
+    for(q = 0; q < p->nqueues; q++) {
+        if (cnt[q] == 0)
+            continue;
+        pthread_mutex_lock(&p->node[q].lock);
+        if (p->node[q].head == NULL)
+            p->node[q].head = head[q];
+        else
+            p->node[q].tail->next = head[q];
+        p->node[q].tail = tail[q];
+        pthread_mutex_unlock(&p->node[q].lock);
+    }
+    __atomic_add_fetch(&p->epoch, 1, __ATOMIC_ACQ_REL);
+    for(q = 0; q < p->nqueues; q++) {
+        if (cnt[q] == 0)
+            continue;
+        pthread_mutex_lock(&p->node[q].lock);
+        nidle = p->node[q].nidle;
+        if (nidle > 0 && cnt[q] > ROMULUST_BATCH)
+            pthread_cond_broadcast(&p->node[q].cond);
+        else if (nidle > 0)
+            pthread_cond_signal(&p->node[q].cond);
+        pthread_mutex_unlock(&p->node[q].lock);
+        for(k = 1; nidle == 0 && k < p->nqueues; k++) {
+            pool_node *nd = &p->node[(q + k) % p->nqueues];
+            pthread_mutex_lock(&nd->lock);
+            nidle = nd->nidle;
+            if (nidle > 0)
+                pthread_cond_signal(&nd->cond);
+            pthread_mutex_unlock(&nd->lock);
+        }
+    }
+}
+
+void romulus_pool_submit(romulus_pool *p, romulus_pool_job *const jobs[],
+    size_t n)
+{
+    submit(p, jobs, n, NULL);
+}
+
+int romulus_pool_run(romulus_pool *p, romulus_pool_job *const jobs[],
+    size_t n)
+{
+    pool_group g;
+    if (n == 0)
+        return 0;
+    pthread_mutex_init(&g.lock, NULL);
+    pthread_cond_init(&g.cond, NULL);
+    g.pending = n;
+    g.ret = 0;
+    submit(p, jobs, n, &g);
+    pthread_mutex_lock(&g.lock);
+    while (g.pending > 0)
+        pthread_cond_wait(&g.cond, &g.lock);
+    pthread_mutex_unlock(&g.lock);
+    pthread_mutex_destroy(&g.lock);
+    pthread_cond_destroy(&g.cond);
+    return g.ret;
+}
+
+typedef struct {
+    romulus_pool_job job;
+    romulust_key_ctx *ctx;
+    const mask_key_uint32_t *ks;
+    size_t n;
+} expand_job;
+
+static void expand_chunk(romulus_pool_job *j, void *arg)
+{
+    expand_job *e = arg;
+    (void)j;
+    romulus_expand_keys(e->ctx, e->ks, e->n);
+}
+
+/**
+ * Since a worker takes up to ROMULUST_BATCH jobs at once, keys are split into
+ * EXPAND_SPREAD chunks per worker so that all of them get some.
+ */
+int romulus_pool_expand_keys(romulus_pool *p, romulust_key_ctx *ctx,
+    const mask_key_uint32_t *ks, size_t n)
+{
+    size_t i, chunk, njobs;
+    expand_job *e;
+    romulus_pool_job **jobs;
+    if (n == 0)
+        return 0;
+    chunk = (n + EXPAND_SPREAD*p->nworkers - 1) / (EXPAND_SPREAD*p->nworkers);
+    chunk = (chunk < EXPAND_MINKEYS) ? EXPAND_MINKEYS : (chunk + 7) & ~(size_t)7;
+    njobs = (n + chunk - 1) / chunk;
+    e = calloc(njobs, sizeof(expand_job));
+    jobs = malloc(njobs * sizeof(romulus_pool_job *));
+    if (e == NULL || jobs == NULL) {
+        free(e);
+        free(jobs);
+        return -1;
+    }
+    for(i = 0; i < njobs; i++) {
+        e[i].ctx = ctx + i*chunk;
+        e[i].ks = ks + 4*i*chunk;
+        e[i].n = (n - i*chunk < chunk) ? n - i*chunk : chunk;
+        e[i].job.op = POOL_CALL;
+        e[i].job.node = POOL_ANY_NODE;
+        e[i].job.in = (const mask_m_uint32_t *)e[i].ctx;  // node lookup only
+        e[i].job.done = expand_chunk;
+        e[i].job.arg = &e[i];
+        jobs[i] = &e[i].job;
+    }
+    romulus_pool_run(p, jobs, njobs);
+    free(e);
+    free(jobs);
+    return 0;
+}
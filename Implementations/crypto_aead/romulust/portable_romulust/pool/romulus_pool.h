@@ -0,0 +1,92 @@
+#ifndef ROMULUS_POOL_H_
+#define ROMULUS_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "crypto_aead_shared.h"
+
+//NUMA-aware worker pool on top of 'crypto_aead_{en,de}crypt_shared_batch'
+//(Linux only).
+//
+//Workers are pinned to the CPUs of their node and fed from a per-node queue.
+//Each job is routed to the node holding its input buffer, and a worker only
+//takes jobs from other nodes once its own queue is empty. Key contexts and
+//message buffers can be allocated on a given node through
+//'romulus_pool_alloc', while the scratch of the batch API (states, round
+//tweakeys) lives on the stack of workers, hence on their node.
+//
+//Nodes can be emulated on single-node machines (cfg.emulate_nodes > 0): CPUs
+//are then split evenly between nodes, and buffers are attributed to the node
+//they were allocated for by 'romulus_pool_alloc' rather than by the kernel.
+#define POOL_ENCRYPT        0
+#define POOL_DECRYPT        1
+#define POOL_CALL           2   // no AEAD operation, only 'done' is called
+
+#define POOL_MAX_NODES      64
+#define POOL_ANY_NODE       (-1)
+
+//Flags
+#define POOL_NOAFFINITY     1   // single queue, unpinned workers, no binding
+
+typedef struct {
+    int workers_per_node;                   // 0: one per CPU of the node
+    int emulate_nodes;                      // 0: actual topology
+    int flags;
+} romulus_pool_cfg;
+
+typedef struct romulus_pool_job {
+    uint32_t op;
+    int node;                               // POOL_ANY_NODE: node of 'in'
+    mask_c_uint32_t *out;                   // may be equal to 'in'
+    unsigned long long outlen;              // set by the pool
+    const mask_m_uint32_t *in;
+    unsigned long long inlen;
+    const mask_ad_uint32_t *ad;
+    unsigned long long adlen;
+    const mask_npub_uint32_t *npub;         // 4 words of NUM_SHARES_NPUB shares
+    const romulust_key_ctx *ctx;
+    int res;                                // set by the pool, non-zero if
+                                            // tag verification failed
+    void (*done)(struct romulus_pool_job *j, void *arg);   // may be NULL
+    void *arg;
+    struct romulus_pool_job *next;          // internal
+    void *grp;                              // internal
+} romulus_pool_job;
+
+typedef struct romulus_pool romulus_pool;
+
+romulus_pool *romulus_pool_create(const romulus_pool_cfg *cfg);
+
+//Waits for queued jobs to complete and stops the workers
+void romulus_pool_destroy(romulus_pool *p);
+
+int romulus_pool_nodes(const romulus_pool *p);
+
+int romulus_pool_workers(const romulus_pool *p);
+
+//Allocates 'len' bytes (page-aligned, zeroed) on node 'node', to be released
+//with 'romulus_pool_free'.
+void *romulus_pool_alloc(romulus_pool *p, int node, size_t len);
+
+void romulus_pool_free(romulus_pool *p, void *ptr, size_t len);
+
+//Queues 'n' jobs without waiting. The 'done' callback of each job is called
+//from a worker thread once it completes. Jobs and their buffers must remain
+//valid until then.
+void romulus_pool_submit(romulus_pool *p, romulus_pool_job *const jobs[],
+    size_t n);
+
+//Queues 'n' jobs and waits for all of them to complete. Returns a non-zero
+//value if tag verification failed for at least one decryption.
+int romulus_pool_run(romulus_pool *p, romulus_pool_job *const jobs[],
+    size_t n);
+
+//Expands the contexts of 'n' keys (see 'romulus_expand_keys') on the workers
+//of the pool, by chunks of consecutive keys which are processed on the node
+//holding their contexts (e.g. as allocated by 'romulus_pool_alloc'). Waits for
+//all of them to complete. Returns -1 if memory could not be allocated, 0
+//otherwise.
+int romulus_pool_expand_keys(romulus_pool *p, romulust_key_ctx *ctx,
+    const mask_key_uint32_t *ks, size_t n);
+
+#endif  // ROMULUS_POOL_H_
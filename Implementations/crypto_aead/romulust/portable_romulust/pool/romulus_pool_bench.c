@@ -0,0 +1,253 @@
+/**
+ * Throughput of the worker pool (see 'romulus_pool.h') with and without NUMA
+ * affinity, for an increasing number of workers per node.
+ *
+ * With affinity, each node encrypts messages stored on it under keys expanded
+ * on it, and workers are pinned. Without, the same jobs go through a single
+ * queue served by unpinned workers, all buffers being allocated by the main
+ * thread. On single-node machines, '-e' emulates a topology: the scheduling
+ * and queueing behaviour is exercised but no remote access penalty can show.
+ *
+ * With '-k', the time to expand the contexts of that many keys (e.g. at service
+ * start) is reported as well, on a single thread ('romulus_expand_keys') and
+ * through the pool ('romulus_pool_expand_keys').
+ *
+ * Build from the 'portable_romulust' directory:
+ *   cc -O2 -o romulus_pool_bench pool/romulus_pool_bench.c pool/romulus_pool.c \
+ *      bench/bench.c aead.c romulus_t.c skinny128_*.c -I. -lpthread
+ * Usage:
+ *   romulus_pool_bench [-e <emulated nodes>] [-w <max workers per node>]
+ *                      [-s <message bytes>] [-j <jobs per node>]
+ *                      [-r <rounds>] [-k <keys>] [-f text|csv|json]
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "randombytes.h"
+#include "bench/bench.h"
+#include "romulus_pool.h"
+
+#define KEYS_PER_NODE   64
+
+typedef struct {
+    uint8_t *buf;                           // messages, then ciphertexts
+    romulust_key_ctx *keys;
+    mask_npub_uint32_t (*npub)[4];
+    romulus_pool_job *jobs;
+} node_data;
+
+/**
+ * Encrypts 'njobs' messages per node 'rounds' times, checks that the last
+ * ciphertexts decrypt correctly and returns the throughput in MB/s.
+ */
+static double run(const romulus_pool_cfg *cfg, size_t mlen, size_t njobs,
+    int rounds)
+{
+    romulus_pool *p;
+    node_data nd[POOL_MAX_NODES];
+    romulus_pool_job **all;
+    mask_key_uint32_t ks[4*KEYS_PER_NODE];
+    size_t i, stride = (mlen + TAGBYTES + 63) & ~(size_t)63;
+    int k, r, nnodes, ok = 1;
+    double t;
+
+    p = romulus_pool_create(cfg);
+    if (p == NULL)
+        return 0;
+    nnodes = romulus_pool_nodes(p);
+    all = malloc(nnodes*njobs*sizeof(romulus_pool_job *));
+    for(k = 0; k < nnodes; k++) {
+        nd[k].buf = romulus_pool_alloc(p, k, njobs*stride);
+        nd[k].keys = romulus_pool_alloc(p, k,
+            KEYS_PER_NODE*sizeof(romulust_key_ctx));
+        nd[k].npub = romulus_pool_alloc(p, k, njobs*sizeof(*nd[k].npub));
+        nd[k].jobs = romulus_pool_alloc(p, k, njobs*sizeof(romulus_pool_job));
+        // first touch from the main thread (no effect on bound buffers)
+        randombytes(nd[k].buf, njobs*stride);
+        randombytes((uint8_t *)ks, sizeof(ks));
+        romulus_expand_keys(nd[k].keys, ks, KEYS_PER_NODE);
+        randombytes((uint8_t *)nd[k].npub, njobs*sizeof(*nd[k].npub));
+        for(i = 0; i < njobs; i++) {
+            romulus_pool_job *j = &nd[k].jobs[i];
+            j->node = POOL_ANY_NODE;
+            j->in = (const mask_m_uint32_t *)(nd[k].buf + i*stride);
+            j->out = (mask_c_uint32_t *)(nd[k].buf + i*stride);
+            j->ad = (const mask_ad_uint32_t *)nd[k].npub[i];
+            j->npub = nd[k].npub[i];
+            j->ctx = &nd[k].keys[i % KEYS_PER_NODE];
+            all[k*njobs + i] = j;
+        }
+    }
+
+    t = bench_now();
+    for(r = 0; r < rounds; r++) {
+        for(i = 0; i < nnodes*njobs; i++) {
+            all[i]->op = POOL_ENCRYPT;
+            all[i]->inlen = mlen;
+            all[i]->adlen = 0;
+        }
+        romulus_pool_run(p, all, nnodes*njobs);
+    }
+    t = bench_now() - t;
+    for(i = 0; i < nnodes*njobs; i++) {
+        all[i]->op = POOL_DECRYPT;
+        all[i]->inlen = all[i]->outlen;
+    }
+    if (romulus_pool_run(p, all, nnodes*njobs))
+        ok = 0;
+    for(i = 0; i < nnodes*njobs; i++)
+        ok &= (all[i]->outlen == mlen);
+    if (!ok)
+        fprintf(stderr, "decryption failed\n");
+
+    for(k = 0; k < nnodes; k++) {
+        romulus_pool_free(p, nd[k].buf, njobs*stride);
+        romulus_pool_free(p, nd[k].keys,
+            KEYS_PER_NODE*sizeof(romulust_key_ctx));
+        romulus_pool_free(p, nd[k].npub, njobs*sizeof(*nd[k].npub));
+        romulus_pool_free(p, nd[k].jobs, njobs*sizeof(romulus_pool_job));
+    }
+    free(all);
+    romulus_pool_destroy(p);
+    return ok ? (double)rounds*nnodes*njobs*mlen/t/1e6 : 0;
+}
+
+/**
+ * Expands the contexts of 'nkeys' random keys, through the pool if 'cfg' is not
+ * NULL, and returns the elapsed time in milliseconds (0 on failure). Contexts
+ * are checked against single-threaded ones.
+ */
+static double warmup(const romulus_pool_cfg *cfg, size_t nkeys)
+{
+    romulus_pool *p = NULL;
+    romulust_key_ctx *ctx, ref;
+    mask_key_uint32_t *ks;
+    size_t i, len = nkeys*sizeof(romulust_key_ctx);
+    double t;
+    int ok = 1;
+
+    ks = malloc(4*nkeys*sizeof(mask_key_uint32_t));
+    ctx = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+        -1, 0);
+    if (cfg != NULL)
+        p = romulus_pool_create(cfg);
+    if (ks == NULL || ctx == MAP_FAILED || (cfg != NULL && p == NULL)) {
+        ok = 0;
+        goto end;
+    }
+    randombytes((uint8_t *)ks, 4*nkeys*sizeof(mask_key_uint32_t));
+    t = bench_now();
+    if (p != NULL)
+        ok = (romulus_pool_expand_keys(p, ctx, ks, nkeys) == 0);
+    else
+        romulus_expand_keys(ctx, ks, nkeys);
+    t = bench_now() - t;
+    for(i = 0; ok && i < nkeys; i += 1 + nkeys/64) {
+        romulus_expand_keys(&ref, ks + 4*i, 1);
+        ok = (memcmp(&ref, &ctx[i], sizeof(ref)) == 0);
+    }
+    if (!ok)
+        fprintf(stderr, "key expansion failed\n");
+end:
+    if (p != NULL)
+        romulus_pool_destroy(p);
+    if (ctx != MAP_FAILED)
+        munmap(ctx, len);
+    free(ks);
+    return ok ? t*1e3 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    romulus_pool_cfg cfg = {0};
+    int opt, w, max_workers = 0, rounds = 4, emulate = 0, fmt = BENCH_TEXT;
+    size_t mlen = 4096, njobs = 256, nkeys = 0;
+    romulus_pool *p;
+    bench_result r;
+
+    while ((opt = getopt(argc, argv, "e:w:s:j:r:k:f:")) != -1) {
+        switch (opt) {
+        case 'e': emulate = atoi(optarg); break;
+        case 'w': max_workers = atoi(optarg); break;
+        case 's': mlen = strtoul(optarg, NULL, 0); break;
+        case 'j': njobs = strtoul(optarg, NULL, 0); break;
+        case 'r': rounds = atoi(optarg); break;
+        case 'k': nkeys = strtoul(optarg, NULL, 0); break;
+        case 'f': fmt = bench_parse_format(optarg); break;
+        default: fmt = -1; break;
+        }
+    }
+    if (fmt < 0) {
+        fprintf(stderr, "usage: %s [-e <emulated nodes>] "
+            "[-w <max workers per node>] [-s <message bytes>] "
+            "[-j <jobs per node>] [-r <rounds>] [-k <keys>] "
+            "[-f text|csv|json]\n",
+            argv[0]);
+        return 1;
+    }
+    if (njobs == 0 || rounds <= 0)
+        return 1;
+    // default: up to as many workers per node as CPUs per node
+    cfg.emulate_nodes = emulate;
+    cfg.workers_per_node = 1;
+    p = romulus_pool_create(&cfg);
+    if (p == NULL)
+        return 1;
+    if (max_workers <= 0)
+        max_workers = (int)sysconf(_SC_NPROCESSORS_ONLN) /
+            romulus_pool_nodes(p);
+    if (max_workers <= 0)
+        max_workers = 1;
+    fprintf(stderr, "%d node(s)%s, %zu-byte messages, %zu jobs per node\n",
+        romulus_pool_nodes(p), emulate ? " (emulated)" : "", mlen, njobs);
+    romulus_pool_destroy(p);
+
+    bench_init(fmt, "pool");
+    r.name = "encrypt";
+    r.size_unit = "workers";
+    r.unit = "MB/s";
+    // powers of 2, then 'max_workers'
+    for(w = 1; ; w = (2*w < max_workers) ? 2*w : max_workers) {
+        cfg.workers_per_node = w;
+        r.size = w;
+        r.mode = "throughput";
+        cfg.flags = 0;
+        r.backend = "affinity";
+        r.value = run(&cfg, mlen, njobs, rounds);
+        bench_report(&r);
+        cfg.flags = POOL_NOAFFINITY;
+        r.backend = "no-affinity";
+        r.value = run(&cfg, mlen, njobs, rounds);
+        bench_report(&r);
+        if (w == max_workers)
+            break;
+    }
+    if (nkeys == 0)
+        return 0;
+    r.name = "expand_keys";
+    r.mode = "latency";
+    r.unit = "ms";
+    r.size = 1;
+    r.backend = "single-thread";
+    r.value = warmup(NULL, nkeys);
+    bench_report(&r);
+    cfg.flags = 0;
+    r.backend = "pool";
+    for(w = 1; ; w = (2*w < max_workers) ? 2*w : max_workers) {
+        cfg.workers_per_node = w;
+        r.size = w;
+        r.value = warmup(&cfg, nkeys);
+        bench_report(&r);
+        if (w == max_workers)
+            break;
+    }
+    return 0;
+}
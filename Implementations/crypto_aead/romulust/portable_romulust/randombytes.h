@@ -0,0 +1,6 @@
+#ifndef RANDOMBYTES_H
+#define RANDOMBYTES_H
+
+extern void randombytes(unsigned char *,unsigned long long);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,326 @@
+/**
+ * Key snapshots (POSIX only, see 'romulus_keysnap.h').
+ *
+ * Entries are wrapped with Romulus-T under a master key context. Romulus-M
+ * would require linking its reference implementation ('romulusm/ref'), whose
+ * symbols are not prefixed: crypto_aead_{en,de}crypt as well as generic names
+ * (rho, pad, block_cipher, lfsr_gf56, skinny_128_384_plus_enc...) shared with
+ * the other Romulus implementations. Keys are stored as shares so that they are
+ * never recombined, neither when written nor when loaded. Since the decrypted
+ * shares are those of snapshot time, fresh masks are applied before expansion.
+ *
+ * Entry states: KEYSNAP_UNTOUCHED -> KEYSNAP_BUSY -> KEYSNAP_READY or
+ * KEYSNAP_BAD. The thread which moves an entry to KEYSNAP_BUSY computes its
+ * context, the others wait for it to complete.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "randombytes.h"
+#include "romulus_keysnap.h"
+
+#define KEYSNAP_UNTOUCHED   0
+#define KEYSNAP_BUSY        1
+#define KEYSNAP_READY       2
+#define KEYSNAP_BAD         3
+
+#define KEYSNAP_ADBYTES     (sizeof(romulus_keysnap_hdr) - TAGBYTES)
+#define KEYSNAP_HDRINDEX    UINT64_MAX
+
+#define KEY_BYTES           (NUM_SHARES_KEY*CRYPTO_KEYBYTES)
+#define ENTRY_BYTES         ((KEY_BYTES + TAGBYTES + 63) & ~63)
+
+/**
+ * Splits the nonce file_id[0..7] || le64(i) into NUM_SHARES_NPUB shares.
+ */
+static void split_npub(
+    mask_npub_uint32_t npubs[4],
+    const uint8_t file_id[16],
+    uint64_t i)
+{
+    int j, k;
+    uint32_t x[4];
+    x[0] = (uint32_t)file_id[0] | (uint32_t)file_id[1] << 8 |
+        (uint32_t)file_id[2] << 16 | (uint32_t)file_id[3] << 24;
+    x[1] = (uint32_t)file_id[4] | (uint32_t)file_id[5] << 8 |
+        (uint32_t)file_id[6] << 16 | (uint32_t)file_id[7] << 24;
+    x[2] = (uint32_t)i;
+    x[3] = (uint32_t)(i >> 32);
+    randombytes((unsigned char *)npubs, 4*sizeof(mask_npub_uint32_t));
+    for(j = 0; j < 4; j++) {
+        npubs[j].shares[0] = x[j];
+        for(k = 1; k < NUM_SHARES_NPUB; k++)
+            npubs[j].shares[0] ^= npubs[j].shares[k];
+    }
+}
+
+/**
+ * Stores the key shares one after another (i.e. as 'romulust_expand_key'
+ * expects them). Uses a distinct loop per share as 'shares_to_bytearr_n'.
+ */
+static void key_shares_to_bytes(
+    uint8_t k[NUM_SHARES_KEY][CRYPTO_KEYBYTES],
+    const mask_key_uint32_t ks[4])
+{
+    int i, j;
+    for(j = 0; j < NUM_SHARES_KEY; j++) {
+        for(i = 0; i < 4; i++) {
+            k[j][i*4 + 0] = (uint8_t)((ks[i].shares[j] >> 0)  & 0xff);
+            k[j][i*4 + 1] = (uint8_t)((ks[i].shares[j] >> 8)  & 0xff);
+            k[j][i*4 + 2] = (uint8_t)((ks[i].shares[j] >> 16) & 0xff);
+            k[j][i*4 + 3] = (uint8_t)((ks[i].shares[j] >> 24) & 0xff);
+        }
+    }
+}
+
+/**
+ * Applies fresh masks to key shares: a random value is XORed into each share
+ * but the 1st one, and into the 1st one as well.
+ */
+static void refresh_masks(uint8_t k[NUM_SHARES_KEY][CRYPTO_KEYBYTES])
+{
+    int i, j;
+    uint8_t r[CRYPTO_KEYBYTES];
+    for(j = 1; j < NUM_SHARES_KEY; j++) {
+        randombytes(r, CRYPTO_KEYBYTES);
+        for(i = 0; i < CRYPTO_KEYBYTES; i++) {
+            k[j][i] ^= r[i];
+            k[0][i] ^= r[i];
+        }
+    }
+    zeroize(r, CRYPTO_KEYBYTES);
+}
+
+static int write_all(int fd, const uint8_t *buf, size_t len)
+{
+    ssize_t n;
+    while (len > 0) {
+        n = write(fd, buf, len);
+        if (n <= 0)
+            return -1;
+        buf += n;
+        len -= n;
+    }
+    return 0;
+}
+
+/**
+ * Writes 'n' keys to 'path'. The file is replaced only once fully written and
+ * synced.
+ */
+int romulus_keysnap_write(
+    const char *path,
+    const mask_key_uint32_t *ks,
+    uint64_t n,
+    const romulust_key_ctx *master)
+{
+    int fd, ret = -1;
+    uint64_t i;
+    unsigned long long len;
+    char *tmp;
+    uint8_t dummy[4];
+    uint8_t k[NUM_SHARES_KEY][CRYPTO_KEYBYTES];
+    uint32_t page[KEYSNAP_HDRBYTES/4];
+    romulus_keysnap_hdr hdr;
+    mask_npub_uint32_t npubs[4];
+
+    tmp = malloc(strlen(path) + 5);
+    if (tmp == NULL)
+        return -1;
+    sprintf(tmp, "%s.tmp", path);
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0)
+        goto out;
+
+    zeroize((uint8_t *)&hdr, sizeof(hdr));
+    hdr.magic = KEYSNAP_MAGIC;
+    hdr.version = KEYSNAP_VERSION;
+    hdr.shares = NUM_SHARES_KEY;
+    hdr.key_bytes = KEY_BYTES;
+    hdr.entry_bytes = ENTRY_BYTES;
+    hdr.nkeys = n;
+    randombytes(hdr.file_id, 8);
+    split_npub(npubs, hdr.file_id, KEYSNAP_HDRINDEX);
+    crypto_aead_encrypt_shared_ctx(
+        (mask_c_uint32_t *)hdr.tag, &len,
+        (const mask_m_uint32_t *)dummy, 0,
+        (const mask_ad_uint32_t *)&hdr, KEYSNAP_ADBYTES,
+        npubs, master);
+    zeroize((uint8_t *)page, KEYSNAP_HDRBYTES);
+    *(romulus_keysnap_hdr *)page = hdr;
+    if (write_all(fd, (uint8_t *)page, KEYSNAP_HDRBYTES))
+        goto out;
+
+    for(i = 0; i < n; i++) {
+        zeroize((uint8_t *)page, ENTRY_BYTES);
+        key_shares_to_bytes(k, ks + 4*i);
+        split_npub(npubs, hdr.file_id, i);
+        crypto_aead_encrypt_shared_ctx(
+            (mask_c_uint32_t *)page, &len,
+            (const mask_m_uint32_t *)k, KEY_BYTES,
+            (const mask_ad_uint32_t *)&hdr, KEYSNAP_ADBYTES,
+            npubs, master);
+        if (write_all(fd, (uint8_t *)page, ENTRY_BYTES))
+            break;
+    }
+    zeroize((uint8_t *)k, KEY_BYTES);
+    if (i == n && fsync(fd) == 0 && close(fd) == 0) {
+        fd = -1;
+        ret = rename(tmp, path);
+    }
+
+out:
+    if (fd >= 0)
+        close(fd);
+    if (ret)
+        unlink(tmp);
+    free(tmp);
+    return ret;
+}
+
+/**
+ * Maps the snapshot and checks its header. The context table is reserved
+ * without swap accounting: its pages are only allocated when first written.
+ */
+int romulus_keysnap_open(
+    romulus_keysnap *s,
+    const char *path,
+    const romulust_key_ctx *master)
+{
+    int fd;
+    struct stat st;
+    uint8_t dummy[4];
+    unsigned long long len;
+    romulus_keysnap_hdr hdr;
+    mask_npub_uint32_t npubs[4];
+    void *map;
+
+    s->map = NULL;
+    s->state = NULL;
+    s->ctx = NULL;
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) || st.st_size < KEYSNAP_HDRBYTES) {
+        close(fd);
+        return -1;
+    }
+    s->maplen = st.st_size;
+    map = mmap(NULL, s->maplen, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+    s->map = map;
+
+    hdr = *(const romulus_keysnap_hdr *)s->map;
+    if (hdr.magic != KEYSNAP_MAGIC || hdr.version != KEYSNAP_VERSION ||
+        hdr.shares != NUM_SHARES_KEY || hdr.key_bytes != KEY_BYTES ||
+        hdr.entry_bytes != ENTRY_BYTES ||
+        hdr.nkeys > (s->maplen - KEYSNAP_HDRBYTES) / ENTRY_BYTES ||
+        hdr.nkeys * ENTRY_BYTES != s->maplen - KEYSNAP_HDRBYTES)
+        goto fail;
+    split_npub(npubs, hdr.file_id, KEYSNAP_HDRINDEX);
+    if (crypto_aead_decrypt_shared_ctx(
+            (mask_m_uint32_t *)dummy, &len,
+            (const mask_c_uint32_t *)hdr.tag, TAGBYTES,
+            (const mask_ad_uint32_t *)&hdr, KEYSNAP_ADBYTES,
+            npubs, master))
+        goto fail;
+
+    s->nkeys = hdr.nkeys;
+    s->entry_bytes = hdr.entry_bytes;
+    s->master = master;
+    if (s->nkeys == 0)
+        return 0;
+    s->state = calloc(s->nkeys, sizeof(uint32_t));
+    map = mmap(NULL, s->nkeys*sizeof(romulust_key_ctx), PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (s->state == NULL || map == MAP_FAILED) {
+        if (map != MAP_FAILED)
+            munmap(map, s->nkeys*sizeof(romulust_key_ctx));
+        free(s->state);
+        s->state = NULL;
+        goto fail;
+    }
+    madvise(map, s->nkeys*sizeof(romulust_key_ctx), MADV_DONTDUMP);
+    s->ctx = map;
+    return 0;
+
+fail:
+    munmap((void *)s->map, s->maplen);
+    s->map = NULL;
+    return -1;
+}
+
+uint64_t romulus_keysnap_count(const romulus_keysnap *s)
+{
+    return s->nkeys;
+}
+
+/**
+ * Decrypts, remasks and expands the i-th key on first use. An entry which fails
+ * authentication stays unusable until the snapshot is reopened.
+ */
+const romulust_key_ctx *romulus_keysnap_get(romulus_keysnap *s, uint64_t i)
+{
+    uint32_t st = KEYSNAP_UNTOUCHED;
+    unsigned long long len;
+    uint8_t k[NUM_SHARES_KEY][CRYPTO_KEYBYTES];
+    mask_npub_uint32_t npubs[4];
+    const romulus_keysnap_hdr *hdr = (const romulus_keysnap_hdr *)s->map;
+
+    if (i >= s->nkeys)
+        return NULL;
+    if (__atomic_compare_exchange_n(&s->state[i], &st, KEYSNAP_BUSY, 0,
+            __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+        split_npub(npubs, hdr->file_id, i);
+        if (crypto_aead_decrypt_shared_ctx(
+                (mask_m_uint32_t *)k, &len,
+                (const mask_c_uint32_t *)
+                    (s->map + KEYSNAP_HDRBYTES + i*s->entry_bytes),
+                KEY_BYTES + TAGBYTES,
+                (const mask_ad_uint32_t *)hdr, KEYSNAP_ADBYTES,
+                npubs, s->master)) {
+            st = KEYSNAP_BAD;
+        } else {
+            refresh_masks(k);
+            romulust_expand_key(s->ctx + i, (const uint8_t (*)[TWEAKEYBYTES])k);
+            zeroize((uint8_t *)k, KEY_BYTES);
+            st = KEYSNAP_READY;
+        }
+        __atomic_store_n(&s->state[i], st, __ATOMIC_RELEASE);
+    }
+    while (st == KEYSNAP_BUSY) {
+        sched_yield();
+        st = __atomic_load_n(&s->state[i], __ATOMIC_ACQUIRE);
+    }
+    return (st == KEYSNAP_READY) ? s->ctx + i : NULL;
+}
+
+void romulus_keysnap_close(romulus_keysnap *s)
+{
+    uint64_t i;
+    if (s->map == NULL)
+        return;
+    for(i = 0; i < s->nkeys; i++)
+        if (s->state[i] == KEYSNAP_READY)
+            explicit_bzero(s->ctx + i, sizeof(romulust_key_ctx));
+    if (s->ctx != NULL)
+        munmap(s->ctx, s->nkeys*sizeof(romulust_key_ctx));
+    munmap((void *)s->map, s->maplen);
+    free(s->state);
+    s->map = NULL;
+    s->state = NULL;
+    s->ctx = NULL;
+}
@@ -0,0 +1,82 @@
+#ifndef ROMULUS_KEYSNAP_H_
+#define ROMULUS_KEYSNAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "crypto_aead_shared.h"
+
+//Key snapshots (POSIX only), so that a service can restart without loading,
+//splitting and expanding all its keys before serving requests.
+//
+//File layout (native endianness):
+//  [0, KEYSNAP_HDRBYTES)       header, padded with zeros
+//  KEYSNAP_HDRBYTES + i*entry  Romulus-T ciphertext || tag of the key shares
+//                              of the i-th key, padded to a multiple of 64
+//
+//All entries are encrypted under a master key context with the first 48 bytes
+//of the header as associated data, and nonce file_id[0..7] || le64(i). The
+//header itself is authenticated with the nonce file_id[0..7] || le64(2^64-1).
+//Entries hold key shares rather than key contexts: the round tweakeys are 80
+//times larger than the key and decrypting them costs far more than the key
+//schedule itself.
+//
+//At opening, the file is mapped and only its header is checked, while the
+//table of key contexts is reserved but not populated. The i-th entry is then
+//decrypted, remasked and expanded into the i-th context the first time it is
+//requested, so that the restart cost is that of the page faults of the keys
+//actually used.
+#define KEYSNAP_MAGIC       0x31534b52      // "RKS1"
+#define KEYSNAP_VERSION     1
+#define KEYSNAP_HDRBYTES    4096
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t shares;                        // NUM_SHARES_KEY
+    uint32_t key_bytes;                     // NUM_SHARES_KEY*CRYPTO_KEYBYTES
+    uint32_t entry_bytes;
+    uint64_t nkeys;
+    uint8_t file_id[16];                    // random, only 8 bytes are used
+    uint8_t reserved[8];
+    uint8_t tag[TAGBYTES];                  // over the 48 bytes above
+} romulus_keysnap_hdr;
+
+typedef struct {
+    const uint8_t *map;
+    size_t maplen;
+    uint64_t nkeys;
+    uint32_t entry_bytes;
+    uint32_t *state;                        // per-entry, see romulus_keysnap.c
+    romulust_key_ctx *ctx;                  // populated on demand
+    const romulust_key_ctx *master;
+} romulus_keysnap;
+
+//Writes the 'n' keys 'ks' (4 words per key, as for 'romulus_expand_keys') to
+//'path' through a temporary file renamed once synced.
+//Returns 0 on success, -1 otherwise.
+int romulus_keysnap_write(
+    const char *path,
+    const mask_key_uint32_t *ks,
+    uint64_t n,
+    const romulust_key_ctx *master
+);
+
+//Maps the snapshot at 'path' and authenticates its header. 'master' must
+//remain valid until 'romulus_keysnap_close'. Returns 0 on success, -1
+//otherwise.
+int romulus_keysnap_open(
+    romulus_keysnap *s,
+    const char *path,
+    const romulust_key_ctx *master
+);
+
+uint64_t romulus_keysnap_count(const romulus_keysnap *s);
+
+//Returns the context of the i-th key, computing it on first use (thread-safe),
+//or NULL if i is out of range or if the entry fails authentication.
+const romulust_key_ctx *romulus_keysnap_get(romulus_keysnap *s, uint64_t i);
+
+//Wipes the key contexts and unmaps the snapshot.
+void romulus_keysnap_close(romulus_keysnap *s);
+
+#endif  // ROMULUS_KEYSNAP_H_
@@ -0,0 +1,656 @@
+/**
+ * Romulus-T core functions (portable C version).
+ *
+ * Pairs of independent Skinny-128-384+ calls are processed at once thanks to
+ * the 2-way 64-bit implementation in 'skinny128_core_x2.c'. Several messages
+ * can also be processed in lock-step (see the '_x8' functions) so that up to 8
+ * independent Skinny-128-384+ calls run at once on AVX2 CPUs.
+ * 
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ * 
+ * @date        October 2026
+ */
+#include "skinny128.h"
+#include "romulus_t.h"
+#include "romulus_bulk.h"
+#if MASKING_ORDER > 1
+#include "randombytes.h"
+#endif
+
+unsigned long long romulus_bulk_threshold = ROMULUS_BULK_THRESHOLD;
+
+/**
+ * Equivalent to 'memset(buf, 0x00, buflen)'.
+ */
+void zeroize(uint8_t buf[], int buflen)
+{
+  int i;
+  for(i = 0; i < buflen; i++)
+    buf[i] = 0x00;
+}
+
+/**
+ * Equivalent to 'memcpy(dest, src, srclen)'.
+ */
+static void copy(uint8_t dest[], const uint8_t src[], int srclen)
+{
+  int i;
+  for(i = 0; i < srclen; i++)
+    dest[i] = src[i];
+}
+
+/**
+ * Padding function used in Romulus-H.
+ */
+static void ipad_256(
+  const unsigned char m[],
+  unsigned char mp[],
+  int l,
+  int len8)
+{
+  int i;
+  for (i = 0; i < l; i++) {
+    if (i < len8) {      
+      mp[i] = m[i];
+    } else if (i == l - 1) {
+      mp[i] = (len8 & 0x1f);
+    } else {
+      mp[i] = 0x00;
+    }      
+  }
+}
+
+/**
+ * Padding function used in Romulus-H.
+ */
+static void ipad_128(
+  const unsigned char m[],
+  unsigned char mp[],
+  int l,
+  int len8)
+{
+  int i;
+  for (i = 0; i < l; i++) {
+    if (i < len8) {      
+      mp[i] = m[i];
+    } else if (i == l - 1) {
+      mp[i] = (len8 & 0xf);
+    } else {
+      mp[i] = 0x00;
+    }      
+  }
+}
+
+/**
+ * State of a Romulus-H computation within Romulus-T, so that the 256-bit
+ * blocks fed to the compression function can be generated one at a time.
+ */
+typedef struct {
+  const unsigned char *a;
+  const unsigned char *c;
+  const unsigned char *npub;
+  unsigned char *tk1;
+  unsigned long long adlen;
+  unsigned long long clen;
+  uint8_t adempty, cempty, n, phase, final;
+  uint8_t bulk;     // see 'romulus_bulk.h'
+} romulusht_lane;
+
+#define HT_AD       0   // full AD double blocks
+#define HT_AD_TAIL  1   // partial AD block, possibly w/ the first C block
+#define HT_C        2   // full C double blocks
+#define HT_C_TAIL   3   // partial C block(s)
+#define HT_FINAL    4   // nonce and counter
+#define HT_DONE     5
+
+static void romulusht_init(
+  romulusht_lane *l,
+  const unsigned char a[],
+  unsigned long long adlen,
+  const unsigned char c[],
+  unsigned long long clen,
+  const unsigned char npub[],
+  unsigned char tk1[])
+{
+  l->a = a;
+  l->c = c;
+  l->npub = npub;
+  l->tk1 = tk1;
+  l->adlen = adlen;
+  l->clen = clen;
+  l->adempty = (adlen == 0);
+  l->cempty = (clen == 0);
+  l->n = BLOCKBYTES;
+  l->phase = HT_AD;
+  l->final = 0;
+  l->bulk = BULK_ENABLED(clen);
+  zeroize(tk1+1, BLOCKBYTES-1);
+  tk1[0] = 0x01;
+}
+
+/**
+ * Writes into 'p' the next block to be absorbed by the compression function.
+ * Returns 0 if there is none left, 1 otherwise ('l->final' being set for the
+ * last one).
+ */
+static int romulusht_next(romulusht_lane *l, unsigned char p[2*BLOCKBYTES])
+{
+  uint8_t i;
+  uint32_t tmp;
+  switch (l->phase) {
+  case HT_AD:
+    if (l->adlen >= 2*BLOCKBYTES) { // AD Normal loop
+      copy(p, l->a, 2*BLOCKBYTES);
+      l->a += 2*BLOCKBYTES;
+      l->adlen -= 2*BLOCKBYTES;
+      return 1;
+    }
+    l->phase = HT_AD_TAIL;
+    // fall through
+  case HT_AD_TAIL:
+    l->phase = HT_C;
+    // Partial block (or in case there is no partial block we add a 0^2n block)
+    if (l->adlen >= BLOCKBYTES) {
+      ipad_128(l->a, p, 2*BLOCKBYTES, l->adlen);
+      return 1;
+    }
+    else if (l->adempty == 0) {
+      ipad_128(l->a, p, BLOCKBYTES, l->adlen);
+      l->adlen = 0;
+      if (l->clen >= BLOCKBYTES) {
+        for (i = 0; i < BLOCKBYTES; i++)
+          p[i+BLOCKBYTES] = l->c[i];
+        UPDATE_CTR(l->tk1);
+        l->clen -= BLOCKBYTES;
+        l->c += BLOCKBYTES;
+      }
+      else if (l->clen > 0) {
+        ipad_128(l->c, p+BLOCKBYTES, BLOCKBYTES, l->clen);
+        l->clen = 0;
+        l->cempty = 1;
+        l->c += BLOCKBYTES;
+        UPDATE_CTR(l->tk1);
+      }
+      else {
+        for (i = 0; i < BLOCKBYTES; i++) // Pad the nonce
+          p[i+BLOCKBYTES] = l->npub[i];
+        l->n = 0;
+      }
+      return 1;
+    }
+    // fall through
+  case HT_C:
+    if (l->clen >= 2*BLOCKBYTES) { // C Normal loop
+      if (l->bulk)
+        BULK_PREFETCH(l->c);
+      copy(p, l->c, 2*BLOCKBYTES);
+      l->c += 2*BLOCKBYTES;
+      l->clen -= 2*BLOCKBYTES;
+      UPDATE_CTR(l->tk1);
+      UPDATE_CTR(l->tk1);
+      return 1;
+    }
+    l->phase = HT_C_TAIL;
+    // fall through
+  case HT_C_TAIL:
+    l->phase = HT_FINAL;
+    if (l->clen > BLOCKBYTES) {
+      ipad_128(l->c, p, 2*BLOCKBYTES, l->clen);
+      UPDATE_CTR(l->tk1);
+      UPDATE_CTR(l->tk1);
+      return 1;
+    }
+    else if (l->clen == BLOCKBYTES) {
+      ipad_128(l->c, p, 2*BLOCKBYTES, l->clen);
+      UPDATE_CTR(l->tk1);
+      return 1;
+    }
+    else if (l->cempty == 0) {
+      ipad_128(l->c, p, BLOCKBYTES, l->clen);
+      if (l->clen > 0) {
+        UPDATE_CTR(l->tk1);
+      }
+      for (i = 0; i < BLOCKBYTES; i++) { // Pad the nonce
+        p[i+BLOCKBYTES] = l->npub[i];
+      }
+      l->n = 0;
+      return 1;
+    }
+    // fall through
+  case HT_FINAL:
+    l->phase = HT_DONE;
+    if (l->n == BLOCKBYTES) {
+      for (i = 0; i < 16; i++) { // Pad the nonce and counter
+        p[i] = l->npub[i];
+      }
+      for (i = 16; i < 23; i++) {
+        p[i] = l->tk1[i-16];
+      }
+      ipad_256(p, p, 2*BLOCKBYTES, 23);
+    }
+    else {
+      ipad_256(l->tk1, p, 2*BLOCKBYTES, 7);
+    }
+    l->final = 1;
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+/**
+ * Romulus-H implementation used within Romulus-T, for up to ROMULUST_BATCH
+ * independent inputs at once.
+ * It is not convenient to mutualize the code with Romulus-H since ...
+ *
+ * Inputs are processed in lock-step: at each step, every input which is not
+ * fully absorbed feeds one block to Hirose's double-block length compression
+ * function, i.e. 2 Skinny-128-384+ calls sharing the same tweakey, and all
+ * calls are processed at once by 'skinny128_384_plus_x8'.
+ */
+void romulusht_x8(
+  unsigned char out[][2*BLOCKBYTES],
+  const unsigned char *const a[],
+  const unsigned long long adlen[],
+  const unsigned char *const c[],
+  const unsigned long long clen[],
+  const unsigned char *const npub[],
+  unsigned char tk1[][BLOCKBYTES],
+  int n)
+{
+  int b, i, k;
+  romulusht_lane l[ROMULUST_BATCH];
+  uint8_t h[ROMULUST_BATCH][BLOCKBYTES];
+  uint8_t g[ROMULUST_BATCH][BLOCKBYTES];
+  uint8_t h1[ROMULUST_BATCH][BLOCKBYTES];
+  uint8_t tmp[ROMULUST_BATCH][BLOCKBYTES];
+  uint8_t p[ROMULUST_BATCH][2*BLOCKBYTES];
+  uint8_t rtk_1[ROMULUST_BATCH][TKPERMORDER*BLOCKBYTES];
+  uint8_t rtk_23[ROMULUST_BATCH][SKINNY128_384_ROUNDS*BLOCKBYTES];
+  uint8_t *bout[2*ROMULUST_BATCH];
+  const uint8_t *bin[2*ROMULUST_BATCH];
+  const uint8_t *brtk_1[2*ROMULUST_BATCH];
+  const uint8_t *brtk_23[2*ROMULUST_BATCH];
+  int act[ROMULUST_BATCH];
+
+  for(b = 0; b < n; b++) {
+    romulusht_init(&l[b], a[b], adlen[b], c[b], clen[b], npub[b], tk1[b]);
+    zeroize(h[b], BLOCKBYTES);
+    zeroize(g[b], BLOCKBYTES);
+  }
+  for(;;) {
+    k = 0;
+    for(b = 0; b < n; b++)
+      if (romulusht_next(&l[b], p[b]))
+        act[k++] = b;
+    if (k == 0)
+      break;
+    for(i = 0; i < k; i++) {
+      b = act[i];
+      if (l[b].final)
+        h[b][0] ^= 2;
+      tk_schedule_123(rtk_1[b], rtk_23[b], g[b], p[b], p[b]+BLOCKBYTES);
+      copy(h1[b], h[b], BLOCKBYTES);
+      h1[b][0] ^= 0x01;
+      // both calls share the same tweakey
+      bout[2*i] = tmp[b];
+      bin[2*i] = h[b];
+      bout[2*i+1] = g[b];
+      bin[2*i+1] = h1[b];
+      brtk_1[2*i] = brtk_1[2*i+1] = rtk_1[b];
+      brtk_23[2*i] = brtk_23[2*i+1] = rtk_23[b];
+    }
+    for(i = 0; i < 2*k; i += 8)
+      skinny128_384_plus_x8(bout + i, bin + i, brtk_1 + i, brtk_23 + i,
+        (2*k - i < 8) ? 2*k - i : 8);
+    for(i = 0; i < k; i++) {
+      b = act[i];
+      h[b][0] ^= 0x01;
+      for (int j = 0; j < BLOCKBYTES; j++) {
+        g[b][j] ^= h[b][j];
+        h[b][j] ^= tmp[b][j];
+      }
+      h[b][0] ^= 0x01;
+    }
+  }
+  for(b = 0; b < n; b++) { // Assign the output tags
+    copy(out[b], h[b], BLOCKBYTES);
+    copy(out[b]+BLOCKBYTES, g[b], BLOCKBYTES);
+  }
+}
+
+/**
+ * Romulus-H implementation used within Romulus-T.
+ */
+int romulusht(
+  unsigned char out[],
+  const unsigned char a[],
+  unsigned long long  adlen,
+  const unsigned char c[],
+  unsigned long long clen,
+  const unsigned char npub[],
+  unsigned char tk1[])
+{
+  romulusht_x8((unsigned char (*)[2*BLOCKBYTES])out, &a, &adlen, &c, &clen,
+    &npub, (unsigned char (*)[BLOCKBYTES])tk1, 1);
+  return 0;
+}
+
+/**
+ * Precomputes the round tweakeys related to the secret key (passed as TK3) for
+ * all shares, so that they can be reused across calls with the same key.
+ */
+void romulust_expand_key(
+  romulust_key_ctx *ctx,
+  const unsigned char k[MASKING_SHARES][TWEAKEYBYTES])
+{
+  int i;
+  tks_3_x2(ctx->rtk_3[0], ctx->rtk_3[1], k[0], k[1]);
+  for(i = 2; i < MASKING_SHARES; i++)
+    tks_23(ctx->rtk_3[i], NULL, k[i], 0);
+}
+
+/**
+ * Masked Skinny-128-384+ on up to ROMULUST_BATCH independent blocks where
+ * 'rtk_3[b][0]' is the 1st share of the round tweakeys related to TK2/TK3 and
+ * 'rtk_3[b][i]' the other key shares of the b-th block.
+ * If MASKING_ORDER = 1, blocks are processed in parallel by the dedicated
+ * 1st-order implementation, one after another by the d-th order one otherwise.
+ * Inputs and outputs may overlap.
+ */
+static void skinny128_384_plus_masked_x8(
+  uint8_t out[][MASKING_SHARES][BLOCKBYTES],
+  const uint8_t in[][MASKING_SHARES][BLOCKBYTES],
+  const uint8_t *rtk_3[][MASKING_SHARES],
+  const uint8_t *const rtk_1[],
+  int n)
+{
+  int i;
+#if MASKING_ORDER == 1
+  const uint8_t *rtk_23[ROMULUST_BATCH] = {0}, *rtk_3m[ROMULUST_BATCH] = {0};
+  for(i = 0; i < n; i++) {
+    rtk_23[i] = rtk_3[i][0];
+    rtk_3m[i] = rtk_3[i][1];
+  }
+  skinny128_384_plus_m_x8(out, in, rtk_23, rtk_3m, rtk_1, n);
+#else
+  uint32_t rnd[HOM_RAND_WORDS];
+  for(i = 0; i < n; i++) {
+    randombytes((uint8_t *)rnd, sizeof(rnd));
+    skinny128_384_plus_hom(out[i], in[i], rtk_3[i], rtk_1[i], rnd);
+  }
+#endif
+}
+
+/**
+ * Key derivation function used in Romulus-T for up to ROMULUST_BATCH messages
+ * at once (see 'romulust_kdf').
+ */
+void romulust_kdf_x8(
+  uint8_t state[][BLOCKBYTES],
+  uint8_t tk1[][BLOCKBYTES],
+  unsigned char npub[][MASKING_SHARES][BLOCKBYTES],
+  const romulust_key_ctx *const ctx[],
+  int n)
+{
+  uint8_t state_s[ROMULUST_BATCH][MASKING_SHARES][BLOCKBYTES];
+  uint8_t rtk_1[ROMULUST_BATCH][TKPERMORDER*BLOCKBYTES];
+  const uint8_t *prtk_1[ROMULUST_BATCH] = {0};
+  const uint8_t *rtk_3[ROMULUST_BATCH][MASKING_SHARES];
+  for(int b = 0; b < n; b++) {
+    for(int j = 0; j < MASKING_SHARES; j++)
+      rtk_3[b][j] = ctx[b]->rtk_3[j];
+    SET_DOMAIN(tk1[b], 0x42);
+    tk_schedule_1(rtk_1[b], tk1[b]);
+    prtk_1[b] = rtk_1[b];
+  }
+  skinny128_384_plus_masked_x8(state_s,
+    (const uint8_t (*)[MASKING_SHARES][BLOCKBYTES])npub, rtk_3, prtk_1, n);
+  // unmask derived keys for further calls to skinny-128-384+
+  for(int b = 0; b < n; b++) {
+    for(int i = 0; i < BLOCKBYTES; i++) {
+      state[b][i] = state_s[b][0][i];
+      for(int j = 1; j < MASKING_SHARES; j++) {
+        state[b][i]   ^= state_s[b][j][i];
+        npub[b][0][i] ^= npub[b][j][i];
+        npub[b][j][i]  = state_s[b][j][i]; // updated mask for tag generation
+      }
+    }
+    tk1[b][0] = 0x01;  // init counter
+  }
+}
+
+/**
+ * Key derivation function used in Romulus-T.
+ * This function requires side-channel countermeasure since the secret key is
+ * directly manipulated.
+ * The derived key is then stored in the internal state.
+ */
+void romulust_kdf(
+  uint8_t *state,
+  uint8_t *tk1,
+  unsigned char npub[MASKING_SHARES][BLOCKBYTES],
+  const romulust_key_ctx *ctx)
+{
+  romulust_kdf_x8((uint8_t (*)[BLOCKBYTES])state, (uint8_t (*)[BLOCKBYTES])tk1,
+    (unsigned char (*)[MASKING_SHARES][BLOCKBYTES])npub, &ctx, 1);
+}
+
+/**
+ * Processes up to ROMULUST_BATCH input messages at once.
+ * Update the internal states and the output buffers.
+ *
+ * Messages are processed in lock-step: at each step, every message which is
+ * not fully processed contributes its keystream block and, unless it is the
+ * last one, its state update block, all of them being computed at once by
+ * 'skinny128_384_plus_x8'.
+ * When a single message remains or if AVX2 is not supported, both blocks of a
+ * message are instead computed by the keystream engine
+ * 'skinny128_384_plus_ks', the nonce being packed once per message.
+ * In both cases, the TK1 round tweakeys of the state update block are derived
+ * from the ones of the keystream block since they only differ in the domain.
+ * In bulk mode (see 'romulus_bulk.h'), messages are prefetched but ciphertexts
+ * are written through the caches since they are read back by the hash.
+ */
+void romulust_process_msg_x8(
+  uint8_t state[][BLOCKBYTES],
+  uint8_t tk1[][BLOCKBYTES],
+  const unsigned char *const npub[],
+  unsigned char *const c[],
+  const unsigned char *const m[],
+  const unsigned long long mlen[],
+  int n)
+{
+  uint32_t tmp;
+  int b, i, j, k, nblocks;
+  unsigned long long rem[ROMULUST_BATCH];
+  unsigned char *pc[ROMULUST_BATCH];
+  const unsigned char *pm[ROMULUST_BATCH];
+  uint8_t done[ROMULUST_BATCH];
+  uint8_t bulk[ROMULUST_BATCH];
+  uint8_t delta[TWEAKEYBYTES];
+  uint8_t rtk_1d[TKPERMORDER*BLOCKBYTES];
+  uint32_t pnpub[ROMULUST_BATCH][4];
+  uint8_t out[ROMULUST_BATCH][BLOCKBYTES];
+  uint8_t rtk_1[ROMULUST_BATCH][TKPERMORDER*BLOCKBYTES];
+  uint8_t rtk_1s[ROMULUST_BATCH][TKPERMORDER*BLOCKBYTES];
+  uint8_t rtk_3[ROMULUST_BATCH][SKINNY128_384_ROUNDS*BLOCKBYTES];
+  uint8_t *bout[2*ROMULUST_BATCH];
+  const uint8_t *bin[2*ROMULUST_BATCH];
+  const uint8_t *brtk_1[2*ROMULUST_BATCH];
+  const uint8_t *brtk_3[2*ROMULUST_BATCH];
+  int act[ROMULUST_BATCH];
+
+  // TK1 round tweakeys of the domain difference 0x40 ^ 0x41
+  zeroize(delta, TWEAKEYBYTES);
+  SET_DOMAIN(delta, 0x40 ^ 0x41);
+  tk_schedule_1(rtk_1d, delta);
+  for(b = 0; b < n; b++) {
+    rem[b] = mlen[b];
+    pc[b] = c[b];
+    pm[b] = m[b];
+    done[b] = 0;
+    bulk[b] = BULK_ENABLED(mlen[b]);
+    packing(pnpub[b], npub[b]);
+  }
+  for(;;) {
+    k = 0;
+    for(b = 0; b < n; b++)
+      if (!done[b])
+        act[k++] = b;
+    if (k == 0)
+      break;
+    if (k == 1 || !avx2_available()) {
+      for(i = 0; i < k; i++) {
+        b = act[i];
+        SET_DOMAIN(tk1[b], 0x40);
+        tk_schedule_1(rtk_1[b], tk1[b]);
+        skinny128_384_plus_ks(out[b], state[b], pnpub[b], rtk_1[b], rtk_1d,
+          rem[b] > BLOCKBYTES);
+        if (rem[b] > BLOCKBYTES)
+          SET_DOMAIN(tk1[b], 0x41);
+      }
+    } else {
+      nblocks = 0;
+      for(i = 0; i < k; i++) {
+        b = act[i];
+        SET_DOMAIN(tk1[b], 0x40);
+        tk_schedule_13(rtk_1[b], rtk_3[b], tk1[b], state[b]);
+        bout[nblocks] = out[b];
+        bin[nblocks] = npub[b];
+        brtk_1[nblocks] = rtk_1[b];
+        brtk_3[nblocks++] = rtk_3[b];
+        if (rem[b] > BLOCKBYTES) {
+          // keystream and state update only differ in the domain separation
+          SET_DOMAIN(tk1[b], 0x41);
+          for(j = 0; j < TKPERMORDER*BLOCKBYTES; j++)
+            rtk_1s[b][j] = rtk_1[b][j] ^ rtk_1d[j];
+          bout[nblocks] = state[b];
+          bin[nblocks] = npub[b];
+          brtk_1[nblocks] = rtk_1s[b];
+          brtk_3[nblocks++] = rtk_3[b];
+        }
+      }
+      for(i = 0; i < nblocks; i += 8)
+        skinny128_384_plus_x8(bout + i, bin + i, brtk_1 + i, brtk_3 + i,
+          (nblocks - i < 8) ? nblocks - i : 8);
+    }
+    for(i = 0; i < k; i++) {
+      b = act[i];
+      UPDATE_CTR(tk1[b]);
+      if (rem[b] > BLOCKBYTES) {
+        if (bulk[b])
+          BULK_PREFETCH(pm[b]);
+        XOR_BLOCK(pc[b], pm[b], out[b]);
+        pc[b] += BLOCKBYTES;
+        pm[b] += BLOCKBYTES;
+        rem[b] -= BLOCKBYTES;
+      } else {
+        for(unsigned long long j = 0; j < rem[b]; j++)
+          pc[b][j] = pm[b][j] ^ out[b][j];
+        done[b] = 1;
+      }
+    }
+  }
+}
+
+/**
+ * Process the input message.
+ * Update the internal state and the output buffer.
+ */
+void romulust_process_msg(
+  uint8_t *state,
+  uint8_t *tk1,
+  const unsigned char *npub,
+  unsigned char *c,
+  const unsigned char *m,
+  unsigned long long mlen)
+{
+  romulust_process_msg_x8((uint8_t (*)[BLOCKBYTES])state,
+    (uint8_t (*)[BLOCKBYTES])tk1, &npub, &c, &m, &mlen, 1);
+}
+
+/**
+ * Generation of the authentication tags of up to ROMULUST_BATCH messages at
+ * once (see 'romulust_generate_tag'). Both the hashing and the masked
+ * Skinny-128-384+ calls are batched.
+ */
+void romulust_generate_tag_x8(
+  uint8_t tag[][BLOCKBYTES],
+  unsigned char tk1[][BLOCKBYTES],
+  const unsigned char *const ad[],
+  const unsigned long long adlen[],
+  const unsigned char *const c[],
+  const unsigned long long mlen[],
+  unsigned char npub[][MASKING_SHARES][BLOCKBYTES],
+  const romulust_key_ctx *const ctx[],
+  int n)
+{
+  uint8_t hash[ROMULUST_BATCH][2*BLOCKBYTES];
+  uint8_t zeros[TWEAKEYBYTES];
+  const uint8_t *pnpub[ROMULUST_BATCH] = {0};
+  uint8_t rtk_1[ROMULUST_BATCH][TKPERMORDER*BLOCKBYTES];
+  uint32_t rtk_23[ROMULUST_BATCH][SKINNY128_384_ROUNDS*BLOCKBYTES/4];
+  uint8_t tag_s[ROMULUST_BATCH][MASKING_SHARES][BLOCKBYTES];
+  const uint8_t *prtk_1[ROMULUST_BATCH] = {0};
+  const uint8_t *rtk_3[ROMULUST_BATCH][MASKING_SHARES];
+
+  zeroize(zeros, TWEAKEYBYTES);
+  for(int b = 0; b < n; b++)
+    pnpub[b] = npub[b][0];
+  romulusht_x8(hash, ad, adlen, c, mlen, pnpub, tk1, n);
+  for(int b = 0; b < n; b++) {
+    zeroize(tk1[b], BLOCKBYTES);
+    SET_DOMAIN(tk1[b], 0x44);
+    tk_schedule_1(rtk_1[b], tk1[b]);
+    prtk_1[b] = rtk_1[b];
+    // the tweakey schedule is linear: add LFSR2(TK2) to the precomputed TK3
+    tks_23((uint8_t *)rtk_23[b], hash[b]+BLOCKBYTES, zeros, 0);
+    for(int i = 0; i < SKINNY128_384_ROUNDS*BLOCKBYTES/4; i++)
+      rtk_23[b][i] ^= ((const uint32_t *)ctx[b]->rtk_3[0])[i];
+    rtk_3[b][0] = (const uint8_t *)rtk_23[b];
+    for(int j = 1; j < MASKING_SHARES; j++)
+      rtk_3[b][j] = ctx[b]->rtk_3[j];
+    // mask input block
+    for(int i = 0; i < BLOCKBYTES; i++) {
+      tag_s[b][0][i] = hash[b][i];
+      for(int j = 1; j < MASKING_SHARES; j++) {
+        tag_s[b][0][i] ^= npub[b][j][i];
+        tag_s[b][j][i]  = npub[b][j][i];
+      }
+    }
+  }
+  skinny128_384_plus_masked_x8(tag_s,
+    (const uint8_t (*)[MASKING_SHARES][BLOCKBYTES])tag_s, rtk_3, prtk_1, n);
+  // unmask output tags
+  for(int b = 0; b < n; b++) {
+    for(int i = 0; i < BLOCKBYTES; i++) {
+      tag[b][i] = tag_s[b][0][i];
+      for(int j = 1; j < MASKING_SHARES; j++) {
+        tag[b][i]     ^= tag_s[b][j][i];
+        npub[b][j][i]  = tag_s[b][j][i];
+        npub[b][0][i] ^= tag_s[b][j][i]; // mask again npub for decryption
+      }
+    }
+  }
+}
+
+/**
+ * Generation of the authentication tag from the internal state and additional
+ * data.
+ */
+void romulust_generate_tag(
+  uint8_t *tag,
+  unsigned char *tk1,
+  const unsigned char *ad,
+  unsigned long long adlen,
+  const unsigned char *c,
+  unsigned long long mlen,
+  unsigned char npub[MASKING_SHARES][BLOCKBYTES],
+  const romulust_key_ctx *ctx)
+{
+  romulust_generate_tag_x8((uint8_t (*)[BLOCKBYTES])tag,
+    (unsigned char (*)[BLOCKBYTES])tk1, &ad, &adlen, &c, &mlen,
+    (unsigned char (*)[MASKING_SHARES][BLOCKBYTES])npub, &ctx, 1);
+}
@@ -0,0 +1,157 @@
+#ifndef ROMULUS_H_
+#define ROMULUS_H_
+
+#include "skinny128.h"
+
+#define TAGBYTES    16
+#define KEYBYTES    TWEAKEYBYTES
+
+//maximum number of messages whose masked Skinny calls are batched together
+#define ROMULUST_BATCH  8
+
+#define SET_DOMAIN(tk1, domain) (tk1[7] = (domain))
+
+//G as defined in the Romulus specification in a 32-bit word-wise manner
+#define G(x,y) ({                                                                       \
+    tmp = ((uint32_t*)(y))[0];                                                          \
+    ((uint32_t*)(x))[0] = (tmp >> 1 & 0x7f7f7f7f) ^ ((tmp ^ (tmp << 7)) & 0x80808080);  \
+    tmp = ((uint32_t*)(y))[1];                                                          \
+    ((uint32_t*)(x))[1] = (tmp >> 1 & 0x7f7f7f7f) ^ ((tmp ^ (tmp << 7)) & 0x80808080);  \
+    tmp = ((uint32_t*)(y))[2];                                                          \
+    ((uint32_t*)(x))[2] = (tmp >> 1 & 0x7f7f7f7f) ^ ((tmp ^ (tmp << 7)) & 0x80808080);  \
+    tmp = ((uint32_t*)(y))[3];                                                          \
+    ((uint32_t*)(x))[3] = (tmp >> 1 & 0x7f7f7f7f) ^ ((tmp ^ (tmp << 7)) & 0x80808080);  \
+})
+
+//update the counter in tk1 in a 32-bit word-wise manner
+#define UPDATE_CTR(tk1) ({                                  \
+    tmp = ((uint32_t*)(tk1))[1];                            \
+    ((uint32_t*)(tk1))[1] = (tmp << 1) & 0x00ffffff;        \
+    ((uint32_t*)(tk1))[1] |= (((uint32_t*)(tk1))[0] >> 31); \
+    ((uint32_t*)(tk1))[1] |= tmp & 0xff000000;              \
+    ((uint32_t*)(tk1))[0] <<= 1;                            \
+    if ((tmp >> 23) & 0x01)                                 \
+        ((uint32_t*)(tk1))[0] ^= 0x95;                      \
+})
+
+//x <- y ^ z for 128-bit blocks
+#define XOR_BLOCK(x,y,z) ({                                             \
+    ((uint32_t*)(x))[0] = ((uint32_t*)(y))[0] ^ ((uint32_t*)(z))[0];    \
+    ((uint32_t*)(x))[1] = ((uint32_t*)(y))[1] ^ ((uint32_t*)(z))[1];    \
+    ((uint32_t*)(x))[2] = ((uint32_t*)(y))[2] ^ ((uint32_t*)(z))[2];    \
+    ((uint32_t*)(x))[3] = ((uint32_t*)(y))[3] ^ ((uint32_t*)(z))[3];    \
+})
+
+
+//Rho as defined in the Romulus specification
+//z is absorbed into the state before y is written, so that y = z is supported
+#define RHO(x,y,z,tmp) ({       \
+    G(tmp,x);                   \
+    XOR_BLOCK(x, x, z);         \
+    XOR_BLOCK(y, tmp, z);       \
+})
+
+//Rho inverse as defined in the Romulus specification
+//y is fully read before z is written, so that y = z is supported
+#define RHO_INV(x, y, z, tmp) ({    \
+    G(tmp, x);                      \
+    XOR_BLOCK(z, tmp, y);           \
+    XOR_BLOCK(x, x, z);             \
+})
+
+//Key-only round tweakeys (TK3 schedule of all key shares) which can be
+//precomputed once per key, aligned on cache lines. Only the 1st share
+//includes the round constants.
+typedef struct {
+    uint8_t rtk_3[MASKING_SHARES][SKINNY128_384_ROUNDS*BLOCKBYTES];
+} __attribute__((aligned(64))) romulust_key_ctx;
+
+//Core Romulus-T functions w/ d-th order masking (d = MASKING_ORDER).
+//Masked values are passed as MASKING_SHARES consecutive 16-byte shares.
+void zeroize(uint8_t buf[], int buflen);
+
+int romulusht(
+    unsigned char out[],
+    const unsigned char a[],
+    unsigned long long  adlen,
+    const unsigned char c[],
+    unsigned long long clen,
+    const unsigned char npub[],
+    unsigned char tk1[]);
+
+void romulust_expand_key(
+    romulust_key_ctx *ctx,
+    const unsigned char k[MASKING_SHARES][TWEAKEYBYTES]
+);
+
+void romulust_kdf(
+    uint8_t state[],
+    uint8_t tk1[],
+    unsigned char npub[MASKING_SHARES][BLOCKBYTES],
+    const romulust_key_ctx *ctx
+);
+
+void romulust_process_msg(
+    uint8_t state[],
+    uint8_t tk1[],
+    const unsigned char npub[],
+    unsigned char c[],
+    const unsigned char m[],
+    unsigned long long mlen
+);
+
+void romulust_generate_tag(
+    uint8_t tag[],
+    unsigned char tk1[],
+    const unsigned char ad[],
+    unsigned long long adlen,
+    const unsigned char c[],
+    unsigned long long mlen,
+    unsigned char npub[MASKING_SHARES][BLOCKBYTES],
+    const romulust_key_ctx *ctx
+);
+
+//Batched counterparts of the functions above for up to ROMULUST_BATCH
+//independent messages (possibly under different keys), processed in lock-step.
+void romulusht_x8(
+    unsigned char out[][2*BLOCKBYTES],
+    const unsigned char *const a[],
+    const unsigned long long adlen[],
+    const unsigned char *const c[],
+    const unsigned long long clen[],
+    const unsigned char *const npub[],
+    unsigned char tk1[][BLOCKBYTES],
+    int n
+);
+
+void romulust_process_msg_x8(
+    uint8_t state[][BLOCKBYTES],
+    uint8_t tk1[][BLOCKBYTES],
+    const unsigned char *const npub[],
+    unsigned char *const c[],
+    const unsigned char *const m[],
+    const unsigned long long mlen[],
+    int n
+);
+
+void romulust_kdf_x8(
+    uint8_t state[][BLOCKBYTES],
+    uint8_t tk1[][BLOCKBYTES],
+    unsigned char npub[][MASKING_SHARES][BLOCKBYTES],
+    const romulust_key_ctx *const ctx[],
+    int n
+);
+
+void romulust_generate_tag_x8(
+    uint8_t tag[][BLOCKBYTES],
+    unsigned char tk1[][BLOCKBYTES],
+    const unsigned char *const ad[],
+    const unsigned long long adlen[],
+    const unsigned char *const c[],
+    const unsigned long long mlen[],
+    unsigned char npub[][MASKING_SHARES][BLOCKBYTES],
+    const romulust_key_ctx *const ctx[],
+    int n
+);
+
+#endif  // ROMULUS_H_
\ No newline at end of file
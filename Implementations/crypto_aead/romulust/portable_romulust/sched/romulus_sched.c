@@ -0,0 +1,292 @@
+/**
+ * Length-aware scheduler for the batch API (see 'romulus_sched.h').
+ *
+ * Buckets live in an open-addressing hash table indexed by (operation, AD
+ * blocks, message blocks), each holding a singly-linked list of jobs. When a
+ * bucket is full, its jobs are dispatched at once. On flush, the jobs left in
+ * all buckets are gathered, sorted by (operation, iterations, AD blocks,
+ * message blocks) and dispatched by groups of consecutive jobs, so that the
+ * lanes of a group have as close lengths as possible.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <stdlib.h>
+#include "romulus_sched.h"
+
+#define SCHED_BUCKETS       1024    // power of 2
+#define SCHED_MAX_LOAD      (3*SCHED_BUCKETS/4)
+
+typedef struct {
+    uint64_t ablocks;
+    uint64_t mblocks;
+    uint32_t op;
+    uint32_t count;
+    uint32_t used;
+    romulus_sched_job *head;
+    romulus_sched_job *tail;
+} sched_bucket;
+
+struct romulus_sched {
+    int policy;
+    int ret;
+    size_t max_pending;
+    size_t npending;
+    size_t nbuckets;                        // buckets in use
+    romulus_sched_stats stats;
+    romulus_sched_job **sorted;             // 'max_pending' entries
+    sched_bucket buckets[SCHED_BUCKETS];
+};
+
+static uint64_t nblocks(unsigned long long len)
+{
+    return (len + BLOCKBYTES - 1) / BLOCKBYTES;
+}
+
+/**
+ * Message blocks of a job, the tag being excluded for decryption.
+ */
+static uint64_t job_mblocks(const romulus_sched_job *j)
+{
+    if (j->op == SCHED_DECRYPT)
+        return (j->inlen < TAGBYTES) ? 0 : nblocks(j->inlen - TAGBYTES);
+    return nblocks(j->inlen);
+}
+
+/**
+ * Lock-step iterations of a job: one per message block (at least one) and one
+ * per Romulus-H compression, the nonce being absorbed along with the last
+ * ciphertext block or with the counter.
+ */
+static uint64_t iters(uint64_t ablocks, uint64_t mblocks)
+{
+    return (mblocks ? mblocks : 1) + (ablocks + mblocks + 1) / 2 + 1;
+}
+
+static uint64_t job_iters(const romulus_sched_job *j)
+{
+    return iters(nblocks(j->adlen), job_mblocks(j));
+}
+
+/**
+ * Processes 'n' <= ROMULUST_BATCH jobs of the same operation through the
+ * batch API.
+ */
+static void dispatch(romulus_sched *s, romulus_sched_job *const jobs[],
+    size_t n)
+{
+    size_t b;
+    uint64_t it, max = 0;
+    romulus_sched_job *j;
+    mask_c_uint32_t *out[ROMULUST_BATCH];
+    const mask_m_uint32_t *in[ROMULUST_BATCH];
+    const mask_ad_uint32_t *ad[ROMULUST_BATCH];
+    const mask_npub_uint32_t *npub[ROMULUST_BATCH];
+    const romulust_key_ctx *ctx[ROMULUST_BATCH];
+    unsigned long long inlen[ROMULUST_BATCH], outlen[ROMULUST_BATCH];
+    unsigned long long adlen[ROMULUST_BATCH];
+    int res[ROMULUST_BATCH];
+
+    for(b = 0; b < n; b++) {
+        j = jobs[b];
+        out[b] = j->out;
+        in[b] = j->in;
+        inlen[b] = j->inlen;
+        ad[b] = j->ad;
+        adlen[b] = j->adlen;
+        npub[b] = j->npub;
+        ctx[b] = j->ctx;
+        res[b] = 0;
+        it = job_iters(j);
+        s->stats.lane_iters += it;
+        if (it > max)
+            max = it;
+    }
+    if (jobs[0]->op == SCHED_DECRYPT)
+        s->ret |= crypto_aead_decrypt_shared_batch((mask_m_uint32_t *const *)out,
+            outlen, (const mask_c_uint32_t *const *)in, inlen, ad, adlen, npub,
+            ctx, res, n);
+    else
+        crypto_aead_encrypt_shared_batch(out, outlen, in, inlen, ad, adlen,
+            npub, ctx, n);
+    s->stats.jobs += n;
+    s->stats.groups++;
+    s->stats.full_groups += (n == ROMULUST_BATCH);
+    s->stats.slot_iters += ROMULUST_BATCH*max;
+    for(b = 0; b < n; b++) {
+        j = jobs[b];
+        j->outlen = outlen[b];
+        j->res = res[b];
+        if (j->done)
+            j->done(j, j->arg);
+    }
+}
+
+static int cmp_jobs(const void *a, const void *b)
+{
+    const romulus_sched_job *x = *(romulus_sched_job *const *)a;
+    const romulus_sched_job *y = *(romulus_sched_job *const *)b;
+    uint64_t ix, iy;
+    if (x->op != y->op)
+        return (x->op < y->op) ? -1 : 1;
+    ix = job_iters(x);
+    iy = job_iters(y);
+    if (ix != iy)
+        return (ix < iy) ? -1 : 1;
+    ix = nblocks(x->adlen);
+    iy = nblocks(y->adlen);
+    if (ix != iy)
+        return (ix < iy) ? -1 : 1;
+    return 0;
+}
+
+/**
+ * Dispatches 'n' jobs by groups of consecutive jobs of the same operation.
+ */
+static void dispatch_all(romulus_sched *s, romulus_sched_job *const jobs[],
+    size_t n)
+{
+    size_t i, k;
+    for(i = 0; i < n; i += k) {
+        for(k = 1; k < ROMULUST_BATCH && i + k < n; k++)
+            if (jobs[i+k]->op != jobs[i]->op)
+                break;
+        dispatch(s, jobs + i, k);
+    }
+}
+
+/**
+ * Dispatches the jobs of a bucket and releases it.
+ */
+static void dispatch_bucket(romulus_sched *s, sched_bucket *bk)
+{
+    size_t n = 0;
+    romulus_sched_job *jobs[ROMULUST_BATCH];
+    for(romulus_sched_job *j = bk->head; j != NULL; j = j->next)
+        jobs[n++] = j;
+    s->npending -= n;
+    bk->head = bk->tail = NULL;
+    bk->count = 0;
+    // the slot remains used so that probing sequences are preserved
+    dispatch_all(s, jobs, n);
+}
+
+romulus_sched *romulus_sched_create(int policy, size_t max_pending)
+{
+    romulus_sched *s;
+    if (max_pending == 0)
+        return NULL;
+    s = calloc(1, sizeof(romulus_sched));
+    if (s == NULL)
+        return NULL;
+    s->sorted = malloc(max_pending*sizeof(romulus_sched_job *));
+    if (s->sorted == NULL) {
+        free(s);
+        return NULL;
+    }
+    s->policy = policy;
+    s->max_pending = max_pending;
+    return s;
+}
+
+void romulus_sched_destroy(romulus_sched *s)
+{
+    if (s == NULL)
+        return;
+    romulus_sched_flush(s);
+    free(s->sorted);
+    free(s);
+}
+
+int romulus_sched_flush(romulus_sched *s)
+{
+    int ret;
+    size_t i, n = 0;
+    romulus_sched_job *j;
+    for(i = 0; i < SCHED_BUCKETS; i++) {
+        for(j = s->buckets[i].head; j != NULL; j = j->next)
+            s->sorted[n++] = j;
+        s->buckets[i].head = s->buckets[i].tail = NULL;
+        s->buckets[i].count = 0;
+        s->buckets[i].used = 0;
+    }
+    s->nbuckets = 0;
+    s->npending = 0;
+    // the FIFO policy queues all jobs in the 1st bucket, in submission order
+    if (s->policy == ROMULUS_SCHED_BUCKET)
+        qsort(s->sorted, n, sizeof(romulus_sched_job *), cmp_jobs);
+    dispatch_all(s, s->sorted, n);
+    ret = s->ret;
+    s->ret = 0;
+    return ret;
+}
+
+/**
+ * Returns the bucket of 'j', NULL if the table is too loaded for a new one.
+ */
+static sched_bucket *find_bucket(romulus_sched *s, const romulus_sched_job *j)
+{
+    uint64_t ab = nblocks(j->adlen), mb = job_mblocks(j);
+    size_t h = (size_t)((ab*0x9e3779b97f4a7c15ULL ^ mb*0xc2b2ae3d27d4eb4fULL ^
+        (uint64_t)j->op*0x165667b19e3779f9ULL) >> 32) & (SCHED_BUCKETS - 1);
+    sched_bucket *bk;
+    for(;;) {
+        bk = &s->buckets[h];
+        if (!bk->used)
+            break;
+        if (bk->op == j->op && bk->ablocks == ab && bk->mblocks == mb)
+            return bk;
+        h = (h + 1) & (SCHED_BUCKETS - 1);
+    }
+    if (s->nbuckets >= SCHED_MAX_LOAD)
+        return NULL;
+    s->nbuckets++;
+    bk->used = 1;
+    bk->op = j->op;
+    bk->ablocks = ab;
+    bk->mblocks = mb;
+    return bk;
+}
+
+static void enqueue(sched_bucket *bk, romulus_sched_job *j)
+{
+    j->next = NULL;
+    if (bk->tail != NULL)
+        bk->tail->next = j;
+    else
+        bk->head = j;
+    bk->tail = j;
+    bk->count++;
+}
+
+void romulus_sched_submit(romulus_sched *s, romulus_sched_job *const jobs[],
+    size_t n)
+{
+    sched_bucket *bk;
+    for(size_t i = 0; i < n; i++) {
+        if (s->npending == s->max_pending)
+            romulus_sched_flush(s);
+        if (s->policy == ROMULUS_SCHED_FIFO)
+            bk = &s->buckets[0];
+        else if ((bk = find_bucket(s, jobs[i])) == NULL) {
+            romulus_sched_flush(s);
+            bk = find_bucket(s, jobs[i]);
+        }
+        enqueue(bk, jobs[i]);
+        s->npending++;
+        if (bk->count == ROMULUST_BATCH)
+            dispatch_bucket(s, bk);
+    }
+}
+
+void romulus_sched_get_stats(const romulus_sched *s, romulus_sched_stats *st)
+{
+    *st = s->stats;
+}
+
+double romulus_sched_utilization(const romulus_sched_stats *st)
+{
+    return st->slot_iters ? (double)st->lane_iters / st->slot_iters : 0;
+}
@@ -0,0 +1,82 @@
+#ifndef ROMULUS_SCHED_H_
+#define ROMULUS_SCHED_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "crypto_aead_shared.h"
+
+//Length-aware scheduler on top of 'crypto_aead_{en,de}crypt_shared_batch'.
+//
+//Messages of a batch go through the message encryption and Romulus-H in
+//lock-step, so that a group takes as many iterations as its longest message
+//while the lanes of shorter ones sit idle. Queued jobs are thus bucketed by
+//(operation, AD blocks, message blocks), a bucket being dispatched as soon as
+//it holds ROMULUST_BATCH jobs, i.e. with all lanes finishing together. Jobs
+//left in partial buckets are dispatched on flush (explicit, or once
+//'max_pending' jobs are queued or too many buckets are in use): they are
+//sorted by cost and each group is filled with jobs of the nearest buckets.
+//
+//ROMULUS_SCHED_FIFO disables bucketing (groups of consecutive jobs of the
+//same operation, as the worker pool does) to compare lane utilization.
+//
+//A scheduler is not thread-safe: use one per thread (e.g. per worker).
+#define SCHED_ENCRYPT           0
+#define SCHED_DECRYPT           1
+
+#define ROMULUS_SCHED_BUCKET    0
+#define ROMULUS_SCHED_FIFO      1
+
+typedef struct romulus_sched_job {
+    uint32_t op;
+    mask_c_uint32_t *out;                   // may be equal to 'in'
+    unsigned long long outlen;              // set by the scheduler
+    const mask_m_uint32_t *in;
+    unsigned long long inlen;
+    const mask_ad_uint32_t *ad;
+    unsigned long long adlen;
+    const mask_npub_uint32_t *npub;         // 4 words of NUM_SHARES_NPUB shares
+    const romulust_key_ctx *ctx;
+    int res;                                // set by the scheduler, non-zero
+                                            // if tag verification failed
+    void (*done)(struct romulus_sched_job *j, void *arg);   // may be NULL
+    void *arg;
+    struct romulus_sched_job *next;         // internal
+} romulus_sched_job;
+
+//Lane utilization is estimated from the lock-step iterations of each group:
+//one per message block plus one per Romulus-H compression (AD and ciphertext
+//double blocks, and the final block). The masked calls (KDF and tag) are the
+//same for all lanes and are not accounted for.
+typedef struct {
+    uint64_t jobs;
+    uint64_t groups;
+    uint64_t full_groups;                   // w/ ROMULUST_BATCH jobs
+    uint64_t lane_iters;                    // iterations of the jobs
+    uint64_t slot_iters;                    // ROMULUST_BATCH x iterations of
+                                            // the groups
+} romulus_sched_stats;
+
+typedef struct romulus_sched romulus_sched;
+
+//Returns NULL if allocation fails or 'max_pending' is 0.
+romulus_sched *romulus_sched_create(int policy, size_t max_pending);
+
+//Flushes the queued jobs before releasing the scheduler
+void romulus_sched_destroy(romulus_sched *s);
+
+//Queues 'n' jobs, some of which may be processed (and their 'done' callback
+//called) before returning. Jobs and their buffers must remain valid until
+//their 'done' callback is called.
+void romulus_sched_submit(romulus_sched *s, romulus_sched_job *const jobs[],
+    size_t n);
+
+//Processes all queued jobs. Returns a non-zero value if tag verification
+//failed for at least one decryption since the previous flush.
+int romulus_sched_flush(romulus_sched *s);
+
+void romulus_sched_get_stats(const romulus_sched *s, romulus_sched_stats *st);
+
+//lane_iters / slot_iters, 0 if nothing was processed
+double romulus_sched_utilization(const romulus_sched_stats *st);
+
+#endif  // ROMULUS_SCHED_H_
@@ -0,0 +1,211 @@
+/**
+ * Lane utilization and throughput of the length-aware scheduler (see
+ * 'romulus_sched.h') compared with FIFO batching, on mixed-size traffic.
+ *
+ * Jobs are drawn from a size mix given as comma-separated 'bytes:weight'
+ * pairs (e.g. "64:80,1024:15,4096:5"), their AD length being drawn
+ * uniformly from [0, 32] bytes, and submitted in random order under a few
+ * shared keys. Each policy encrypts the same jobs, then the ciphertexts
+ * of the last run are decrypted through the scheduler and verified.
+ *
+ * Build from the 'portable_romulust' directory:
+ *   cc -O2 -o romulus_sched_bench sched/romulus_sched_bench.c \
+ *      sched/romulus_sched.c bench/bench.c aead.c romulus_t.c skinny128_*.c -I.
+ * Usage:
+ *   romulus_sched_bench [-n <jobs>] [-p <max pending jobs>]
+ *                       [-m <bytes:weight,...>] [-r <rounds>]
+ *                       [-f text|csv|json]
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "randombytes.h"
+#include "bench/bench.h"
+#include "romulus_sched.h"
+
+#define NKEYS           16
+#define MAX_MIX         16
+#define MAX_ADBYTES     32
+
+typedef struct {
+    size_t n;
+    unsigned long long len[MAX_MIX];
+    unsigned weight[MAX_MIX];
+    unsigned total;
+} size_mix;
+
+/**
+ * Parses 'bytes:weight,...' into 'mix'. Returns -1 if malformed.
+ */
+static int parse_mix(size_mix *mix, const char *s)
+{
+    char *end;
+    mix->n = 0;
+    mix->total = 0;
+    while (*s) {
+        if (mix->n == MAX_MIX)
+            return -1;
+        mix->len[mix->n] = strtoull(s, &end, 0);
+        if (*end != ':')
+            return -1;
+        mix->weight[mix->n] = strtoul(end + 1, &end, 0);
+        if (*end != ',' && *end != '\0')
+            return -1;
+        mix->total += mix->weight[mix->n++];
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return mix->total ? 0 : -1;
+}
+
+static unsigned long long draw(const size_mix *mix)
+{
+    unsigned r = rand() % mix->total;
+    size_t i;
+    for(i = 0; r >= mix->weight[i]; i++)
+        r -= mix->weight[i];
+    return mix->len[i];
+}
+
+/**
+ * Runs 'jobs' through a scheduler 'rounds' times, filling 'st' with the
+ * statistics of the last round. Returns the throughput in MB/s.
+ */
+static double run(int policy, size_t max_pending, romulus_sched_job *jobs[],
+    size_t njobs, int rounds, romulus_sched_stats *st)
+{
+    romulus_sched *s;
+    unsigned long long bytes = 0;
+    double t;
+    size_t i;
+
+    for(i = 0; i < njobs; i++)
+        bytes += jobs[i]->inlen;
+    t = bench_now();
+    for(int r = 0; r < rounds; r++) {
+        s = romulus_sched_create(policy, max_pending);
+        if (s == NULL)
+            return 0;
+        romulus_sched_submit(s, jobs, njobs);
+        romulus_sched_flush(s);
+        romulus_sched_get_stats(s, st);
+        romulus_sched_destroy(s);
+    }
+    t = bench_now() - t;
+    return (double)rounds*bytes/t/1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    int opt, rounds = 4, fmt = BENCH_TEXT, ok = 1;
+    size_t i, njobs = 4096, max_pending = 256, stride;
+    size_mix mix;
+    mask_key_uint32_t ks[4*NKEYS];
+    romulust_key_ctx keys[NKEYS];
+    romulus_sched_job *jobs, **pjobs;
+    romulus_sched_stats st;
+    romulus_sched *s;
+    mask_npub_uint32_t (*npub)[4];
+    uint8_t *buf, *ad;
+    bench_result r;
+    static const char *policies[2] = {"bucket", "fifo"};
+
+    parse_mix(&mix, "64:80,1024:15,4096:5");
+    while ((opt = getopt(argc, argv, "n:p:m:r:f:")) != -1) {
+        switch (opt) {
+        case 'n': njobs = strtoul(optarg, NULL, 0); break;
+        case 'p': max_pending = strtoul(optarg, NULL, 0); break;
+        case 'm': if (parse_mix(&mix, optarg)) fmt = -1; break;
+        case 'r': rounds = atoi(optarg); break;
+        case 'f': fmt = bench_parse_format(optarg); break;
+        default: fmt = -1; break;
+        }
+    }
+    if (fmt < 0) {
+        fprintf(stderr, "usage: %s [-n <jobs>] [-p <max pending jobs>] "
+            "[-m <bytes:weight,...>] [-r <rounds>] [-f text|csv|json]\n",
+            argv[0]);
+        return 1;
+    }
+    if (njobs == 0 || max_pending == 0 || rounds <= 0)
+        return 1;
+    stride = 0;
+    for(i = 0; i < mix.n; i++)
+        if (mix.len[i] > stride)
+            stride = mix.len[i];
+    stride = (stride + TAGBYTES + 63) & ~(size_t)63;
+    buf = malloc(njobs*stride);
+    ad = malloc(njobs*MAX_ADBYTES);
+    npub = malloc(njobs*sizeof(*npub));
+    jobs = calloc(njobs, sizeof(romulus_sched_job));
+    pjobs = malloc(njobs*sizeof(romulus_sched_job *));
+    if (buf == NULL || ad == NULL || npub == NULL || jobs == NULL ||
+        pjobs == NULL)
+        return 1;
+    randombytes(buf, njobs*stride);
+    randombytes(ad, njobs*MAX_ADBYTES);
+    randombytes((uint8_t *)npub, njobs*sizeof(*npub));
+    randombytes((uint8_t *)ks, sizeof(ks));
+    romulus_expand_keys(keys, ks, NKEYS);
+    for(i = 0; i < njobs; i++) {
+        romulus_sched_job *j = &jobs[i];
+        j->op = SCHED_ENCRYPT;
+        j->in = (const mask_m_uint32_t *)(buf + i*stride);
+        j->out = (mask_c_uint32_t *)(buf + i*stride);
+        j->inlen = draw(&mix);
+        j->ad = (const mask_ad_uint32_t *)(ad + i*MAX_ADBYTES);
+        j->adlen = rand() % (MAX_ADBYTES + 1);
+        j->npub = npub[i];
+        j->ctx = &keys[i % NKEYS];
+        pjobs[i] = j;
+    }
+    fprintf(stderr, "%zu jobs, at most %zu pending\n", njobs, max_pending);
+
+    bench_init(fmt, "sched");
+    r.name = "encrypt";
+    r.size = njobs;
+    r.size_unit = "jobs";
+    for(int p = 0; p < 2; p++) {
+        r.backend = policies[p];
+        r.mode = "throughput";
+        r.unit = "MB/s";
+        r.value = run(p, max_pending, pjobs, njobs, rounds, &st);
+        bench_report(&r);
+        r.mode = "utilization";
+        r.unit = "%";
+        r.value = 100*romulus_sched_utilization(&st);
+        bench_report(&r);
+        r.mode = "full groups";
+        r.value = 100.0*st.full_groups/st.groups;
+        bench_report(&r);
+    }
+
+    // the buffers hold the ciphertexts of the last encryption (in place)
+    for(i = 0; i < njobs; i++) {
+        jobs[i].op = SCHED_DECRYPT;
+        jobs[i].inlen = jobs[i].outlen;
+    }
+    s = romulus_sched_create(ROMULUS_SCHED_BUCKET, max_pending);
+    if (s == NULL)
+        return 1;
+    romulus_sched_submit(s, pjobs, njobs);
+    if (romulus_sched_flush(s))
+        ok = 0;
+    romulus_sched_destroy(s);
+    for(i = 0; i < njobs; i++)
+        ok &= (jobs[i].res == 0 && jobs[i].outlen + TAGBYTES == jobs[i].inlen);
+    if (!ok)
+        fprintf(stderr, "decryption failed\n");
+
+    free(buf);
+    free(ad);
+    free(npub);
+    free(jobs);
+    free(pjobs);
+    return !ok;
+}
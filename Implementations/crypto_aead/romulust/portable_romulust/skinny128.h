@@ -0,0 +1,355 @@
+#ifndef SKINNY128_H_
+#define SKINNY128_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SKINNY128_384_ROUNDS    40
+#define TWEAKEYBYTES            16
+#define BLOCKBYTES              16
+#define TKPERMORDER             16
+
+// masking order of 'skinny128_384_plus_hom' (d-th order => d+1 shares)
+#ifndef MASKING_ORDER
+#define MASKING_ORDER           1
+#endif
+#define MASKING_SHARES          (MASKING_ORDER + 1)
+
+// random words consumed by 'skinny128_384_plus_hom' (4 ANDs per round, each
+// preceded by a refresh if MASKING_ORDER > 1), plus some slack since the AVX2
+// backend always reads 8 words at once
+#define HOM_RAND_WORDS                                                      \
+    (SKINNY128_384_ROUNDS*4*(MASKING_SHARES*(MASKING_SHARES-1)/2) *         \
+    ((MASKING_SHARES > 2) ? 2 : 1) + 8)
+
+/**
+ * Skinny-128-384+ w/ 1st-order masking (for KDF and tag generation).
+ */
+void skinny128_384_plus_m(
+    uint8_t ctext[BLOCKBYTES],
+    uint8_t ctext_m[BLOCKBYTES],
+    const uint8_t ptext[BLOCKBYTES],
+    const uint8_t ptext_m[BLOCKBYTES],
+    const uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t rtk_3m[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t rtk1[TKPERMORDER*BLOCKBYTES]
+);
+
+/**
+ * Skinny-128-384+ w/ d-th order masking, d = MASKING_ORDER (for KDF and tag
+ * generation when MASKING_ORDER > 1).
+ */
+void skinny128_384_plus_hom(
+    uint8_t ctext[MASKING_SHARES][BLOCKBYTES],
+    const uint8_t ptext[MASKING_SHARES][BLOCKBYTES],
+    const uint8_t *rtk_3[MASKING_SHARES],
+    const uint8_t rtk1[TKPERMORDER*BLOCKBYTES],
+    const uint32_t rnd[HOM_RAND_WORDS]
+);
+
+/**
+ * Up to 8 independent Skinny-128-384+ w/ 1st-order masking (for KDF and tag
+ * generation of several messages at once).
+ *
+ * Masked blocks are passed as 2 consecutive shares. All blocks are processed in
+ * parallel (one per 32-bit lane) if the CPU supports AVX2, one after another
+ * otherwise. Each block comes with its own round tweakeys, which might point
+ * to the same arrays.
+ */
+void skinny128_384_plus_m_x8(
+    uint8_t ctext[][2][BLOCKBYTES],
+    const uint8_t ptext[][2][BLOCKBYTES],
+    const uint8_t *const rtk_23[],
+    const uint8_t *const rtk_3m[],
+    const uint8_t *const rtk1[],
+    int n
+);
+
+/**
+ * Returns 1 if the CPU supports AVX2, 0 otherwise (see
+ * 'skinny128_core_mask_x8.c').
+ */
+int avx2_available(void);
+
+/**
+ * Skinny-128-384+ w/o 1st-order masking (for internal calls).
+ */
+void skinny128_384_plus(
+    uint8_t out[BLOCKBYTES],
+    const uint8_t in[BLOCKBYTES],
+    const uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES]
+);
+
+/**
+ * Two independent Skinny-128-384+ w/o 1st-order masking (for internal calls).
+ *
+ * Both blocks are processed at once by packing their fixsliced representation
+ * into 64-bit words. Each block comes with its own round tweakeys, which might
+ * point to the same arrays.
+ */
+void skinny128_384_plus_x2(
+    uint8_t out_a[BLOCKBYTES],
+    uint8_t out_b[BLOCKBYTES],
+    const uint8_t in_a[BLOCKBYTES],
+    const uint8_t in_b[BLOCKBYTES],
+    const uint8_t rtk_1a[TKPERMORDER*BLOCKBYTES],
+    const uint8_t rtk_23a[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t rtk_1b[TKPERMORDER*BLOCKBYTES],
+    const uint8_t rtk_23b[SKINNY128_384_ROUNDS*BLOCKBYTES]
+);
+
+/**
+ * Up to 8 independent Skinny-128-384+ w/o 1st-order masking (for internal
+ * calls).
+ *
+ * All blocks are processed in parallel (one per 32-bit lane) if the CPU
+ * supports AVX2, by pairs otherwise. Each block comes with its own round
+ * tweakeys, which might point to the same arrays.
+ */
+void skinny128_384_plus_x8(
+    uint8_t *const out[],
+    const uint8_t *const in[],
+    const uint8_t *const rtk_1[],
+    const uint8_t *const rtk_23[],
+    int n
+);
+
+/**
+ * Skinny-128-384+ on n independent blocks, each with its own tweakey (tk1 and
+ * tk2 might be NULL, i.e. all-zero).
+ *
+ * Fully bitsliced implementation processing 64 blocks at once (256 if the CPU
+ * supports AVX2), for bulk workloads where latency does not matter (see
+ * 'skinny128_core_bs.c').
+ */
+void skinny128_384_plus_bs(
+    uint8_t out[][BLOCKBYTES],
+    const uint8_t in[][BLOCKBYTES],
+    const uint8_t tk1[][TWEAKEYBYTES],
+    const uint8_t tk2[][TWEAKEYBYTES],
+    const uint8_t tk3[][TWEAKEYBYTES],
+    size_t n
+);
+
+/**
+ * Keystream engine of Romulus-T: encrypts the same (packed) nonce under the
+ * same TK3 with two TK1 which only differ in the domain separation, the TK1
+ * round tweakeys of the 2nd block being rtk_1 ^ rtk_1d (see
+ * 'skinny128_core_ks.c'). The 1st block is written to 'ks' and the 2nd one
+ * overwrites 'z' (TK3) if 'update' is non-zero.
+ */
+void skinny128_384_plus_ks(
+    uint8_t ks[BLOCKBYTES],
+    uint8_t z[BLOCKBYTES],
+    const uint32_t npub[4],
+    const uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t rtk_1d[TKPERMORDER*BLOCKBYTES],
+    int update
+);
+
+/**
+ * Packing from byte-array to fixsliced representation.
+ */
+void packing(uint32_t s[4], const uint8_t in[BLOCKBYTES]);
+
+/**
+ * Unpacking from fixsliced representation to byte-array.
+ */
+void unpacking(uint8_t out[BLOCKBYTES], uint32_t s[4]);
+
+/**
+ * Precomputes LFSR2(tk2) ^ LFSR3(tk3) for a given number of rounds.
+ * 
+ * Output round tweakeys are in fixsliced representation.
+ */
+void tks_lfsr_23(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const int rounds
+);
+
+/**
+ * Precomputes LFSR3(tk3) for a given number of rounds.
+ * Useful for masking since secret key is passed as TK3 only.
+ * 
+ * Output round tweakeys are in fixsliced representation.
+ */
+void tks_lfsr_3(
+    uint8_t rtk_3[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const int rounds
+);
+
+/**
+ * Apply the tweakey permutation to round tweakeys for 40 rounds.
+ * Also add the round constants at the same time.
+ * 
+ * Input/output round tweakeys are expected to be in fixsliced representation.
+ */
+void tks_perm_23(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES]
+);
+
+/**
+ * Apply the tweakey permutation to round tweakeys for 40 rounds.
+ * 
+ * Input/output round tweakeys are expected to be in fixsliced representation.
+ */
+void tks_perm_23_norc(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES]
+);
+
+/**
+ * Apply the tweakey permutation to round tweakeys for 16 rounds. 
+ * 
+ * Input tk1 is expected to be in byte-wise representation while output round
+ * tweakeys are in fixsliced representation.
+ */
+void tks_perm_1(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES]
+);
+
+/**
+ * Full TK2/TK3 schedule for 40 rounds: 'tks_lfsr_23' (or 'tks_lfsr_3' if tk_2
+ * is NULL) followed by 'tks_perm_23' (or 'tks_perm_23_norc' if rc is 0).
+ */
+void tks_23(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const int rc
+);
+
+/**
+ * TK3 schedule for both shares of a masked key: round constants are only added
+ * to 'rtk_3'.
+ */
+void tks_3_x2(
+    uint8_t rtk_3[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    uint8_t rtk_3m[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const uint8_t tk_3m[TWEAKEYBYTES]
+);
+
+/**
+ * TK3 schedule of 'n' (at most 8) independent tweakeys: round constants are
+ * only added to 'rtk_3[i]' if bit i of 'rc' is set (see 'skinny128_tks_x8.c').
+ */
+void tks_3_x8(
+    uint8_t *const rtk_3[],
+    const uint8_t *const tk_3[],
+    uint32_t rc,
+    int n
+);
+
+/**
+ * GFNI-based counterparts of the functions above (see 'skinny128_gfni.c').
+ * Must only be called if 'gfni_available' returns 1.
+ */
+int gfni_available(void);
+
+void packing_gfni(uint32_t s[4], const uint8_t in[BLOCKBYTES]);
+
+void unpacking_gfni(uint8_t out[BLOCKBYTES], const uint32_t s[4]);
+
+void tks_23_gfni(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES]
+);
+
+void tks_perm_1_gfni(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES]
+);
+
+/**
+ * 2-way TK3 schedule relying on GFNI and AVX2 (see 'skinny128_gfni.c').
+ * Must only be called if 'gfni_avx2_available' returns 1.
+ */
+int gfni_avx2_available(void);
+
+void tks_3_gfni_x2(
+    uint8_t rtk_3a[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    uint8_t rtk_3b[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_3a[TWEAKEYBYTES],
+    const uint8_t tk_3b[TWEAKEYBYTES]
+);
+
+/**
+ * Calculation of round tweakeys related to TK1 only.
+ */
+static inline void tk_schedule_1(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES])
+{
+    tks_perm_1(rtk_1, tk_1);
+};
+
+
+/**
+ * Calculation of round tweakeys related to TK2 and TK3 only w/ 1st-order
+ * masking of TK3.
+ */
+static inline void tk_schedule_13_m(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    uint8_t rtk_3[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    uint8_t rtk_3m[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const uint8_t tk_3m[TWEAKEYBYTES])
+{
+    tks_perm_1(rtk_1, tk_1);
+    tks_3_x2(rtk_3, rtk_3m, tk_3, tk_3m);
+};
+
+/**
+ * Calculation of round tweakeys related to TK1, TK2 and TK3 (full TK schedule)
+ * w/ 1st-order masking of TK3.
+ */
+static inline void tk_schedule_123_m(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    uint8_t rtk_3m[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const uint8_t tk_3m[TWEAKEYBYTES])
+{
+    tks_perm_1(rtk_1, tk_1);
+    tks_23(rtk_23, tk_2, tk_3, 1);
+    tks_23(rtk_3m, NULL, tk_3m, 0);
+};
+
+
+/**
+ * Calculation of round tweakeys related to TK1 and TK3 only.
+ */
+static inline void tk_schedule_13(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    uint8_t rtk_3[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES])
+{
+    tks_perm_1(rtk_1, tk_1);
+    tks_23(rtk_3, NULL, tk_3, 1);
+};
+
+/**
+ * Calculation of round tweakeys related to TK1, TK2 and TK3 (full TK schedule)
+ */
+static inline void tk_schedule_123(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES])
+{
+    tks_perm_1(rtk_1, tk_1);
+    tks_23(rtk_23, tk_2, tk_3, 1);
+};
+
+#endif  // SKINNY128_H_
@@ -0,0 +1,178 @@
+/******************************************************************************
+* Portable C implementation of fixsliced Skinny-128-384+.
+*
+* Straightforward port of 'skinny128_core.s' so that the round tweakeys
+* computed by the tweakey schedule share the exact same representation.
+*
+* For more details, see the paper at
+* https://csrc.nist.gov/CSRC/media/Events/lightweight-cryptography-workshop-2020
+* /documents/papers/fixslicing-lwc2020.pdf
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+******************************************************************************/
+#include "skinny128.h"
+
+#define ROR(x,y) (((x) >> (y)) | ((x) << ((32 - (y)) & 31)))
+
+// swapmove technique for bit manipulations
+#define SWAPMOVE(a, b, mask, n) ({  \
+    tmp = (b ^ (a >> (n))) & (mask);\
+    b ^= tmp;                       \
+    a ^= (tmp << (n));              \
+})
+
+#define LE_LOAD(x, y)                                           \
+    (x) = (((uint32_t)(y)[3] << 24) | ((uint32_t)(y)[2] << 16) |\
+           ((uint32_t)(y)[1] << 8)  |  (y)[0])
+
+#define LE_STORE(x, y)              \
+    (x)[0] = (y) & 0xff;            \
+    (x)[1] = ((y) >> 8) & 0xff;     \
+    (x)[2] = ((y) >> 16) & 0xff;    \
+    (x)[3] = (y) >> 24;
+
+// 8-bit s-box on fixsliced representation (one NOT is saved in the tweakey)
+#define SBOX(in0, in1, in2, in3) ({     \
+    in3 ^= ~(in0 | in1);                \
+    SWAPMOVE(in2, in1, 0x55555555, 1);  \
+    SWAPMOVE(in3, in2, 0x55555555, 1);  \
+    in1 ^= ~(in2 | in3);                \
+    SWAPMOVE(in1, in0, 0x55555555, 1);  \
+    SWAPMOVE(in0, in3, 0x55555555, 1);  \
+    in3 ^= ~(in0 | in1);                \
+    SWAPMOVE(in2, in1, 0x55555555, 1);  \
+    SWAPMOVE(in3, in2, 0x55555555, 1);  \
+    in1 ^= (in2 | in3);                 \
+    SWAPMOVE(in0, in3, 0x55555555, 0);  \
+})
+
+// fixsliced mixcolumns on a single slice
+#define MIXCOL(x, idx0, idx1, idx2, idx3, idx4, idx5) ({    \
+    tmp = ROR(x, idx0) & 0x30303030;                        \
+    x ^= ROR(tmp, idx1);                                    \
+    tmp = ROR(x, idx2) & 0x30303030;                        \
+    x ^= ROR(tmp, idx3);                                    \
+    tmp = ROR(x, idx4) & 0x30303030;                        \
+    x ^= ROR(tmp, idx5);                                    \
+})
+
+#define MIXCOLUMNS(s, idx0, idx1, idx2, idx3, idx4, idx5) ({ \
+    MIXCOL(s[0], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[1], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[2], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[3], idx0, idx1, idx2, idx3, idx4, idx5);       \
+})
+
+// add rtk1 and rtk2 ^ rtk3 to the internal state
+#define ADD_RTK(s, rtk1, rtk23) ({      \
+    s[0] ^= rtk1[0] ^ rtk23[0];         \
+    s[1] ^= rtk1[1] ^ rtk23[1];         \
+    s[2] ^= rtk1[2] ^ rtk23[2];         \
+    s[3] ^= rtk1[3] ^ rtk23[3];         \
+    rtk1 += 4;                          \
+    rtk23 += 4;                         \
+})
+
+/**
+ * Packing from byte-array to fixsliced representation.
+ * Words are loaded in the same order as in 'skinny128_core.s', i.e. the 2nd
+ * and 3rd 32-bit words are swapped.
+ * Relies on GFNI if supported by the CPU.
+ */
+void packing(uint32_t s[4], const uint8_t in[BLOCKBYTES])
+{
+    uint32_t tmp;
+    if (gfni_available()) {
+        packing_gfni(s, in);
+        return;
+    }
+    LE_LOAD(s[0], in);
+    LE_LOAD(s[1], in + 8);
+    LE_LOAD(s[2], in + 4);
+    LE_LOAD(s[3], in + 12);
+    SWAPMOVE(s[0], s[0], 0x0a0a0a0a, 3);
+    SWAPMOVE(s[1], s[1], 0x0a0a0a0a, 3);
+    SWAPMOVE(s[2], s[2], 0x0a0a0a0a, 3);
+    SWAPMOVE(s[3], s[3], 0x0a0a0a0a, 3);
+    SWAPMOVE(s[2], s[0], 0x30303030, 2);
+    SWAPMOVE(s[1], s[0], 0x0c0c0c0c, 4);
+    SWAPMOVE(s[3], s[0], 0x03030303, 6);
+    SWAPMOVE(s[1], s[2], 0x0c0c0c0c, 2);
+    SWAPMOVE(s[3], s[2], 0x03030303, 4);
+    SWAPMOVE(s[3], s[1], 0x03030303, 2);
+}
+
+/**
+ * Unpacking from fixsliced representation to byte-array.
+ * Relies on GFNI if supported by the CPU.
+ */
+void unpacking(uint8_t out[BLOCKBYTES], uint32_t s[4])
+{
+    uint32_t tmp;
+    if (gfni_available()) {
+        unpacking_gfni(out, s);
+        return;
+    }
+    SWAPMOVE(s[3], s[1], 0x03030303, 2);
+    SWAPMOVE(s[3], s[2], 0x03030303, 4);
+    SWAPMOVE(s[1], s[2], 0x0c0c0c0c, 2);
+    SWAPMOVE(s[3], s[0], 0x03030303, 6);
+    SWAPMOVE(s[1], s[0], 0x0c0c0c0c, 4);
+    SWAPMOVE(s[2], s[0], 0x30303030, 2);
+    SWAPMOVE(s[3], s[3], 0x0a0a0a0a, 3);
+    SWAPMOVE(s[2], s[2], 0x0a0a0a0a, 3);
+    SWAPMOVE(s[1], s[1], 0x0a0a0a0a, 3);
+    SWAPMOVE(s[0], s[0], 0x0a0a0a0a, 3);
+    LE_STORE(out, s[0]);
+    LE_STORE(out + 4, s[2]);
+    LE_STORE(out + 8, s[1]);
+    LE_STORE(out + 12, s[3]);
+}
+
+/**
+ * Four consecutive rounds of fixsliced Skinny-128-384+.
+ */
+static void quadruple_round(
+    uint32_t s[4],
+    const uint32_t **rtk1,
+    const uint32_t **rtk23)
+{
+    uint32_t tmp;
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK(s, (*rtk1), (*rtk23));
+    MIXCOLUMNS(s, 30, 24, 18, 2, 6, 4);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK(s, (*rtk1), (*rtk23));
+    MIXCOLUMNS(s, 16, 30, 28, 0, 16, 2);
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK(s, (*rtk1), (*rtk23));
+    MIXCOLUMNS(s, 10, 4, 6, 6, 26, 0);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK(s, (*rtk1), (*rtk23));
+    MIXCOLUMNS(s, 4, 26, 0, 4, 4, 22);
+}
+
+/**
+ * Skinny-128-384+ w/o 1st-order masking (for internal calls).
+ */
+void skinny128_384_plus(
+    uint8_t out[BLOCKBYTES],
+    const uint8_t in[BLOCKBYTES],
+    const uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES])
+{
+    int i;
+    uint32_t s[4];
+    const uint32_t *rtk1 = (const uint32_t *)rtk_1;
+    const uint32_t *rtk23 = (const uint32_t *)rtk_23;
+    packing(s, in);
+    for(i = 0; i < SKINNY128_384_ROUNDS; i += 4) {
+        if ((i % TKPERMORDER) == 0)     // rtk1 repeats every 16 rounds
+            rtk1 = (const uint32_t *)rtk_1;
+        quadruple_round(s, &rtk1, &rtk23);
+    }
+    unpacking(out, s);
+}
@@ -0,0 +1,320 @@
+/*******************************************************************************
+* Fully bitsliced Skinny-128-384+ for large batches of independent blocks.
+*
+* Unlike the fixsliced implementations which process one (or a few) blocks at a
+* time, bit b of cell c of 64 distinct blocks is stored in a single 64-bit word
+* s[8*c + b] (lane l holding block l). Therefore:
+*   - the 8-bit s-box is a pure Boolean circuit of 8 NOR/XOR per cell, the bit
+*     permutations between its iterations being free renamings,
+*   - ShiftRows, MixColumns and the tweakey permutation only move words around
+*     (MixColumns requiring 3 XORs per bit and column),
+*   - every block comes with its own tweakey, whose schedule is also computed
+*     in the bitsliced domain (LFSRs being renamings plus 1 XOR per cell).
+* On AVX2 CPUs (detected at runtime), 256 blocks are processed at once by
+* replacing 64-bit words with 256-bit vectors, each 64-bit element holding a
+* group of 64 blocks.
+*
+* Latency is much higher than for the other implementations (a whole batch is
+* needed to get a single block out) but throughput is maximized: it is meant
+* for offline bulk processing where thousands of blocks are available at once.
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+*******************************************************************************/
+#include "skinny128.h"
+
+#define BS_LANES        64
+#define BS_LANES_X4     256
+
+// round constants (6-bit LFSR), as in the reference implementation
+static const uint8_t rc_bs[SKINNY128_384_ROUNDS] = {
+    0x01, 0x03, 0x07, 0x0f, 0x1f, 0x3e, 0x3d, 0x3b, 0x37, 0x2f,
+    0x1e, 0x3c, 0x39, 0x33, 0x27, 0x0e, 0x1d, 0x3a, 0x35, 0x2b,
+    0x16, 0x2c, 0x18, 0x30, 0x21, 0x02, 0x05, 0x0b, 0x17, 0x2e,
+    0x1c, 0x38, 0x31, 0x23, 0x06, 0x0d, 0x1b, 0x36, 0x2d, 0x1a
+};
+
+// tweakey permutation: cell c of the next round tweakey is cell tk_p[c]
+static const uint8_t tk_p[16] = {
+    9, 15, 8, 13, 10, 14, 12, 11, 0, 1, 2, 3, 4, 5, 6, 7
+};
+
+// 8x8 bit matrix transposition within a 64-bit word (bit j of byte k is
+// swapped with bit k of byte j)
+#define TRANSPOSE8(x) ({                                \
+    t = ((x) ^ ((x) >> 7)) & 0x00aa00aa00aa00aaULL;     \
+    (x) ^= t ^ (t << 7);                                \
+    t = ((x) ^ ((x) >> 14)) & 0x0000cccc0000ccccULL;    \
+    (x) ^= t ^ (t << 14);                               \
+    t = ((x) ^ ((x) >> 28)) & 0x00000000f0f0f0f0ULL;    \
+    (x) ^= t ^ (t << 28);                               \
+})
+
+// 8-bit s-box on the 8 bitsliced words x of a cell, output to y: 4 iterations
+// of 2 NOR/XOR where the bit permutations are merged into the word indexes
+#define SBOX8(y, x) ({                                  \
+    __typeof__((x)[0]) x0 = (x)[0], x1 = (x)[1];        \
+    __typeof__((x)[0]) x2 = (x)[2], x3 = (x)[3];        \
+    __typeof__((x)[0]) x4 = (x)[4], x5 = (x)[5];        \
+    __typeof__((x)[0]) x6 = (x)[6], x7 = (x)[7];        \
+    x4 ^= ~(x7 | x6);                                   \
+    x0 ^= ~(x3 | x2);                                   \
+    x6 ^= ~(x2 | x1);                                   \
+    x5 ^= ~(x4 | x0);                                   \
+    x1 ^= ~(x0 | x3);                                   \
+    x7 ^= ~(x6 | x5);                                   \
+    x3 ^= ~(x5 | x4);                                   \
+    x2 ^= ~(x1 | x7);                                   \
+    (y)[0] = x2; (y)[1] = x7; (y)[2] = x6; (y)[3] = x1; \
+    (y)[4] = x3; (y)[5] = x0; (y)[6] = x4; (y)[7] = x5; \
+})
+
+/**
+ * A full round on the bitsliced state 's', using 'y' as temporary storage.
+ *
+ * The tweakey words are never moved: 'p' maps the cells of the current round
+ * tweakey to their location in 'tk', and the LFSRs only rotate the bits of a
+ * cell, so bit b of cell q of TK2 (resp. TK3) is stored in word
+ * 8*q + ((b + o2[q]) & 7) (resp. o3[q]), the LFSR feedback requiring a single
+ * XOR per cell.
+ */
+#define BS_ROUND(s, y, tk, p, o2, o3, r) ({                                 \
+    for(c = 0; c < 16; c++)                                                 \
+        SBOX8((y) + 8*c, (s) + 8*c);                                        \
+    /* constants: c0 in cell 0, c1 in cell 4 and 0x2 in cell 8 */           \
+    for(b = 0; b < 4; b++)                                                  \
+        if ((rc_bs[r] >> b) & 1)                                            \
+            (y)[b] = ~(y)[b];                                               \
+    for(b = 0; b < 2; b++)                                                  \
+        if ((rc_bs[r] >> (4 + b)) & 1)                                      \
+            (y)[32 + b] = ~(y)[32 + b];                                     \
+    (y)[65] = ~(y)[65];                                                     \
+    /* the round tweakey is added to the first two rows */                  \
+    for(c = 0; c < 8; c++) {                                                \
+        q = (p)[c];                                                         \
+        for(b = 0; b < 8; b++)                                              \
+            (y)[8*c + b] ^= (tk)[0][8*q + b] ^                              \
+                (tk)[1][8*q + ((b + (o2)[q]) & 7)] ^                        \
+                (tk)[2][8*q + ((b + (o3)[q]) & 7)];                         \
+    }                                                                       \
+    for(c = 0; c < 16; c++)                                                 \
+        np[c] = (p)[tk_p[c]];                                               \
+    for(c = 0; c < 16; c++)                                                 \
+        (p)[c] = np[c];                                                     \
+    for(c = 0; c < 8; c++) {                                                \
+        q = (p)[c];                                                         \
+        /* LFSR2: (x6,...,x0,x7^x5) */                                      \
+        (o2)[q] = ((o2)[q] + 7) & 7;                                        \
+        (tk)[1][8*q + (o2)[q]] ^= (tk)[1][8*q + (((o2)[q] + 6) & 7)];       \
+        /* LFSR3: (x0^x6,x7,...,x1) */                                      \
+        (tk)[2][8*q + (o3)[q]] ^= (tk)[2][8*q + (((o3)[q] + 6) & 7)];       \
+        (o3)[q] = ((o3)[q] + 1) & 7;                                        \
+    }                                                                       \
+    /* ShiftRows and MixColumns */                                          \
+    for(c = 0; c < 4; c++) {                                                \
+        for(b = 0; b < 8; b++) {                                            \
+            t = (y)[8*(8 + ((c + 2) & 3)) + b] ^ (y)[8*c + b];              \
+            (s)[8*(12 + c) + b] = t;                                        \
+            (s)[8*(8 + c) + b] = (y)[8*(4 + ((c + 3) & 3)) + b] ^           \
+                (y)[8*(8 + ((c + 2) & 3)) + b];                             \
+            (s)[8*c + b] = (y)[8*(12 + ((c + 1) & 3)) + b] ^ t;             \
+            (s)[8*(4 + c) + b] = (y)[8*c + b];                              \
+        }                                                                   \
+    }                                                                       \
+})
+
+// little-endian 64-bit load (merged into a single load by compilers)
+#define LE_LOAD64(x) (                                                  \
+    (uint64_t)(x)[0]         | ((uint64_t)(x)[1] << 8)  |               \
+    ((uint64_t)(x)[2] << 16) | ((uint64_t)(x)[3] << 24) |               \
+    ((uint64_t)(x)[4] << 32) | ((uint64_t)(x)[5] << 40) |               \
+    ((uint64_t)(x)[6] << 48) | ((uint64_t)(x)[7] << 56))
+
+// 8x8 byte matrix transposition over 8 64-bit words (byte j of w[i] is swapped
+// with byte i of w[j])
+#define TRANSPOSE8_BYTES(w) ({                                          \
+    for(i = 0; i < 4; i++) {                                            \
+        t = (((w)[i] >> 32) ^ (w)[i + 4]) & 0x00000000ffffffffULL;      \
+        (w)[i + 4] ^= t;                                                \
+        (w)[i] ^= t << 32;                                              \
+    }                                                                   \
+    for(i = 0; i < 8; i += (i & 1) ? 3 : 1) {                           \
+        t = (((w)[i] >> 16) ^ (w)[i + 2]) & 0x0000ffff0000ffffULL;      \
+        (w)[i + 2] ^= t;                                                \
+        (w)[i] ^= t << 16;                                              \
+    }                                                                   \
+    for(i = 0; i < 8; i += 2) {                                         \
+        t = (((w)[i] >> 8) ^ (w)[i + 1]) & 0x00ff00ff00ff00ffULL;       \
+        (w)[i + 1] ^= t;                                                \
+        (w)[i] ^= t << 8;                                               \
+    }                                                                   \
+})
+
+/**
+ * Defines 'name' which bitslices up to 64*G 16-byte arrays into 128 words of
+ * type T, each made of G 64-bit elements (element e holding arrays 64*e to
+ * 64*e + 63). Missing lanes are set to 0.
+ *
+ * For each group of 8 arrays, the cells are first gathered (byte transposition)
+ * and bitsliced within 64-bit words (bit transposition), the bytes of the 8
+ * groups being eventually interleaved (byte transposition). All G elements are
+ * transposed at once.
+ */
+#define DEFINE_BS_PACK(name, T, G, ATTR)                                    \
+ATTR static void name(                                                      \
+    T w[128],                                                               \
+    const uint8_t in[][BLOCKBYTES],                                         \
+    size_t n)                                                               \
+{                                                                           \
+    int b, c, e, g, h, i, k;                                                \
+    size_t l;                                                               \
+    T t, v[8], tmp[16][8];                                                  \
+    for(g = 0; g < BS_LANES/8; g++) {                                       \
+        for(h = 0; h < 2; h++) {                                            \
+            for(k = 0; k < 8; k++) {                                        \
+                for(e = 0; e < (G); e++) {                                  \
+                    l = BS_LANES*e + 8*g + k;                               \
+                    ((uint64_t *)&v[k])[e] = (l < n) ?                      \
+                        LE_LOAD64(in[l] + 8*h) : 0;                         \
+                }                                                           \
+            }                                                               \
+            TRANSPOSE8_BYTES(v);                                            \
+            for(c = 0; c < 8; c++) {                                        \
+                TRANSPOSE8(v[c]);                                           \
+                tmp[8*h + c][g] = v[c];                                     \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+    for(c = 0; c < 16; c++) {                                               \
+        TRANSPOSE8_BYTES(tmp[c]);                                           \
+        for(b = 0; b < 8; b++)                                              \
+            w[8*c + b] = tmp[c][b];                                         \
+    }                                                                       \
+}
+
+/**
+ * Defines 'name', the inverse of the function defined by 'DEFINE_BS_PACK' for
+ * the first n lanes.
+ */
+#define DEFINE_BS_UNPACK(name, T, G, ATTR)                                  \
+ATTR static void name(                                                      \
+    uint8_t out[][BLOCKBYTES],                                              \
+    const T w[128],                                                         \
+    size_t n)                                                               \
+{                                                                           \
+    int b, c, e, g, h, i, k;                                                \
+    size_t l;                                                               \
+    T t, v[8], tmp[16][8];                                                  \
+    for(c = 0; c < 16; c++) {                                               \
+        for(b = 0; b < 8; b++)                                              \
+            tmp[c][b] = w[8*c + b];                                         \
+        TRANSPOSE8_BYTES(tmp[c]);                                           \
+    }                                                                       \
+    for(g = 0; g < BS_LANES/8; g++) {                                       \
+        for(h = 0; h < 2; h++) {                                            \
+            for(c = 0; c < 8; c++) {                                        \
+                v[c] = tmp[8*h + c][g];                                     \
+                TRANSPOSE8(v[c]);                                           \
+            }                                                               \
+            TRANSPOSE8_BYTES(v);                                            \
+            for(k = 0; k < 8; k++) {                                        \
+                for(e = 0; e < (G); e++) {                                  \
+                    l = BS_LANES*e + 8*g + k;                               \
+                    if (l < n)                                              \
+                        for(i = 0; i < 8; i++)                              \
+                            out[l][8*h + i] =                               \
+                                (uint8_t)(((uint64_t *)&v[k])[e] >> (8*i)); \
+                }                                                           \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+}
+
+/**
+ * Defines 'name' which encrypts up to 64*G blocks with words of type T (see
+ * 'DEFINE_BS_PACK'), missing TK1/TK2 being 0.
+ */
+#define DEFINE_BS_CORE(name, T, pack, unpack, ATTR)                         \
+ATTR static void name(                                                      \
+    uint8_t out[][BLOCKBYTES],                                              \
+    const uint8_t in[][BLOCKBYTES],                                         \
+    const uint8_t *const tks[3],                                            \
+    size_t n)                                                               \
+{                                                                           \
+    int b, c, q, r;                                                         \
+    uint8_t p[16], np[16], o2[16], o3[16];                                  \
+    T t, s[128], y[128], tk[3][128];                                        \
+    pack(s, in, n);                                                         \
+    for(r = 0; r < 3; r++) {                                                \
+        if (tks[r])                                                         \
+            pack(tk[r], (const uint8_t (*)[BLOCKBYTES])tks[r], n);          \
+        else                                                                \
+            for(c = 0; c < 128; c++)                                        \
+                tk[r][c] = (T){0};                                          \
+    }                                                                       \
+    for(c = 0; c < 16; c++) {                                               \
+        p[c] = c;                                                           \
+        o2[c] = o3[c] = 0;                                                  \
+    }                                                                       \
+    for(r = 0; r < SKINNY128_384_ROUNDS; r++)                               \
+        BS_ROUND(s, y, tk, p, o2, o3, r);                                   \
+    unpack(out, s, n);                                                      \
+}
+
+// 64 blocks in 64-bit words
+DEFINE_BS_PACK(bs_pack, uint64_t, 1, )
+DEFINE_BS_UNPACK(bs_unpack, uint64_t, 1, )
+DEFINE_BS_CORE(skinny128_384_plus_bs64, uint64_t, bs_pack, bs_unpack, )
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+// 4 groups of 64 blocks
+typedef uint64_t bs_x4_t __attribute__((vector_size(32)));
+
+// 256 blocks in 256-bit vectors, relying on AVX2
+DEFINE_BS_PACK(bs_pack_x4, bs_x4_t, 4, AVX2_TARGET)
+DEFINE_BS_UNPACK(bs_unpack_x4, bs_x4_t, 4, AVX2_TARGET)
+DEFINE_BS_CORE(skinny128_384_plus_bs256, bs_x4_t, bs_pack_x4, bs_unpack_x4,
+    AVX2_TARGET)
+
+#endif
+
+/******************************************************************************
+* Skinny-128-384+ on n independent blocks, each with its own tweakey (tk1 and
+* tk2 might be NULL, i.e. all-zero), for offline bulk processing.
+*
+* Blocks are processed by batches of 256 if the CPU supports AVX2, 64
+* otherwise. Inputs and outputs may overlap.
+******************************************************************************/
+void skinny128_384_plus_bs(
+    uint8_t out[][BLOCKBYTES],
+    const uint8_t in[][BLOCKBYTES],
+    const uint8_t tk1[][TWEAKEYBYTES],
+    const uint8_t tk2[][TWEAKEYBYTES],
+    const uint8_t tk3[][TWEAKEYBYTES],
+    size_t n)
+{
+    size_t off = 0, m;
+    const uint8_t *tks[3];
+    while (off < n) {
+        m = n - off;
+        tks[0] = tk1 ? tk1[off] : NULL;
+        tks[1] = tk2 ? tk2[off] : NULL;
+        tks[2] = tk3[off];
+#if defined(__x86_64__) || defined(__i386__)
+        if (m > BS_LANES && avx2_available()) {
+            m = (m > BS_LANES_X4) ? BS_LANES_X4 : m;
+            skinny128_384_plus_bs256(out + off, in + off, tks, m);
+            off += m;
+            continue;
+        }
+#endif
+        m = (m > BS_LANES) ? BS_LANES : m;
+        skinny128_384_plus_bs64(out + off, in + off, tks, m);
+        off += m;
+    }
+}
@@ -0,0 +1,358 @@
+/*******************************************************************************
+* Higher-order masked portable C implementation of fixsliced Skinny-128-384+.
+*
+* The masking order d = MASKING_ORDER is a compile-time parameter and every
+* 32-bit slice is represented by d+1 shares. The shares of a slice are stored
+* in the lanes of a vector so that linear operations (swapmoves, mixcolumns,
+* round tweakey addition) process all shares at once.
+*
+* Non-linear operations rely on the ISW multiplication where the cross products
+* a_i & b_j are computed diagonal by diagonal (i.e. j = i + k mod (d+1)) by
+* rotating the shares across lanes, requiring d(d+1)/2 random words per AND.
+* ORs are computed as ~(~a & ~b), a NOT only flipping the 1st share.
+*
+* If compiled w/ AVX2 support (e.g. -mavx2), shares are stored in the 32-bit
+* lanes of a 256-bit register (up to 8 shares) so that the cost of the linear
+* layer does not depend on the masking order and the one of the ISW AND grows
+* linearly instead of quadratically. Otherwise, GNU C vector extensions are
+* used, the compiler mapping them to whatever SIMD registers are available.
+*
+* The operands of an AND are not independent (e.g. the 2nd NOR of the s-box
+* takes an output of the 1st one as input), which ISW alone does not cover for
+* d > 1. Hence, for d > 1, one operand of each AND is refreshed beforehand by
+* the ISW refresh (d(d+1)/2 more random words). Both gadgets being strong
+* non-interferent (SNI) and the rest of the circuit linear, every AND then
+* takes a fresh sharing of its 2nd operand, so that the whole cipher composes
+* d-probing securely, as in the refresh insertion of Barthe et al. (CCS 2016).
+* This holds in the probing model only: the C compiler is free to rearrange
+* operations on shares, so this file provides functional equivalence but no
+* leakage guarantees.
+*
+* @date     October 2026
+* @author 	Alexandre Adomnicai, alex.adomnicai@gmail.com
+*******************************************************************************/
+#include "skinny128.h"
+
+#define NSHARES     MASKING_SHARES
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#if NSHARES > 8
+#error "AVX2 backend supports up to 8 shares"
+#endif
+
+typedef __m256i sw_t;
+
+// lane i of SW_ROT(x, k) is lane (i + k) mod NSHARES of x
+#define RI(i, k)    (((i) < NSHARES) ? (((i) + (k)) % NSHARES) : (i))
+#define SW_ROT(x, k) (_mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(   \
+    RI(0,k), RI(1,k), RI(2,k), RI(3,k), RI(4,k), RI(5,k), RI(6,k), RI(7,k))))
+
+// -1 in lanes [0, n), 0 elsewhere
+#define LN(i, n)        (((i) < (n)) ? -1 : 0)
+#define LANES(n)        (_mm256_setr_epi32(LN(0,n), LN(1,n), LN(2,n),     \
+    LN(3,n), LN(4,n), LN(5,n), LN(6,n), LN(7,n)))
+
+#define SW_XOR(x, y)    (_mm256_xor_si256(x, y))
+#define SW_AND(x, y)    (_mm256_and_si256(x, y))
+#define SW_OR(x, y)     (_mm256_or_si256(x, y))
+#define SW_ANDC(x, c)   (_mm256_and_si256(x, _mm256_set1_epi32(c)))
+#define SW_SHR(x, n)    (_mm256_srli_epi32(x, n))
+#define SW_SHL(x, n)    (_mm256_slli_epi32(x, n))
+#define SW_NOT(x)       (_mm256_xor_si256(x, _mm256_setr_epi32(-1,0,0,0,0,0,0,0)))
+// loads n random words into lanes [0, n) (reads up to 8 words)
+#define SW_RND(p, n)    (_mm256_and_si256(                                \
+    _mm256_loadu_si256((const __m256i *)(p)), LANES(n)))
+
+static inline sw_t sw_load(const uint32_t x[NSHARES])
+{
+    uint32_t t[8] = {0};
+    for(int i = 0; i < NSHARES; i++)
+        t[i] = x[i];
+    return _mm256_loadu_si256((const __m256i *)t);
+}
+
+static inline void sw_store(uint32_t x[NSHARES], sw_t s)
+{
+    uint32_t t[8];
+    _mm256_storeu_si256((__m256i *)t, s);
+    for(int i = 0; i < NSHARES; i++)
+        x[i] = t[i];
+}
+
+#else
+
+// number of lanes, padded to a power of 2 so that the compiler can map vectors
+// to SIMD registers (if any), unused lanes always being 0
+#if NSHARES <= 2
+#define NLANES      2
+#elif NSHARES <= 4
+#define NLANES      4
+#elif NSHARES <= 8
+#define NLANES      8
+#else
+#define NLANES      16
+#endif
+
+typedef uint32_t sw_t __attribute__((vector_size(4*NLANES)));
+
+#if defined(__GNUC__) && !defined(__clang__)
+// vectors are never passed across translation units
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+// lane i of the output is lane (i + k) mod NSHARES of x
+static inline sw_t sw_rot(const sw_t *x, int k)
+{
+    sw_t y = *x;
+    for(int i = 0; i < NSHARES - k; i++)
+        y[i] = (*x)[i + k];
+    for(int i = NSHARES - k; i < NSHARES; i++)
+        y[i] = (*x)[i + k - NSHARES];
+    return y;
+}
+
+static inline sw_t sw_rnd(const uint32_t *p, int n)
+{
+    sw_t y = {0};
+    for(int i = 0; i < n; i++)
+        y[i] = p[i];
+    return y;
+}
+
+static inline sw_t sw_load(const uint32_t x[NSHARES])
+{
+    return sw_rnd(x, NSHARES);
+}
+
+static inline void sw_store_p(uint32_t x[NSHARES], const sw_t *s)
+{
+    for(int i = 0; i < NSHARES; i++)
+        x[i] = (*s)[i];
+}
+
+#define sw_store(x, s)  (sw_store_p(x, &(s)))
+
+#define SW_ROT(x, k)    ({ sw_t _x = (x); sw_rot(&_x, k); })
+#define SW_XOR(x, y)    ((x) ^ (y))
+#define SW_AND(x, y)    ((x) & (y))
+#define SW_OR(x, y)     ((x) | (y))
+#define SW_ANDC(x, c)   ((x) & (uint32_t)(c))
+#define SW_SHR(x, n)    ((x) >> (n))
+#define SW_SHL(x, n)    ((x) << (n))
+#define SW_NOT(x)       ({ sw_t _y = (x); _y[0] = ~_y[0]; _y; })
+#define SW_RND(p, n)    (sw_rnd(p, n))
+
+#endif
+
+#define SW_ROR(x, n)    (SW_OR(SW_SHR(x, n), SW_SHL(x, (32 - (n)) & 31)))
+
+// swapmove technique for bit manipulations, applied on all shares
+#define SWAPMOVE(a, b, mask, n) ({                          \
+    tmp = SW_ANDC(SW_XOR(b, SW_SHR(a, n)), mask);           \
+    b = SW_XOR(b, tmp);                                     \
+    a = SW_XOR(a, SW_SHL(tmp, n));                          \
+})
+
+#if (NSHARES % 2) == 0
+static const uint32_t all_ones[8] = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff
+};
+#endif
+
+/******************************************************************************
+* ISW multiplication of two masked values. The random words are consumed from
+* '*rnd' (d(d+1)/2 words per call). Operands are passed by address so that no
+* vector crosses a function boundary by value.
+******************************************************************************/
+static inline void secand(
+    sw_t *out,
+    const sw_t *pa, const sw_t *pb,
+    const uint32_t **rnd)
+{
+    int k;
+    sw_t c, r, t;
+    sw_t a = *pa, b = *pb;
+    c = SW_AND(a, b);
+    for(k = 1; 2*k < NSHARES; k++) {
+        r = SW_RND(*rnd, NSHARES);
+        *rnd += NSHARES;
+        // lane i holds (r_{i,i+k} ^ a_i b_{i+k}) ^ a_{i+k} b_i
+        t = SW_XOR(r, SW_AND(a, SW_ROT(b, k)));
+        t = SW_XOR(t, SW_AND(SW_ROT(a, k), b));
+        c = SW_XOR(c, r);
+        c = SW_XOR(c, SW_ROT(t, NSHARES - k));
+    }
+#if (NSHARES % 2) == 0
+    // pairs (i, i+(d+1)/2) only have to be considered for i < (d+1)/2
+    r = SW_RND(*rnd, NSHARES/2);
+    *rnd += NSHARES/2;
+    t = SW_XOR(r, SW_AND(a, SW_ROT(b, NSHARES/2)));
+    t = SW_XOR(t, SW_AND(SW_ROT(a, NSHARES/2), b));
+    t = SW_AND(t, SW_RND(all_ones, NSHARES/2));
+    c = SW_XOR(c, r);
+    c = SW_XOR(c, SW_ROT(t, NSHARES/2));
+#endif
+    *out = c;
+}
+
+/******************************************************************************
+* ISW refresh of a masked value: r_{i,j} is added to shares i and j for i < j,
+* consuming d(d+1)/2 random words from '*rnd' in the same order as 'secand'.
+******************************************************************************/
+static inline void secref(sw_t *x, const uint32_t **rnd)
+{
+    int k;
+    sw_t r, c = *x;
+    for(k = 1; 2*k < NSHARES; k++) {
+        r = SW_RND(*rnd, NSHARES);
+        *rnd += NSHARES;
+        // lane i gets r_{i,i+k} and r_{i-k,i}
+        c = SW_XOR(c, r);
+        c = SW_XOR(c, SW_ROT(r, NSHARES - k));
+    }
+#if (NSHARES % 2) == 0
+    r = SW_RND(*rnd, NSHARES/2);
+    *rnd += NSHARES/2;
+    c = SW_XOR(c, r);
+    c = SW_XOR(c, SW_ROT(r, NSHARES/2));
+#endif
+    *x = c;
+}
+
+// refresh of the 2nd AND operand, useless at 1st order
+#if NSHARES > 2
+#define SECREF(x)       (secref(&(x), rnd))
+#else
+#define SECREF(x)       ((void)0)
+#endif
+
+// in3 ^= ~(in0 | in1) = ~in0 & ~in1
+#define SECNOR_XOR(in3, in0, in1) ({                        \
+    sa = SW_NOT(in0);                                       \
+    sb = SW_NOT(in1);                                       \
+    SECREF(sb);                                             \
+    secand(&tmp, &sa, &sb, rnd);                            \
+    in3 = SW_XOR(in3, tmp);                                 \
+})
+
+// in1 ^= (in2 | in3) = ~(~in2 & ~in3)
+#define SECOR_XOR(in1, in2, in3) ({                         \
+    sa = SW_NOT(in2);                                       \
+    sb = SW_NOT(in3);                                       \
+    SECREF(sb);                                             \
+    secand(&tmp, &sa, &sb, rnd);                            \
+    in1 = SW_XOR(in1, SW_NOT(tmp));                         \
+})
+
+// d-th order secure 8-bit s-box (one NOT is saved in the tweakey)
+#define SBOX_HOM(in0, in1, in2, in3) ({                     \
+    SECNOR_XOR(in3, in0, in1);                              \
+    SWAPMOVE(in2, in1, 0x55555555, 1);                      \
+    SWAPMOVE(in3, in2, 0x55555555, 1);                      \
+    SECNOR_XOR(in1, in2, in3);                              \
+    SWAPMOVE(in1, in0, 0x55555555, 1);                      \
+    SWAPMOVE(in0, in3, 0x55555555, 1);                      \
+    SECNOR_XOR(in3, in0, in1);                              \
+    SWAPMOVE(in2, in1, 0x55555555, 1);                      \
+    SWAPMOVE(in3, in2, 0x55555555, 1);                      \
+    SECOR_XOR(in1, in2, in3);                               \
+    SWAPMOVE(in0, in3, 0x55555555, 0);                      \
+})
+
+#define MIXCOL(x, idx0, idx1, idx2, idx3, idx4, idx5) ({    \
+    tmp = SW_ANDC(SW_ROR(x, idx0), 0x30303030);             \
+    x = SW_XOR(x, SW_ROR(tmp, idx1));                       \
+    tmp = SW_ANDC(SW_ROR(x, idx2), 0x30303030);             \
+    x = SW_XOR(x, SW_ROR(tmp, idx3));                       \
+    tmp = SW_ANDC(SW_ROR(x, idx4), 0x30303030);             \
+    x = SW_XOR(x, SW_ROR(tmp, idx5));                       \
+})
+
+#define MIXCOLUMNS(s, idx0, idx1, idx2, idx3, idx4, idx5) ({ \
+    MIXCOL(s[0], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[1], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[2], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[3], idx0, idx1, idx2, idx3, idx4, idx5);       \
+})
+
+// round tweakeys are interleaved so that all shares are loaded at once
+#define ADD_RTK_HOM(s, rtk) ({                              \
+    s[0] = SW_XOR(s[0], sw_load(rtk[0]));                   \
+    s[1] = SW_XOR(s[1], sw_load(rtk[1]));                   \
+    s[2] = SW_XOR(s[2], sw_load(rtk[2]));                   \
+    s[3] = SW_XOR(s[3], sw_load(rtk[3]));                   \
+    rtk += 4;                                               \
+})
+
+/******************************************************************************
+* Four consecutive rounds of Skinny-128-384+ w/ d-th order masking.
+******************************************************************************/
+static void quadruple_round_hom(
+    sw_t s[4],
+    const uint32_t (**rtk)[NSHARES],
+    const uint32_t **rnd)
+{
+    sw_t tmp, sa, sb;
+    SBOX_HOM(s[0], s[1], s[2], s[3]);
+    ADD_RTK_HOM(s, (*rtk));
+    MIXCOLUMNS(s, 30, 24, 18, 2, 6, 4);
+    SBOX_HOM(s[2], s[3], s[0], s[1]);
+    ADD_RTK_HOM(s, (*rtk));
+    MIXCOLUMNS(s, 16, 30, 28, 0, 16, 2);
+    SBOX_HOM(s[0], s[1], s[2], s[3]);
+    ADD_RTK_HOM(s, (*rtk));
+    MIXCOLUMNS(s, 10, 4, 6, 6, 26, 0);
+    SBOX_HOM(s[2], s[3], s[0], s[1]);
+    ADD_RTK_HOM(s, (*rtk));
+    MIXCOLUMNS(s, 4, 26, 0, 4, 4, 22);
+}
+
+/******************************************************************************
+* Skinny-128-384+ w/ d-th order masking (for KDF and tag generation).
+*
+* 'rtk_3[0]' is expected to include the round constants and the public part of
+* the tweakey (i.e. TK2), the other shares only the key shares (TK3).
+* 'rnd' must contain at least HOM_RAND_WORDS random 32-bit words.
+******************************************************************************/
+void skinny128_384_plus_hom(
+    uint8_t ctext[MASKING_SHARES][BLOCKBYTES],
+    const uint8_t ptext[MASKING_SHARES][BLOCKBYTES],
+    const uint8_t *rtk_3[MASKING_SHARES],
+    const uint8_t rtk1[TKPERMORDER*BLOCKBYTES],
+    const uint32_t rnd[HOM_RAND_WORDS])
+{
+    int i, j;
+    uint32_t p[NSHARES][4];
+    uint32_t w[4][NSHARES];
+    uint32_t rtk[SKINNY128_384_ROUNDS*4][NSHARES];
+    const uint32_t (*prtk)[NSHARES] = rtk;
+    sw_t s[4];
+
+    // interleave the round tweakeys of all shares, rtk1 only goes to share 0
+    for(i = 0; i < SKINNY128_384_ROUNDS*4; i++) {
+        rtk[i][0] = ((const uint32_t *)rtk_3[0])[i] ^
+            ((const uint32_t *)rtk1)[i % (TKPERMORDER*4)];
+        for(j = 1; j < NSHARES; j++)
+            rtk[i][j] = ((const uint32_t *)rtk_3[j])[i];
+    }
+    for(j = 0; j < NSHARES; j++)
+        packing(p[j], ptext[j]);
+    for(i = 0; i < 4; i++) {
+        for(j = 0; j < NSHARES; j++)
+            w[i][j] = p[j][i];
+        s[i] = sw_load(w[i]);
+    }
+    for(i = 0; i < SKINNY128_384_ROUNDS; i += 4)
+        quadruple_round_hom(s, &prtk, &rnd);
+    for(i = 0; i < 4; i++) {
+        sw_store(w[i], s[i]);
+        for(j = 0; j < NSHARES; j++)
+            p[j][i] = w[i][j];
+    }
+    for(j = 0; j < NSHARES; j++)
+        unpacking(ctext[j], p[j]);
+}
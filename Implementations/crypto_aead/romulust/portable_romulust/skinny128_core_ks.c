@@ -0,0 +1,283 @@
+/******************************************************************************
+* Keystream engine of Romulus-T: both Skinny-128-384+ calls made for each
+* message block (keystream with domain 0x40, next key Z with domain 0x41) at
+* once.
+*
+* Both calls only differ in TK1 and encrypt the same nonce under the same TK3
+* (i.e. Z), so that:
+*   - the nonce is packed once per message by the caller,
+*   - the TK3 round tweakeys are computed alongside the rounds from the packed
+*     Z instead of being precomputed for all rounds and stored in memory,
+*     and are shared by both blocks,
+*   - the TK1 round tweakeys of the 2nd block are derived from the ones of the
+*     1st block since the tweakey schedule is linear: they only differ by the
+*     round tweakeys of the domain difference, computed once per message.
+* Both blocks are interleaved into 64-bit words as in 'skinny128_core_x2.c'.
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+******************************************************************************/
+#include "skinny128_tks.h"
+
+// replicates a 32-bit constant into both 32-bit halves
+#define X2(x)   ((uint64_t)(x) * 0x0000000100000001ULL)
+
+// 32-bit rotation of a 32-bit constant
+#define ROR32(x,y)  ((((x) >> (y)) | ((x) << ((32 - (y)) & 31))) & 0xffffffffU)
+
+// ROR(x,y) & m applied independently to both 32-bit halves (m being 32-bit)
+#define ROR_X2(x,y,m) (                                                 \
+    (((x) >> (y)) & X2((m) & (0xffffffffU >> (y))))             |       \
+    (((x) << ((32 - (y)) & 31)) & X2((m) & ~(0xffffffffU >> (y)))))
+
+// swapmove technique for bit manipulations
+#define SWAPMOVE(a, b, mask, n) ({  \
+    tmp = (b ^ (a >> (n))) & (mask);\
+    b ^= tmp;                       \
+    a ^= (tmp << (n));              \
+})
+
+// 8-bit s-box on fixsliced representation (one NOT is saved in the tweakey)
+#define SBOX(in0, in1, in2, in3) ({         \
+    in3 ^= ~(in0 | in1);                    \
+    SWAPMOVE(in2, in1, X2(0x55555555), 1);  \
+    SWAPMOVE(in3, in2, X2(0x55555555), 1);  \
+    in1 ^= ~(in2 | in3);                    \
+    SWAPMOVE(in1, in0, X2(0x55555555), 1);  \
+    SWAPMOVE(in0, in3, X2(0x55555555), 1);  \
+    in3 ^= ~(in0 | in1);                    \
+    SWAPMOVE(in2, in1, X2(0x55555555), 1);  \
+    SWAPMOVE(in3, in2, X2(0x55555555), 1);  \
+    in1 ^= (in2 | in3);                     \
+    SWAPMOVE(in0, in3, X2(0x55555555), 0);  \
+})
+
+// fixsliced mixcolumns on a single slice
+#define MIXCOL(x, idx0, idx1, idx2, idx3, idx4, idx5) ({    \
+    tmp = ROR_X2(x, idx0, 0x30303030U);                     \
+    x ^= ROR_X2(tmp, idx1, ROR32(0x30303030U, idx1));       \
+    tmp = ROR_X2(x, idx2, 0x30303030U);                     \
+    x ^= ROR_X2(tmp, idx3, ROR32(0x30303030U, idx3));       \
+    tmp = ROR_X2(x, idx4, 0x30303030U);                     \
+    x ^= ROR_X2(tmp, idx5, ROR32(0x30303030U, idx5));       \
+})
+
+#define MIXCOLUMNS(s, idx0, idx1, idx2, idx3, idx4, idx5) ({ \
+    MIXCOL(s[0], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[1], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[2], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[3], idx0, idx1, idx2, idx3, idx4, idx5);       \
+})
+
+// add rtk1 ^ rtk3 ^ rc to the 1st block and rtk1 ^ rtk1d ^ rtk3 ^ rc to the
+// 2nd one
+#define ADD_RTK(s, rtk3, rc, rtk1, rtk1d) ({                            \
+    tmp = rtk3[0] ^ rc[0] ^ rtk1[0];                                    \
+    s[0] ^= tmp | ((tmp ^ rtk1d[0]) << 32);                             \
+    tmp = rtk3[1] ^ rc[1] ^ rtk1[1];                                    \
+    s[1] ^= tmp | ((tmp ^ rtk1d[1]) << 32);                             \
+    tmp = rtk3[2] ^ rc[2] ^ rtk1[2];                                    \
+    s[2] ^= tmp | ((tmp ^ rtk1d[2]) << 32);                             \
+    tmp = rtk3[3] ^ rc[3] ^ rtk1[3];                                    \
+    s[3] ^= tmp | ((tmp ^ rtk1d[3]) << 32);                             \
+    rc += 4;                                                            \
+    rtk1 += 4;                                                          \
+    rtk1d += 4;                                                         \
+})
+
+// same as 'ADD_RTK' with round constants already added to rtk3
+#define ADD_RTK_PRE(s, rtk3, rtk1, rtk1d) ({                            \
+    tmp = rtk3[0] ^ rtk1[0];                                            \
+    s[0] ^= tmp | ((tmp ^ rtk1d[0]) << 32);                             \
+    tmp = rtk3[1] ^ rtk1[1];                                            \
+    s[1] ^= tmp | ((tmp ^ rtk1d[1]) << 32);                             \
+    tmp = rtk3[2] ^ rtk1[2];                                            \
+    s[2] ^= tmp | ((tmp ^ rtk1d[2]) << 32);                             \
+    tmp = rtk3[3] ^ rtk1[3];                                            \
+    s[3] ^= tmp | ((tmp ^ rtk1d[3]) << 32);                             \
+    rtk3 += 4;                                                          \
+    rtk1 += 4;                                                          \
+    rtk1d += 4;                                                         \
+})
+
+/**
+ * Computes the TK3 round tweakeys of round i (odd) and i+1 from the packed
+ * tweakey 'tk3', to which LFSR3 is applied in place.
+ * Equivalent to the i-th iteration of 'tks_lfsr_3' followed by 'tk_permute'
+ * and 'tk_store_fs' (see 'skinny128_tks_perm.c'). Once inlined, i is a
+ * constant and all the branches vanish.
+ */
+static inline __attribute__((always_inline)) void tk3_odd_round(
+    uint32_t tk3[4],
+    uint32_t cur[4],
+    uint32_t nxt[4],
+    const int i)
+{
+    int j;
+    uint32_t tmp, tk[4];
+    switch ((i >> 1) & 3) {
+        case 0: LFSR3(tk3[3], tk3[1]); break;
+        case 1: LFSR3(tk3[2], tk3[0]); break;
+        case 2: LFSR3(tk3[1], tk3[3]); break;
+        case 3: LFSR3(tk3[0], tk3[2]); break;
+    }
+    for(j = 0; j < 4; j++) {
+        tmp = tk3[(j + 3 - ((i >> 1) & 3)) & 3];
+        switch (((i + 1) >> 1) & 7) {
+            case 1: tmp = PERM2(tmp); break;
+            case 2: tmp = PERM4(tmp); break;
+            case 3: tmp = PERM6(tmp); break;
+            case 4: tmp = PERM8(tmp); break;
+            case 5: tmp = PERM10(tmp); break;
+            case 6: tmp = PERM12(tmp); break;
+            case 7: tmp = PERM14(tmp); break;
+            default: break;
+        }
+        tk[j] = tmp;
+    }
+    for(j = 0; j < 4; j++) {
+        switch (i & 7) {
+            case 1:
+                cur[j] = ROR(tk[j], 26) & 0xc3c3c3c3;
+                nxt[j ^ 2] = BS2FS_ODD(tk[j], 28, 6, 12);
+                break;
+            case 3:
+                cur[j] = BS2FS_EVEN(tk[j], 14, 4, 6);
+                nxt[j ^ 2] = ROR(tk[j], 16) & 0xf0f0f0f0;
+                break;
+            case 5:
+                cur[j] = ROR(tk[j], 10) & 0xc3c3c3c3;
+                nxt[j ^ 2] = BS2FS_ODD(tk[j], 12, 6, 28);
+                break;
+            case 7:
+                cur[j] = BS2FS_EVEN(tk[j], 30, 4, 22);
+                nxt[j ^ 2] = tk[j] & 0xf0f0f0f0;
+                break;
+        }
+    }
+}
+
+/**
+ * Four consecutive rounds (r to r+3 modulo 16) of fixsliced Skinny-128-384+
+ * on two blocks, 'rtk3' holding the TK3 round tweakey of round r on input and
+ * the one of round r+4 on output.
+ */
+static inline __attribute__((always_inline)) void quadruple_round_ks(
+    uint64_t s[4],
+    uint32_t tk3[4],
+    uint32_t rtk3[4],
+    const uint32_t **rc,
+    const uint32_t *rtk1,
+    const uint32_t *rtk1d,
+    const int r)
+{
+    uint64_t tmp;
+    uint32_t cur[4];
+    const uint32_t *prc = *rc;
+    rtk1 += 4*r;
+    rtk1d += 4*r;
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK(s, rtk3, prc, rtk1, rtk1d);
+    MIXCOLUMNS(s, 30, 24, 18, 2, 6, 4);
+    tk3_odd_round(tk3, cur, rtk3, r + 1);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK(s, cur, prc, rtk1, rtk1d);
+    MIXCOLUMNS(s, 16, 30, 28, 0, 16, 2);
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK(s, rtk3, prc, rtk1, rtk1d);
+    MIXCOLUMNS(s, 10, 4, 6, 6, 26, 0);
+    tk3_odd_round(tk3, cur, rtk3, r + 3);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK(s, cur, prc, rtk1, rtk1d);
+    MIXCOLUMNS(s, 4, 26, 0, 4, 4, 22);
+    *rc = prc;
+}
+
+/**
+ * Four consecutive rounds of fixsliced Skinny-128-384+ on two blocks with
+ * precomputed TK3 round tweakeys (round constants included).
+ */
+static void quadruple_round_ks_pre(
+    uint64_t s[4],
+    const uint32_t **rtk3,
+    const uint32_t **rtk1,
+    const uint32_t **rtk1d)
+{
+    uint64_t tmp;
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK_PRE(s, (*rtk3), (*rtk1), (*rtk1d));
+    MIXCOLUMNS(s, 30, 24, 18, 2, 6, 4);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK_PRE(s, (*rtk3), (*rtk1), (*rtk1d));
+    MIXCOLUMNS(s, 16, 30, 28, 0, 16, 2);
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK_PRE(s, (*rtk3), (*rtk1), (*rtk1d));
+    MIXCOLUMNS(s, 10, 4, 6, 6, 26, 0);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK_PRE(s, (*rtk3), (*rtk1), (*rtk1d));
+    MIXCOLUMNS(s, 4, 26, 0, 4, 4, 22);
+}
+
+/**
+ * Keystream engine of Romulus-T (for internal calls).
+ *
+ * Encrypts the packed nonce 'npub' under TK3 = 'z' with the round tweakeys
+ * 'rtk_1' (1st block) and 'rtk_1' ^ 'rtk_1d' (2nd block). The 1st block is
+ * written to 'ks' and, if 'update' is non-zero, the 2nd one overwrites 'z'.
+ * Equivalent to two calls to 'skinny128_384_plus' with the round tweakeys
+ * computed by 'tk_schedule_13'.
+ *
+ * If the CPU supports GFNI, the TK3 schedule is still precomputed by
+ * 'tks_23' since it is faster than the scalar on-the-fly computation.
+ */
+void skinny128_384_plus_ks(
+    uint8_t ks[BLOCKBYTES],
+    uint8_t z[BLOCKBYTES],
+    const uint32_t npub[4],
+    const uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t rtk_1d[TKPERMORDER*BLOCKBYTES],
+    int update)
+{
+    int i, j;
+    uint32_t w[4], tk3[4], rtk3[4];
+    uint32_t rtk_3[SKINNY128_384_ROUNDS*BLOCKBYTES/4];
+    uint64_t s[4];
+    const uint32_t *rc = rconst_32_fs;
+    const uint32_t *rtk1, *rtk1d, *prtk3 = rtk_3;
+    for(j = 0; j < 4; j++)
+        s[j] = (uint64_t)npub[j] * 0x0000000100000001ULL;
+    if (gfni_available()) {
+        tks_23((uint8_t *)rtk_3, NULL, z, 1);
+        for(i = 0; i < SKINNY128_384_ROUNDS; i += 4) {
+            if ((i % TKPERMORDER) == 0) {   // rtk1 repeats every 16 rounds
+                rtk1 = (const uint32_t *)rtk_1;
+                rtk1d = (const uint32_t *)rtk_1d;
+            }
+            quadruple_round_ks_pre(s, &prtk3, &rtk1, &rtk1d);
+        }
+    } else {
+        rtk1 = (const uint32_t *)rtk_1;
+        rtk1d = (const uint32_t *)rtk_1d;
+        packing(tk3, z);
+        for(j = 0; j < 4; j++)
+            rtk3[j ^ 2] = tk3[j] & 0xf0f0f0f0;
+        for(i = 0; i < SKINNY128_384_ROUNDS; i += TKPERMORDER) {
+            quadruple_round_ks(s, tk3, rtk3, &rc, rtk1, rtk1d, 0);
+            quadruple_round_ks(s, tk3, rtk3, &rc, rtk1, rtk1d, 4);
+            if (i + 8 < SKINNY128_384_ROUNDS) {
+                quadruple_round_ks(s, tk3, rtk3, &rc, rtk1, rtk1d, 8);
+                quadruple_round_ks(s, tk3, rtk3, &rc, rtk1, rtk1d, 12);
+            }
+        }
+    }
+    for(j = 0; j < 4; j++)
+        w[j] = (uint32_t)s[j];
+    unpacking(ks, w);
+    if (update) {
+        for(j = 0; j < 4; j++)
+            w[j] = (uint32_t)(s[j] >> 32);
+        unpacking(z, w);
+    }
+}
@@ -0,0 +1,175 @@
+/*******************************************************************************
+* 1st-order masked portable C implementation of fixsliced Skinny-128-384+.
+*
+* Port of 'skinny128_core_mask.s'. Note that the C compiler is free to
+* rearrange operations on shares, so this file provides functional equivalence
+* with the ARM assembly but not the same leakage guarantees.
+*
+* @date     October 2026
+* @author 	Alexandre Adomnicai, alex.adomnicai@gmail.com
+*******************************************************************************/
+#include "skinny128.h"
+
+#ifdef ROMULUS_LEAKAGE
+// instrumented build for simulated leakage (see 'tvla/romulus_leakage.h')
+#include "tvla/romulus_leakage.h"
+__thread romulus_leak_rec *romulus_leak;
+#define LEAK_STATE(s, sm) ({                                        \
+    LEAK(0, s[0]);  LEAK(1, s[1]);  LEAK(2, s[2]);  LEAK(3, s[3]);  \
+    LEAK(4, sm[0]); LEAK(5, sm[1]); LEAK(6, sm[2]); LEAK(7, sm[3]); \
+})
+#else
+#define LEAK(slot, x)
+#define LEAK_STATE(s, sm)
+#endif
+
+#define ROR(x,y) (((x) >> (y)) | ((x) << ((32 - (y)) & 31)))
+
+#define SWAPMOVE(a, b, mask, n) ({  \
+    tmp = (b ^ (a >> (n))) & (mask);\
+    b ^= tmp;                       \
+    a ^= (tmp << (n));              \
+})
+
+/******************************************************************************
+* 1st-order secure OR between two Boolean masked values. Technique from the
+* paper 'Optimal First-Order Boolean Masking for Embedded IoT Devices' at
+* https://orbilu.uni.lu/bitstream/10993/37740/1/Optimal_Masking.pdf.
+******************************************************************************/
+#define SECORR(z1, z2, x1, x2, y1, y2) ({   \
+    z1 = ((x1) & (y1)) ^ ((x1) | (y2));     \
+    z2 = ((x2) | (y1)) ^ ((x2) & (y2));     \
+    LEAK(8, z1);                            \
+    LEAK(9, z2);                            \
+})
+
+// 1st-order secure 8-bit s-box (one NOT is saved in the tweakey)
+#define SBOX_M(in0, in1, in2, in3, in0m, in1m, in2m, in3m) ({   \
+    SECORR(t, tm, in0, in0m, in1, in1m);                        \
+    in3 = ~(in3 ^ t);                                           \
+    in3m ^= tm;                                                 \
+    SWAPMOVE(in2, in1, 0x55555555, 1);                          \
+    SWAPMOVE(in3, in2, 0x55555555, 1);                          \
+    SWAPMOVE(in2m, in1m, 0x55555555, 1);                        \
+    SWAPMOVE(in3m, in2m, 0x55555555, 1);                        \
+    SECORR(t, tm, in2, in2m, in3, in3m);                        \
+    in1 = ~(in1 ^ t);                                           \
+    in1m ^= tm;                                                 \
+    SWAPMOVE(in1, in0, 0x55555555, 1);                          \
+    SWAPMOVE(in0, in3, 0x55555555, 1);                          \
+    SWAPMOVE(in1m, in0m, 0x55555555, 1);                        \
+    SWAPMOVE(in0m, in3m, 0x55555555, 1);                        \
+    SECORR(t, tm, in0, in0m, in1, in1m);                        \
+    in3 = ~(in3 ^ t);                                           \
+    in3m ^= tm;                                                 \
+    SWAPMOVE(in2, in1, 0x55555555, 1);                          \
+    SWAPMOVE(in3, in2, 0x55555555, 1);                          \
+    SWAPMOVE(in2m, in1m, 0x55555555, 1);                        \
+    SWAPMOVE(in3m, in2m, 0x55555555, 1);                        \
+    SECORR(t, tm, in2, in2m, in3, in3m);                        \
+    in1 ^= t;                                                   \
+    in1m ^= tm;                                                 \
+    SWAPMOVE(in0, in3, 0x55555555, 0);                          \
+    SWAPMOVE(in0m, in3m, 0x55555555, 0);                        \
+})
+
+#define MIXCOL(x, idx0, idx1, idx2, idx3, idx4, idx5) ({    \
+    tmp = ROR(x, idx0) & 0x30303030;                        \
+    x ^= ROR(tmp, idx1);                                    \
+    tmp = ROR(x, idx2) & 0x30303030;                        \
+    x ^= ROR(tmp, idx3);                                    \
+    tmp = ROR(x, idx4) & 0x30303030;                        \
+    x ^= ROR(tmp, idx5);                                    \
+})
+
+#define MIXCOLUMNS(s, idx0, idx1, idx2, idx3, idx4, idx5) ({ \
+    MIXCOL(s[0], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[1], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[2], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[3], idx0, idx1, idx2, idx3, idx4, idx5);       \
+})
+
+// rtk2 ^ rtk3 and rtk1 are added to the 1st share, masked rtk3 to the 2nd
+#define ADD_RTK_M(s, sm, rtk1, rtk23, rtk3m) ({ \
+    s[0] ^= rtk23[0] ^ rtk1[0];                 \
+    s[1] ^= rtk23[1] ^ rtk1[1];                 \
+    s[2] ^= rtk23[2] ^ rtk1[2];                 \
+    s[3] ^= rtk23[3] ^ rtk1[3];                 \
+    sm[0] ^= rtk3m[0];                          \
+    sm[1] ^= rtk3m[1];                          \
+    sm[2] ^= rtk3m[2];                          \
+    sm[3] ^= rtk3m[3];                          \
+    rtk1 += 4;                                  \
+    rtk23 += 4;                                 \
+    rtk3m += 4;                                 \
+})
+
+/******************************************************************************
+* Four consecutive rounds of Skinny-128-384+ w/ 1st-order masking.
+******************************************************************************/
+static void quadruple_round_m(
+    uint32_t s[4],
+    uint32_t sm[4],
+    const uint32_t **rtk1,
+    const uint32_t **rtk23,
+    const uint32_t **rtk3m)
+{
+    uint32_t t, tm, tmp;
+    SBOX_M(s[0], s[1], s[2], s[3], sm[0], sm[1], sm[2], sm[3]);
+    LEAK_STATE(s, sm);
+    ADD_RTK_M(s, sm, (*rtk1), (*rtk23), (*rtk3m));
+    LEAK_STATE(s, sm);
+    MIXCOLUMNS(s, 30, 24, 18, 2, 6, 4);
+    MIXCOLUMNS(sm, 30, 24, 18, 2, 6, 4);
+    LEAK_STATE(s, sm);
+    SBOX_M(s[2], s[3], s[0], s[1], sm[2], sm[3], sm[0], sm[1]);
+    LEAK_STATE(s, sm);
+    ADD_RTK_M(s, sm, (*rtk1), (*rtk23), (*rtk3m));
+    LEAK_STATE(s, sm);
+    MIXCOLUMNS(s, 16, 30, 28, 0, 16, 2);
+    MIXCOLUMNS(sm, 16, 30, 28, 0, 16, 2);
+    LEAK_STATE(s, sm);
+    SBOX_M(s[0], s[1], s[2], s[3], sm[0], sm[1], sm[2], sm[3]);
+    LEAK_STATE(s, sm);
+    ADD_RTK_M(s, sm, (*rtk1), (*rtk23), (*rtk3m));
+    LEAK_STATE(s, sm);
+    MIXCOLUMNS(s, 10, 4, 6, 6, 26, 0);
+    MIXCOLUMNS(sm, 10, 4, 6, 6, 26, 0);
+    LEAK_STATE(s, sm);
+    SBOX_M(s[2], s[3], s[0], s[1], sm[2], sm[3], sm[0], sm[1]);
+    LEAK_STATE(s, sm);
+    ADD_RTK_M(s, sm, (*rtk1), (*rtk23), (*rtk3m));
+    LEAK_STATE(s, sm);
+    MIXCOLUMNS(s, 4, 26, 0, 4, 4, 22);
+    MIXCOLUMNS(sm, 4, 26, 0, 4, 4, 22);
+    LEAK_STATE(s, sm);
+}
+
+/******************************************************************************
+* Skinny-128-384+ w/ 1st-order masking (for KDF and tag generation).
+******************************************************************************/
+void skinny128_384_plus_m(
+    uint8_t ctext[BLOCKBYTES],
+    uint8_t ctext_m[BLOCKBYTES],
+    const uint8_t ptext[BLOCKBYTES],
+    const uint8_t ptext_m[BLOCKBYTES],
+    const uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t rtk_3m[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t rtk1[TKPERMORDER*BLOCKBYTES])
+{
+    int i;
+    uint32_t s[4], sm[4];
+    const uint32_t *rtk_1 = (const uint32_t *)rtk1;
+    const uint32_t *rtk23 = (const uint32_t *)rtk_23;
+    const uint32_t *rtk3m = (const uint32_t *)rtk_3m;
+    packing(s, ptext);
+    packing(sm, ptext_m);
+    LEAK_STATE(s, sm);
+    for(i = 0; i < SKINNY128_384_ROUNDS; i += 4) {
+        if ((i % TKPERMORDER) == 0)     // rtk1 repeats every 16 rounds
+            rtk_1 = (const uint32_t *)rtk1;
+        quadruple_round_m(s, sm, &rtk_1, &rtk23, &rtk3m);
+    }
+    unpacking(ctext, s);
+    unpacking(ctext_m, sm);
+}
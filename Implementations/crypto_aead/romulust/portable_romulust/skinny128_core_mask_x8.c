@@ -0,0 +1,197 @@
+/*******************************************************************************
+* Up to 8 independent Skinny-128-384+ w/ 1st-order masking relying on AVX2.
+*
+* Each 32-bit lane of a 256-bit register holds a fixsliced word of a distinct
+* block. Both shares of a block are kept in separate registers (same lane
+* index), so that the masked s-box is exactly the one from
+* 'skinny128_core_mask.c' where every instruction is replaced by its lane-wise
+* AVX2 counterpart: the 'SECORR' gadget never combines the two shares of the
+* same input within an expression, and lanes never interact with each other.
+* As for the scalar version, the C compiler is free to rearrange operations on
+* shares, so this file provides functional equivalence but not the leakage
+* guarantees of the ARM assembly.
+*
+* Round tweakeys of all blocks are transposed once per call so that each round
+* only requires a single load per word and share (see 'skinny128_x8.h').
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+*******************************************************************************/
+#include "skinny128.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include "skinny128_x8.h"
+
+// 1st-order secure OR between two Boolean masked values (see 'SECORR' in
+// 'skinny128_core_mask.c'), applied independently on each lane
+#define SECORR(z1, z2, x1, x2, y1, y2) ({           \
+    z1 = XOR(AND(x1, y1), OR(x1, y2));              \
+    z2 = XOR(OR(x2, y1), AND(x2, y2));              \
+})
+
+// 1st-order secure 8-bit s-box (one NOT is saved in the tweakey)
+#define SBOX_M(in0, in1, in2, in3, in0m, in1m, in2m, in3m) ({   \
+    SECORR(t, tm, in0, in0m, in1, in1m);                        \
+    in3 = NOT(XOR(in3, t));                                     \
+    in3m = XOR(in3m, tm);                                       \
+    SWAPMOVE(in2, in1, 0x55555555, 1);                          \
+    SWAPMOVE(in3, in2, 0x55555555, 1);                          \
+    SWAPMOVE(in2m, in1m, 0x55555555, 1);                        \
+    SWAPMOVE(in3m, in2m, 0x55555555, 1);                        \
+    SECORR(t, tm, in2, in2m, in3, in3m);                        \
+    in1 = NOT(XOR(in1, t));                                     \
+    in1m = XOR(in1m, tm);                                       \
+    SWAPMOVE(in1, in0, 0x55555555, 1);                          \
+    SWAPMOVE(in0, in3, 0x55555555, 1);                          \
+    SWAPMOVE(in1m, in0m, 0x55555555, 1);                        \
+    SWAPMOVE(in0m, in3m, 0x55555555, 1);                        \
+    SECORR(t, tm, in0, in0m, in1, in1m);                        \
+    in3 = NOT(XOR(in3, t));                                     \
+    in3m = XOR(in3m, tm);                                       \
+    SWAPMOVE(in2, in1, 0x55555555, 1);                          \
+    SWAPMOVE(in3, in2, 0x55555555, 1);                          \
+    SWAPMOVE(in2m, in1m, 0x55555555, 1);                        \
+    SWAPMOVE(in3m, in2m, 0x55555555, 1);                        \
+    SECORR(t, tm, in2, in2m, in3, in3m);                        \
+    in1 = XOR(in1, t);                                          \
+    in1m = XOR(in1m, tm);                                       \
+    SWAPMOVE(in0, in3, 0x55555555, 0);                          \
+    SWAPMOVE(in0m, in3m, 0x55555555, 0);                        \
+})
+
+// rtk1 ^ rtk2 ^ rtk3 (already combined) to the 1st share, rtk3m to the 2nd
+#define ADD_RTK_M(s, sm, rtk, rtkm) ({  \
+    s[0] = XOR(s[0], rtk[0]);           \
+    s[1] = XOR(s[1], rtk[1]);           \
+    s[2] = XOR(s[2], rtk[2]);           \
+    s[3] = XOR(s[3], rtk[3]);           \
+    sm[0] = XOR(sm[0], rtkm[0]);        \
+    sm[1] = XOR(sm[1], rtkm[1]);        \
+    sm[2] = XOR(sm[2], rtkm[2]);        \
+    sm[3] = XOR(sm[3], rtkm[3]);        \
+    rtk += 4;                           \
+    rtkm += 4;                          \
+})
+
+/**
+ * Returns 1 if the CPU supports AVX2, 0 otherwise.
+ */
+int avx2_available(void)
+{
+    static int avx2 = -1;
+    int r = __atomic_load_n(&avx2, __ATOMIC_RELAXED);
+    if (r < 0) {
+        r = __builtin_cpu_supports("avx2") ? 1 : 0;
+        __atomic_store_n(&avx2, r, __ATOMIC_RELAXED);
+    }
+    return r;
+}
+
+/**
+ * Four consecutive rounds of Skinny-128-384+ w/ 1st-order masking on 8 blocks.
+ */
+AVX2_TARGET static void quadruple_round_m_x8(
+    __m256i s[4],
+    __m256i sm[4],
+    const __m256i **rtk,
+    const __m256i **rtkm)
+{
+    __m256i t, tm, tmp;
+    SBOX_M(s[0], s[1], s[2], s[3], sm[0], sm[1], sm[2], sm[3]);
+    ADD_RTK_M(s, sm, (*rtk), (*rtkm));
+    MIXCOLUMNS(s, 30, 24, 18, 2, 6, 4);
+    MIXCOLUMNS(sm, 30, 24, 18, 2, 6, 4);
+    SBOX_M(s[2], s[3], s[0], s[1], sm[2], sm[3], sm[0], sm[1]);
+    ADD_RTK_M(s, sm, (*rtk), (*rtkm));
+    MIXCOLUMNS(s, 16, 30, 28, 0, 16, 2);
+    MIXCOLUMNS(sm, 16, 30, 28, 0, 16, 2);
+    SBOX_M(s[0], s[1], s[2], s[3], sm[0], sm[1], sm[2], sm[3]);
+    ADD_RTK_M(s, sm, (*rtk), (*rtkm));
+    MIXCOLUMNS(s, 10, 4, 6, 6, 26, 0);
+    MIXCOLUMNS(sm, 10, 4, 6, 6, 26, 0);
+    SBOX_M(s[2], s[3], s[0], s[1], sm[2], sm[3], sm[0], sm[1]);
+    ADD_RTK_M(s, sm, (*rtk), (*rtkm));
+    MIXCOLUMNS(s, 4, 26, 0, 4, 4, 22);
+    MIXCOLUMNS(sm, 4, 26, 0, 4, 4, 22);
+}
+
+/**
+ * AVX2 core, unused lanes (i >= n) duplicate the 1st block.
+ * Packing/unpacking are carried out by the single-block routines since they
+ * are negligible compared to the 40 rounds.
+ */
+AVX2_TARGET static void skinny128_384_plus_m_avx2(
+    uint8_t ctext[][2][BLOCKBYTES],
+    const uint8_t ptext[][2][BLOCKBYTES],
+    const uint8_t *const rtk_23[],
+    const uint8_t *const rtk_3m[],
+    const uint8_t *const rtk1[],
+    int n)
+{
+    int i, j;
+    uint32_t w[8][4], wm[8][4];
+    const uint8_t *rtk_23_x8[8], *rtk_3m_x8[8], *rtk1_x8[8];
+    __m256i rtk[SKINNY128_384_ROUNDS*4], rtkm[SKINNY128_384_ROUNDS*4];
+    __m256i s[4], sm[4];
+    const __m256i *prtk = rtk, *prtkm = rtkm;
+
+    for(i = 0; i < 8; i++) {
+        j = (i < n) ? i : 0;
+        rtk_23_x8[i] = rtk_23[j];
+        rtk_3m_x8[i] = rtk_3m[j];
+        rtk1_x8[i] = rtk1[j];
+        packing(w[i], ptext[j][0]);
+        packing(wm[i], ptext[j][1]);
+    }
+    interleave_rtk_x8(rtk, rtk_23_x8, rtk1_x8);
+    interleave_rtk_x8(rtkm, rtk_3m_x8, NULL);
+    load_x8(s, (const uint32_t (*)[4])w);
+    load_x8(sm, (const uint32_t (*)[4])wm);
+    for(i = 0; i < SKINNY128_384_ROUNDS; i += 4)
+        quadruple_round_m_x8(s, sm, &prtk, &prtkm);
+    store_x8(w, s);
+    store_x8(wm, sm);
+    for(i = 0; i < n; i++) {
+        unpacking(ctext[i][0], w[i]);
+        unpacking(ctext[i][1], wm[i]);
+    }
+}
+
+#else
+
+int avx2_available(void)
+{
+    return 0;
+}
+
+#endif
+
+/******************************************************************************
+* Up to 8 independent Skinny-128-384+ w/ 1st-order masking (for KDF and tag
+* generation of several messages at once).
+*
+* Falls back on 'skinny128_384_plus_m' for a single block or if AVX2 is not
+* supported. Inputs and outputs may overlap.
+******************************************************************************/
+void skinny128_384_plus_m_x8(
+    uint8_t ctext[][2][BLOCKBYTES],
+    const uint8_t ptext[][2][BLOCKBYTES],
+    const uint8_t *const rtk_23[],
+    const uint8_t *const rtk_3m[],
+    const uint8_t *const rtk1[],
+    int n)
+{
+    int i;
+#if defined(__x86_64__) || defined(__i386__)
+    if (n > 1 && avx2_available()) {
+        skinny128_384_plus_m_avx2(ctext, ptext, rtk_23, rtk_3m, rtk1, n);
+        return;
+    }
+#endif
+    for(i = 0; i < n; i++)
+        skinny128_384_plus_m(ctext[i][0], ctext[i][1], ptext[i][0],
+            ptext[i][1], rtk_23[i], rtk_3m[i], rtk1[i]);
+}
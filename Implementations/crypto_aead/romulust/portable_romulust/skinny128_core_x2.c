@@ -0,0 +1,147 @@
+/******************************************************************************
+* Portable C implementation of fixsliced Skinny-128-384+ processing two blocks
+* in parallel.
+*
+* Each 32-bit slice of the fixsliced representation only involves shifts that
+* never cross a byte boundary (swapmove) or rotations over 32 bits (mixcolumns).
+* Therefore, two independent states can be interleaved into 64-bit words (1st
+* block in the lower halves, 2nd block in the upper halves) so that a 64-bit
+* CPU runs two Skinny-128-384+ instances for almost the cost of one.
+*
+* Round tweakeys are shared with 'skinny128_core.c' and the tweakey schedule.
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+******************************************************************************/
+#include "skinny128.h"
+
+// replicates a 32-bit constant into both 32-bit halves
+#define X2(x)   ((uint64_t)(x) * 0x0000000100000001ULL)
+
+// 32-bit rotation of a 32-bit constant
+#define ROR32(x,y)  ((((x) >> (y)) | ((x) << ((32 - (y)) & 31))) & 0xffffffffU)
+
+// ROR(x,y) & m applied independently to both 32-bit halves (m being 32-bit)
+#define ROR_X2(x,y,m) (                                                 \
+    (((x) >> (y)) & X2((m) & (0xffffffffU >> (y))))             |       \
+    (((x) << ((32 - (y)) & 31)) & X2((m) & ~(0xffffffffU >> (y)))))
+
+// swapmove technique for bit manipulations
+#define SWAPMOVE(a, b, mask, n) ({  \
+    tmp = (b ^ (a >> (n))) & (mask);\
+    b ^= tmp;                       \
+    a ^= (tmp << (n));              \
+})
+
+// 8-bit s-box on fixsliced representation (one NOT is saved in the tweakey)
+#define SBOX(in0, in1, in2, in3) ({         \
+    in3 ^= ~(in0 | in1);                    \
+    SWAPMOVE(in2, in1, X2(0x55555555), 1);  \
+    SWAPMOVE(in3, in2, X2(0x55555555), 1);  \
+    in1 ^= ~(in2 | in3);                    \
+    SWAPMOVE(in1, in0, X2(0x55555555), 1);  \
+    SWAPMOVE(in0, in3, X2(0x55555555), 1);  \
+    in3 ^= ~(in0 | in1);                    \
+    SWAPMOVE(in2, in1, X2(0x55555555), 1);  \
+    SWAPMOVE(in3, in2, X2(0x55555555), 1);  \
+    in1 ^= (in2 | in3);                     \
+    SWAPMOVE(in0, in3, X2(0x55555555), 0);  \
+})
+
+// fixsliced mixcolumns on a single slice
+#define MIXCOL(x, idx0, idx1, idx2, idx3, idx4, idx5) ({    \
+    tmp = ROR_X2(x, idx0, 0x30303030U);                     \
+    x ^= ROR_X2(tmp, idx1, ROR32(0x30303030U, idx1));       \
+    tmp = ROR_X2(x, idx2, 0x30303030U);                     \
+    x ^= ROR_X2(tmp, idx3, ROR32(0x30303030U, idx3));       \
+    tmp = ROR_X2(x, idx4, 0x30303030U);                     \
+    x ^= ROR_X2(tmp, idx5, ROR32(0x30303030U, idx5));       \
+})
+
+#define MIXCOLUMNS(s, idx0, idx1, idx2, idx3, idx4, idx5) ({ \
+    MIXCOL(s[0], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[1], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[2], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[3], idx0, idx1, idx2, idx3, idx4, idx5);       \
+})
+
+// add rtk1 and rtk2 ^ rtk3 of each block to their respective halves
+#define ADD_RTK(s, rtk1a, rtk23a, rtk1b, rtk23b) ({                     \
+    s[0] ^= (uint64_t)(rtk1a[0] ^ rtk23a[0]) |                          \
+            ((uint64_t)(rtk1b[0] ^ rtk23b[0]) << 32);                   \
+    s[1] ^= (uint64_t)(rtk1a[1] ^ rtk23a[1]) |                          \
+            ((uint64_t)(rtk1b[1] ^ rtk23b[1]) << 32);                   \
+    s[2] ^= (uint64_t)(rtk1a[2] ^ rtk23a[2]) |                          \
+            ((uint64_t)(rtk1b[2] ^ rtk23b[2]) << 32);                   \
+    s[3] ^= (uint64_t)(rtk1a[3] ^ rtk23a[3]) |                          \
+            ((uint64_t)(rtk1b[3] ^ rtk23b[3]) << 32);                   \
+    rtk1a += 4;                                                         \
+    rtk23a += 4;                                                        \
+    rtk1b += 4;                                                         \
+    rtk23b += 4;                                                        \
+})
+
+/**
+ * Four consecutive rounds of fixsliced Skinny-128-384+ on two blocks.
+ */
+static void quadruple_round_x2(
+    uint64_t s[4],
+    const uint32_t *rtk[4])
+{
+    uint64_t tmp;
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK(s, rtk[0], rtk[1], rtk[2], rtk[3]);
+    MIXCOLUMNS(s, 30, 24, 18, 2, 6, 4);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK(s, rtk[0], rtk[1], rtk[2], rtk[3]);
+    MIXCOLUMNS(s, 16, 30, 28, 0, 16, 2);
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK(s, rtk[0], rtk[1], rtk[2], rtk[3]);
+    MIXCOLUMNS(s, 10, 4, 6, 6, 26, 0);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK(s, rtk[0], rtk[1], rtk[2], rtk[3]);
+    MIXCOLUMNS(s, 4, 26, 0, 4, 4, 22);
+}
+
+/**
+ * Two independent Skinny-128-384+ w/o 1st-order masking (for internal calls).
+ *
+ * Packing/unpacking are carried out on 32-bit halves by the single-block
+ * routines since they are negligible compared to the 40 rounds.
+ */
+void skinny128_384_plus_x2(
+    uint8_t out_a[BLOCKBYTES],
+    uint8_t out_b[BLOCKBYTES],
+    const uint8_t in_a[BLOCKBYTES],
+    const uint8_t in_b[BLOCKBYTES],
+    const uint8_t rtk_1a[TKPERMORDER*BLOCKBYTES],
+    const uint8_t rtk_23a[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t rtk_1b[TKPERMORDER*BLOCKBYTES],
+    const uint8_t rtk_23b[SKINNY128_384_ROUNDS*BLOCKBYTES])
+{
+    int i;
+    uint32_t sa[4], sb[4];
+    uint64_t s[4];
+    const uint32_t *rtk[4] = {0};
+    packing(sa, in_a);
+    packing(sb, in_b);
+    for(i = 0; i < 4; i++)
+        s[i] = (uint64_t)sa[i] | ((uint64_t)sb[i] << 32);
+    rtk[1] = (const uint32_t *)rtk_23a;
+    rtk[3] = (const uint32_t *)rtk_23b;
+    for(i = 0; i < SKINNY128_384_ROUNDS; i += 4) {
+        if ((i % TKPERMORDER) == 0) {   // rtk1 repeats every 16 rounds
+            rtk[0] = (const uint32_t *)rtk_1a;
+            rtk[2] = (const uint32_t *)rtk_1b;
+        }
+        quadruple_round_x2(s, rtk);
+    }
+    for(i = 0; i < 4; i++) {
+        sa[i] = (uint32_t)s[i];
+        sb[i] = (uint32_t)(s[i] >> 32);
+    }
+    unpacking(out_a, sa);
+    unpacking(out_b, sb);
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************
+* Up to 8 independent Skinny-128-384+ w/o masking relying on AVX2.
+*
+* Each 32-bit lane of a 256-bit register holds a fixsliced word of a distinct
+* block (see 'skinny128_x8.h'), each block coming with its own round
+* tweakeys. Meant for running several Romulus-T messages in lock-step, where
+* every message contributes one or two independent blocks per step.
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+*******************************************************************************/
+#include "skinny128.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include "skinny128_x8.h"
+
+// 8-bit s-box on fixsliced representation (one NOT is saved in the tweakey)
+#define SBOX(in0, in1, in2, in3) ({         \
+    in3 = XOR(in3, NOT(OR(in0, in1)));      \
+    SWAPMOVE(in2, in1, 0x55555555, 1);      \
+    SWAPMOVE(in3, in2, 0x55555555, 1);      \
+    in1 = XOR(in1, NOT(OR(in2, in3)));      \
+    SWAPMOVE(in1, in0, 0x55555555, 1);      \
+    SWAPMOVE(in0, in3, 0x55555555, 1);      \
+    in3 = XOR(in3, NOT(OR(in0, in1)));      \
+    SWAPMOVE(in2, in1, 0x55555555, 1);      \
+    SWAPMOVE(in3, in2, 0x55555555, 1);      \
+    in1 = XOR(in1, OR(in2, in3));           \
+    SWAPMOVE(in0, in3, 0x55555555, 0);      \
+})
+
+// rtk1 ^ rtk2 ^ rtk3 (already combined)
+#define ADD_RTK(s, rtk) ({          \
+    s[0] = XOR(s[0], rtk[0]);       \
+    s[1] = XOR(s[1], rtk[1]);       \
+    s[2] = XOR(s[2], rtk[2]);       \
+    s[3] = XOR(s[3], rtk[3]);       \
+    rtk += 4;                       \
+})
+
+/**
+ * Four consecutive rounds of Skinny-128-384+ on 8 blocks.
+ */
+AVX2_TARGET static void quadruple_round_x8(
+    __m256i s[4],
+    const __m256i **rtk)
+{
+    __m256i tmp;
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK(s, (*rtk));
+    MIXCOLUMNS(s, 30, 24, 18, 2, 6, 4);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK(s, (*rtk));
+    MIXCOLUMNS(s, 16, 30, 28, 0, 16, 2);
+    SBOX(s[0], s[1], s[2], s[3]);
+    ADD_RTK(s, (*rtk));
+    MIXCOLUMNS(s, 10, 4, 6, 6, 26, 0);
+    SBOX(s[2], s[3], s[0], s[1]);
+    ADD_RTK(s, (*rtk));
+    MIXCOLUMNS(s, 4, 26, 0, 4, 4, 22);
+}
+
+/**
+ * AVX2 core, unused lanes (i >= n) duplicate the 1st block.
+ */
+AVX2_TARGET static void skinny128_384_plus_avx2(
+    uint8_t *const out[],
+    const uint8_t *const in[],
+    const uint8_t *const rtk_1[],
+    const uint8_t *const rtk_23[],
+    int n)
+{
+    int i, j;
+    uint32_t w[8][4];
+    const uint8_t *rtk_1_x8[8], *rtk_23_x8[8];
+    __m256i rtk[SKINNY128_384_ROUNDS*4];
+    __m256i s[4];
+    const __m256i *prtk = rtk;
+
+    for(i = 0; i < 8; i++) {
+        j = (i < n) ? i : 0;
+        rtk_1_x8[i] = rtk_1[j];
+        rtk_23_x8[i] = rtk_23[j];
+        packing(w[i], in[j]);
+    }
+    interleave_rtk_x8(rtk, rtk_23_x8, rtk_1_x8);
+    load_x8(s, (const uint32_t (*)[4])w);
+    for(i = 0; i < SKINNY128_384_ROUNDS; i += 4)
+        quadruple_round_x8(s, &prtk);
+    store_x8(w, s);
+    for(i = 0; i < n; i++)
+        unpacking(out[i], w[i]);
+}
+
+#endif
+
+/******************************************************************************
+* Up to 8 independent Skinny-128-384+ w/o masking (for internal calls).
+*
+* Relies on AVX2 if supported by the CPU and if more than 2 blocks are to be
+* processed, on 'skinny128_384_plus_x2' otherwise. Inputs and outputs may
+* overlap.
+******************************************************************************/
+void skinny128_384_plus_x8(
+    uint8_t *const out[],
+    const uint8_t *const in[],
+    const uint8_t *const rtk_1[],
+    const uint8_t *const rtk_23[],
+    int n)
+{
+    int i;
+#if defined(__x86_64__) || defined(__i386__)
+    if (n > 2 && avx2_available()) {
+        skinny128_384_plus_avx2(out, in, rtk_1, rtk_23, n);
+        return;
+    }
+#endif
+    for(i = 0; i + 1 < n; i += 2)
+        skinny128_384_plus_x2(out[i], out[i+1], in[i], in[i+1],
+            rtk_1[i], rtk_23[i], rtk_1[i+1], rtk_23[i+1]);
+    if (i < n)
+        skinny128_384_plus(out[i], in[i], rtk_1[i], rtk_23[i]);
+}
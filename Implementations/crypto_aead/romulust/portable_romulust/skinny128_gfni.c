@@ -0,0 +1,377 @@
+/*******************************************************************************
+* Bit shuffles of fixsliced Skinny-128-384+ relying on the x86 GFNI extension.
+*
+* The 'gf2p8affineqb' instruction multiplies each byte by an 8x8 bit matrix
+* taken from the corresponding 64-bit lane. When the data is passed as the
+* matrix operand, it allows to transpose 8x8 bit matrices in a single
+* instruction, which is the core of the (un)packing into fixsliced form:
+*   - packing = pshufb + 1 swapmove + gf2p8affineqb + pshufb
+*   - unpacking = pshufb + gf2p8affineqb + 1 swapmove + pshufb
+*
+* The tweakey schedule is computed in the byte-wise representation, where the
+* tweakey permutation is a byte shuffle and the LFSRs are affine maps on bytes,
+* and each round tweakey is then packed and aligned with the fixslicing.
+*
+* All functions are only called if 'gfni_available' returns 1 (or
+* 'gfni_avx2_available' for the 2-way tweakey schedule).
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+*******************************************************************************/
+#include "skinny128.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define GFNI_TARGET __attribute__((target("gfni,ssse3")))
+
+// 8x8 bit matrices for gf2p8affineqb
+#define GFNI_PACK           0x1020408001020408ULL
+#define GFNI_UNPACK         0x0102040810204080ULL
+#define GFNI_LFSR2          0xa001020408102040ULL
+#define GFNI_LFSR3          0x0204081020408041ULL
+
+#define ROR_X4(x, n)                                                        \
+    (_mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, (32 - (n)) & 31)))
+
+// swaps the two 64-bit halves (i.e. words 0,1 with words 2,3)
+#define SWAP_X4(x)  (_mm_shuffle_epi32(x, 0x4e))
+
+#define AND_X4(x, m) (_mm_and_si128(x, _mm_set1_epi32(m)))
+
+// bitmasks and rotations to match fixslicing (odd rounds)
+#define BS2FS_ODD(x, sh0, sh1, sh2) (_mm_or_si128(                          \
+    AND_X4(ROR_X4(x, sh0), 0x03030303),                                     \
+    ROR_X4(AND_X4(x, 0x03030303U << (sh1)), sh2)))
+
+// bitmasks and rotations to match fixslicing (even rounds)
+#define BS2FS_EVEN(x, sh0, sh1, sh2) (_mm_or_si128(                         \
+    AND_X4(ROR_X4(x, sh0), 0x30303030),                                     \
+    ROR_X4(AND_X4(x, (0x30303030U >> (sh1)) | (0x30303030U << (32-(sh1)))), \
+        sh2)))
+
+/**
+ * Returns 1 if the CPU supports both SSSE3 and GFNI, 0 otherwise.
+ * The result is cached atomically as it may be queried by several threads.
+ */
+int gfni_available(void)
+{
+    static int gfni = -1;
+    unsigned int a, b, c, d;
+    int r = __atomic_load_n(&gfni, __ATOMIC_RELAXED);
+    if (r < 0) {
+        r = __get_cpuid(1, &a, &b, &c, &d) && (c & bit_SSSE3) &&
+            __get_cpuid_count(7, 0, &a, &b, &c, &d) && (c & bit_GFNI);
+        __atomic_store_n(&gfni, r, __ATOMIC_RELAXED);
+    }
+    return r;
+}
+
+GFNI_TARGET static inline __m128i pack_x4(__m128i x)
+{
+    __m128i t;
+    x = _mm_shuffle_epi8(x,
+        _mm_setr_epi8(1, 0, 5, 4, 9, 8, 13, 12, 3, 2, 7, 6, 11, 10, 15, 14));
+    t = _mm_xor_si128(x, _mm_srli_epi64(x, 12));
+    t = _mm_and_si128(t, _mm_set1_epi64x(0x000f000f000f000fULL));
+    x = _mm_xor_si128(x, _mm_xor_si128(t, _mm_slli_epi64(t, 12)));
+    x = _mm_gf2p8affine_epi64_epi8(_mm_set1_epi64x(GFNI_PACK), x, 0);
+    return _mm_shuffle_epi8(x,
+        _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15));
+}
+
+GFNI_TARGET static inline __m128i unpack_x4(__m128i x)
+{
+    __m128i t;
+    x = _mm_shuffle_epi8(x,
+        _mm_setr_epi8(1, 5, 9, 13, 0, 4, 8, 12, 3, 7, 11, 15, 2, 6, 10, 14));
+    x = _mm_gf2p8affine_epi64_epi8(_mm_set1_epi64x(GFNI_UNPACK), x, 0);
+    t = _mm_xor_si128(x, _mm_srli_epi64(x, 12));
+    t = _mm_and_si128(t, _mm_set1_epi64x(0x000f000f000f000fULL));
+    x = _mm_xor_si128(x, _mm_xor_si128(t, _mm_slli_epi64(t, 12)));
+    return _mm_shuffle_epi8(x,
+        _mm_setr_epi8(1, 0, 9, 8, 3, 2, 11, 10, 5, 4, 13, 12, 7, 6, 15, 14));
+}
+
+/**
+ * Packing from byte-array to fixsliced representation.
+ */
+GFNI_TARGET void packing_gfni(uint32_t s[4], const uint8_t in[BLOCKBYTES])
+{
+    __m128i x = _mm_loadu_si128((const __m128i *)in);
+    _mm_storeu_si128((__m128i *)s, pack_x4(x));
+}
+
+/**
+ * Unpacking from fixsliced representation to byte-array.
+ */
+GFNI_TARGET void unpacking_gfni(uint8_t out[BLOCKBYTES], const uint32_t s[4])
+{
+    __m128i x = _mm_loadu_si128((const __m128i *)s);
+    _mm_storeu_si128((__m128i *)out, unpack_x4(x));
+}
+
+/**
+ * Stores the round tweakeys for rounds 2*i-1 and 2*i (if < rounds), both being
+ * derived from the packed tweakey 'x' = P^(2*i)(LFSR^i(tk)).
+ */
+GFNI_TARGET static inline void store_rtk_pair(
+    uint8_t *rtk,
+    __m128i x,
+    int i,
+    int rounds)
+{
+    __m128i odd, even;
+    switch (i & 3) {
+        case 1:
+            odd  = AND_X4(ROR_X4(x, 26), 0xc3c3c3c3);
+            even = SWAP_X4(BS2FS_ODD(x, 28, 6, 12));
+            break;
+        case 2:
+            odd  = BS2FS_EVEN(x, 14, 4, 6);
+            even = SWAP_X4(AND_X4(ROR_X4(x, 16), 0xf0f0f0f0));
+            break;
+        case 3:
+            odd  = AND_X4(ROR_X4(x, 10), 0xc3c3c3c3);
+            even = SWAP_X4(BS2FS_ODD(x, 12, 6, 28));
+            break;
+        default:
+            odd  = BS2FS_EVEN(x, 30, 4, 22);
+            even = SWAP_X4(AND_X4(x, 0xf0f0f0f0));
+            break;
+    }
+    _mm_storeu_si128((__m128i *)(rtk + (2*i - 1)*BLOCKBYTES), odd);
+    if (2*i < rounds)
+        _mm_storeu_si128((__m128i *)(rtk + 2*i*BLOCKBYTES), even);
+}
+
+/**
+ * Computes the round tweakeys for 'rounds' rounds from the byte-wise tweakeys
+ * 'tk23' (TK2 ^ TK3 or TK3 only) and 'tk1', without round constants.
+ * If 'lfsr' is 0, no LFSR is applied (i.e. for TK1).
+ */
+GFNI_TARGET static void tks_gfni(
+    uint8_t *rtk,
+    __m128i tk2,
+    __m128i tk3,
+    int lfsr,
+    int rounds)
+{
+    int i;
+    const __m128i perm2 = _mm_setr_epi8(1, 7, 0, 5, 2, 6, 4, 3,
+                                        9, 15, 8, 13, 10, 14, 12, 11);
+    __m128i x = pack_x4(_mm_xor_si128(tk2, tk3));
+    _mm_storeu_si128((__m128i *)rtk, SWAP_X4(AND_X4(x, 0xf0f0f0f0)));
+    for(i = 1; 2*i - 1 < rounds; i++) {
+        if (lfsr) {
+            tk2 = _mm_gf2p8affine_epi64_epi8(tk2,
+                _mm_set1_epi64x(GFNI_LFSR2), 0);
+            tk3 = _mm_gf2p8affine_epi64_epi8(tk3,
+                _mm_set1_epi64x(GFNI_LFSR3), 0);
+        }
+        tk2 = _mm_shuffle_epi8(tk2, perm2);
+        tk3 = _mm_shuffle_epi8(tk3, perm2);
+        x = pack_x4(_mm_xor_si128(tk2, tk3));
+        store_rtk_pair(rtk, x, i, rounds);
+    }
+}
+
+/**
+ * Equivalent to 'tks_lfsr_23' (or 'tks_lfsr_3' if tk_2 is NULL) followed by
+ * 'tks_perm_23_norc' for 40 rounds.
+ */
+GFNI_TARGET void tks_23_gfni(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES])
+{
+    __m128i tk2 = _mm_setzero_si128();
+    if (tk_2)
+        tk2 = _mm_loadu_si128((const __m128i *)tk_2);
+    tks_gfni(rtk_23, tk2, _mm_loadu_si128((const __m128i *)tk_3), 1,
+        SKINNY128_384_ROUNDS);
+}
+
+/**
+ * Equivalent to 'tks_perm_1'.
+ */
+GFNI_TARGET void tks_perm_1_gfni(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES])
+{
+    tks_gfni(rtk_1, _mm_setzero_si128(),
+        _mm_loadu_si128((const __m128i *)tk_1), 0, TKPERMORDER);
+}
+
+/******************************************************************************
+* 2-way version relying on AVX2: each 128-bit lane computes the TK3-only
+* schedule of an independent tweakey (e.g. both shares of a masked key).
+******************************************************************************/
+#define GFNI_AVX2_TARGET __attribute__((target("gfni,avx2")))
+
+#define ROR_X8(x, n)                                                        \
+    (_mm256_or_si256(_mm256_srli_epi32(x, n),                               \
+        _mm256_slli_epi32(x, (32 - (n)) & 31)))
+
+#define SWAP_X8(x)  (_mm256_shuffle_epi32(x, 0x4e))
+
+#define AND_X8(x, m) (_mm256_and_si256(x, _mm256_set1_epi32(m)))
+
+#define BS2FS_ODD_X8(x, sh0, sh1, sh2) (_mm256_or_si256(                    \
+    AND_X8(ROR_X8(x, sh0), 0x03030303),                                     \
+    ROR_X8(AND_X8(x, 0x03030303U << (sh1)), sh2)))
+
+#define BS2FS_EVEN_X8(x, sh0, sh1, sh2) (_mm256_or_si256(                   \
+    AND_X8(ROR_X8(x, sh0), 0x30303030),                                     \
+    ROR_X8(AND_X8(x, (0x30303030U >> (sh1)) | (0x30303030U << (32-(sh1)))), \
+        sh2)))
+
+// replicates a 128-bit byte shuffle into both lanes
+#define SHUF_X8(...)                                                        \
+    (_mm256_broadcastsi128_si256(_mm_setr_epi8(__VA_ARGS__)))
+
+/**
+ * Returns 1 if the CPU supports GFNI, SSSE3 and AVX2, 0 otherwise.
+ */
+int gfni_avx2_available(void)
+{
+    static int avx2 = -1;
+    int r = __atomic_load_n(&avx2, __ATOMIC_RELAXED);
+    if (r < 0) {
+        r = gfni_available() && __builtin_cpu_supports("avx2");
+        __atomic_store_n(&avx2, r, __ATOMIC_RELAXED);
+    }
+    return r;
+}
+
+GFNI_AVX2_TARGET static inline __m256i pack_x8(__m256i x)
+{
+    __m256i t;
+    x = _mm256_shuffle_epi8(x,
+        SHUF_X8(1, 0, 5, 4, 9, 8, 13, 12, 3, 2, 7, 6, 11, 10, 15, 14));
+    t = _mm256_xor_si256(x, _mm256_srli_epi64(x, 12));
+    t = _mm256_and_si256(t, _mm256_set1_epi64x(0x000f000f000f000fULL));
+    x = _mm256_xor_si256(x, _mm256_xor_si256(t, _mm256_slli_epi64(t, 12)));
+    x = _mm256_gf2p8affine_epi64_epi8(_mm256_set1_epi64x(GFNI_PACK), x, 0);
+    return _mm256_shuffle_epi8(x,
+        SHUF_X8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15));
+}
+
+GFNI_AVX2_TARGET static inline void store_x8(
+    uint8_t *rtk_a,
+    uint8_t *rtk_b,
+    __m256i x)
+{
+    _mm_storeu_si128((__m128i *)rtk_a, _mm256_castsi256_si128(x));
+    _mm_storeu_si128((__m128i *)rtk_b, _mm256_extracti128_si256(x, 1));
+}
+
+/**
+ * Same as 'store_rtk_pair' for two tweakeys (one per 128-bit lane).
+ */
+GFNI_AVX2_TARGET static inline void store_rtk_pair_x8(
+    uint8_t *rtk_a,
+    uint8_t *rtk_b,
+    __m256i x,
+    int i)
+{
+    __m256i odd, even;
+    switch (i & 3) {
+        case 1:
+            odd  = AND_X8(ROR_X8(x, 26), 0xc3c3c3c3);
+            even = SWAP_X8(BS2FS_ODD_X8(x, 28, 6, 12));
+            break;
+        case 2:
+            odd  = BS2FS_EVEN_X8(x, 14, 4, 6);
+            even = SWAP_X8(AND_X8(ROR_X8(x, 16), 0xf0f0f0f0));
+            break;
+        case 3:
+            odd  = AND_X8(ROR_X8(x, 10), 0xc3c3c3c3);
+            even = SWAP_X8(BS2FS_ODD_X8(x, 12, 6, 28));
+            break;
+        default:
+            odd  = BS2FS_EVEN_X8(x, 30, 4, 22);
+            even = SWAP_X8(AND_X8(x, 0xf0f0f0f0));
+            break;
+    }
+    store_x8(rtk_a + (2*i - 1)*BLOCKBYTES, rtk_b + (2*i - 1)*BLOCKBYTES, odd);
+    if (2*i < SKINNY128_384_ROUNDS)
+        store_x8(rtk_a + 2*i*BLOCKBYTES, rtk_b + 2*i*BLOCKBYTES, even);
+}
+
+/**
+ * Equivalent to 'tks_23_gfni' with tk_2 = NULL for two independent tweakeys.
+ */
+GFNI_AVX2_TARGET void tks_3_gfni_x2(
+    uint8_t rtk_3a[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    uint8_t rtk_3b[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_3a[TWEAKEYBYTES],
+    const uint8_t tk_3b[TWEAKEYBYTES])
+{
+    int i;
+    const __m256i perm2 = SHUF_X8(1, 7, 0, 5, 2, 6, 4, 3,
+                                  9, 15, 8, 13, 10, 14, 12, 11);
+    __m256i tk3 = _mm256_loadu2_m128i((const __m128i *)tk_3b,
+                                      (const __m128i *)tk_3a);
+    __m256i x = pack_x8(tk3);
+    store_x8(rtk_3a, rtk_3b, SWAP_X8(AND_X8(x, 0xf0f0f0f0)));
+    for(i = 1; 2*i - 1 < SKINNY128_384_ROUNDS; i++) {
+        tk3 = _mm256_gf2p8affine_epi64_epi8(tk3,
+            _mm256_set1_epi64x(GFNI_LFSR3), 0);
+        tk3 = _mm256_shuffle_epi8(tk3, perm2);
+        x = pack_x8(tk3);
+        store_rtk_pair_x8(rtk_3a, rtk_3b, x, i);
+    }
+}
+
+#else   // no GFNI on other architectures
+
+int gfni_available(void)
+{
+    return 0;
+}
+
+void packing_gfni(uint32_t s[4], const uint8_t in[BLOCKBYTES])
+{
+    (void)s; (void)in;
+}
+
+void unpacking_gfni(uint8_t out[BLOCKBYTES], const uint32_t s[4])
+{
+    (void)out; (void)s;
+}
+
+void tks_23_gfni(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES])
+{
+    (void)rtk_23; (void)tk_2; (void)tk_3;
+}
+
+void tks_perm_1_gfni(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES])
+{
+    (void)rtk_1; (void)tk_1;
+}
+
+int gfni_avx2_available(void)
+{
+    return 0;
+}
+
+void tks_3_gfni_x2(
+    uint8_t rtk_3a[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    uint8_t rtk_3b[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_3a[TWEAKEYBYTES],
+    const uint8_t tk_3b[TWEAKEYBYTES])
+{
+    (void)rtk_3a; (void)rtk_3b; (void)tk_3a; (void)tk_3b;
+}
+
+#endif
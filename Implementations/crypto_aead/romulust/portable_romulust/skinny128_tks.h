@@ -0,0 +1,78 @@
+#ifndef SKINNY128_TKS_H_
+#define SKINNY128_TKS_H_
+
+/*******************************************************************************
+* Helpers shared by the portable tweakey schedule (see 'skinny128_tks_lfsr.c'
+* and 'skinny128_tks_perm.c') and by the Romulus-T keystream engine which
+* computes TK3 round tweakeys alongside the rounds (see 'skinny128_core_ks.c').
+*******************************************************************************/
+#include "skinny128.h"
+
+#define ROR(x,y) (((x) >> (y)) | ((x) << ((32 - (y)) & 31)))
+
+// computes lfsr2 on tk2 in a bitsliced fashion
+#define LFSR2(out, in) ({                               \
+    tmp = ((in) & 0xaaaaaaaa) ^ (out);                  \
+    out = ((tmp << 1) & 0xaaaaaaaa) | ((tmp & 0xaaaaaaaa) >> 1); \
+})
+
+// computes lfsr3 on tk3 in a bitsliced fashion
+#define LFSR3(out, in) ({                               \
+    tmp = (out) ^ (((in) & 0xaaaaaaaa) >> 1);           \
+    out = ((tmp << 1) & 0xaaaaaaaa) | ((tmp & 0xaaaaaaaa) >> 1); \
+})
+
+// tweakey permutation applied twice on 32-bit input
+#define PERM2(x) (                                                          \
+    (ROR(x, 14) & 0xcc00cc00) | (((x) & 0x000000ff) << 16)        |         \
+    (((x) & 0xcc000000) >> 2) | (((x) & 0x0033cc00) >> 8)         |         \
+    (((x) & 0x00cc0000) >> 18))
+
+// tweakey permutation applied 4 times on 32-bit input
+#define PERM4(x) (                                                          \
+    (ROR(x, 22) & 0xcc0000cc) | (ROR(x, 16) & 0x3300cc00)         |         \
+    (((x) & 0x00cc00cc) >> 2) | ROR((x) & 0x0000cc33, 24))
+
+// tweakey permutation applied 6 times on 32-bit input
+#define PERM6(x) (                                                          \
+    (ROR(x, 24) & 0x330000cc) | ROR((x) & 0x33000033, 6)          |         \
+    (ROR(x, 10) & 0x00003333) | (((x) & 0x000000cc) << 14)       |         \
+    (((x) & 0x00003300) << 2))
+
+// tweakey permutation applied 8 times on 32-bit input
+#define PERM8(x) (                                                          \
+    (ROR(x, 8) & 0x33cc0000)  | ROR((x) & 0x33cc0000, 24)         |         \
+    ROR((x) & 0x0000cccc, 26) | (((x) & 0x00333300) >> 6))
+
+// tweakey permutation applied 10 times on 32-bit input
+#define PERM10(x) (                                                         \
+    (ROR(x, 26) & 0x33000033) | ROR((x) & 0x330000cc, 8)          |         \
+    ROR((x) & 0x00003333, 22) | (((x) & 0x00330000) >> 14)        |         \
+    (((x) & 0x0000cc00) >> 2))
+
+// tweakey permutation applied 12 times on 32-bit input
+#define PERM12(x) (                                                         \
+    (ROR(x, 8) & 0x0000cc33)  | (ROR(x, 30) & 0x00cc00cc)         |         \
+    (ROR(x, 16) & 0xcc003300) | ROR((x) & 0xcc0000cc, 10))
+
+// tweakey permutation applied 14 times on 32-bit input
+#define PERM14(x) (                                                         \
+    (ROR(x, 24) & 0x0033cc00) | ROR((x) & 0x00000033, 14)         |         \
+    ROR((x) & 0x33000000, 30) | ROR((x) & 0x00ff0000, 16)         |         \
+    ROR((x) & 0xcc00cc00, 18))
+
+// bitmasks and rotations to match fixslicing (odd rounds)
+#define BS2FS_ODD(x, sh0, sh1, sh2)                                         \
+    ((ROR(x, sh0) & 0x03030303) | ROR((x) & (0x03030303U << (sh1)), sh2))
+
+// bitmasks and rotations to match fixslicing (even rounds)
+#define BS2FS_EVEN(x, sh0, sh1, sh2)                                        \
+    ((ROR(x, sh0) & 0x30303030) | ROR((x) & ROR(0x30303030U, sh1), sh2))
+
+/**
+ * Round constants in fixsliced representation for all rounds, including the
+ * NOT which is saved in the s-box calculations (see 'skinny128_tks_perm.c').
+ */
+extern const uint32_t rconst_32_fs[4*SKINNY128_384_ROUNDS];
+
+#endif  // SKINNY128_TKS_H_
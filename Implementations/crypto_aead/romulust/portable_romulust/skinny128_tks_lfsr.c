@@ -0,0 +1,87 @@
+/*******************************************************************************
+* Portable C implementation of the LFSR-based part of the Skinny-128-384+
+* tweakey schedule, ported from 'skinny128_tks_lfsr.s'.
+*
+* Round tweakeys are only computed for odd rounds (and the 1st one), the
+* remaining ones being derived in 'skinny128_tks_perm.c'.
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+*******************************************************************************/
+#include "skinny128_tks.h"
+
+// stores a round tweakey made of 4 words
+#define STRTK(rtk, w0, w1, w2, w3) ({   \
+    (rtk)[0] = (w0);                    \
+    (rtk)[1] = (w1);                    \
+    (rtk)[2] = (w2);                    \
+    (rtk)[3] = (w3);                    \
+})
+
+/**
+ * Computes LFSR2(TK2) ^ LFSR3(TK3) for all rounds.
+ * Processing both at the same time allows to save some memory accesses.
+ */
+void tks_lfsr_23(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const int rounds)
+{
+    int i;
+    uint32_t tmp;
+    uint32_t tk2[4], tk3[4];
+    uint32_t *rtk = (uint32_t *)rtk_23;
+    packing(tk2, tk_2);
+    packing(tk3, tk_3);
+    STRTK(rtk, tk3[0]^tk2[0], tk3[1]^tk2[1], tk3[2]^tk2[2], tk3[3]^tk2[3]);
+    rtk += 4;
+    // Precompute 4 round tweakeys (odd rounds only) per iteration
+    for(i = 0; i < rounds; i += 8) {
+        LFSR2(tk2[0], tk2[2]);
+        LFSR3(tk3[3], tk3[1]);
+        STRTK(rtk, tk3[3]^tk2[1], tk3[0]^tk2[2], tk3[1]^tk2[3], tk3[2]^tk2[0]);
+        LFSR2(tk2[1], tk2[3]);
+        LFSR3(tk3[2], tk3[0]);
+        STRTK(rtk+8, tk3[2]^tk2[2], tk3[3]^tk2[3], tk3[0]^tk2[0], tk3[1]^tk2[1]);
+        LFSR2(tk2[2], tk2[0]);
+        LFSR3(tk3[1], tk3[3]);
+        STRTK(rtk+16, tk3[1]^tk2[3], tk3[2]^tk2[0], tk3[3]^tk2[1], tk3[0]^tk2[2]);
+        LFSR2(tk2[3], tk2[1]);
+        LFSR3(tk3[0], tk3[2]);
+        STRTK(rtk+24, tk3[0]^tk2[0], tk3[1]^tk2[1], tk3[2]^tk2[2], tk3[3]^tk2[3]);
+        rtk += 32;
+    }
+}
+
+/**
+ * Computes LFSR3(TK3) for all rounds.
+ * Useful because many TBC calls in Romulus-T use TK2 = 0...0.
+ */
+void tks_lfsr_3(
+    uint8_t rtk_3[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const int rounds)
+{
+    int i;
+    uint32_t tmp;
+    uint32_t tk3[4];
+    uint32_t *rtk = (uint32_t *)rtk_3;
+    packing(tk3, tk_3);
+    STRTK(rtk, tk3[0], tk3[1], tk3[2], tk3[3]);
+    rtk += 4;
+    // Precompute 4 round tweakeys (odd rounds only) per iteration
+    for(i = 0; i < rounds; i += 8) {
+        LFSR3(tk3[3], tk3[1]);
+        STRTK(rtk, tk3[3], tk3[0], tk3[1], tk3[2]);
+        LFSR3(tk3[2], tk3[0]);
+        STRTK(rtk+8, tk3[2], tk3[3], tk3[0], tk3[1]);
+        LFSR3(tk3[1], tk3[3]);
+        STRTK(rtk+16, tk3[1], tk3[2], tk3[3], tk3[0]);
+        LFSR3(tk3[0], tk3[2]);
+        STRTK(rtk+24, tk3[0], tk3[1], tk3[2], tk3[3]);
+        rtk += 32;
+    }
+}
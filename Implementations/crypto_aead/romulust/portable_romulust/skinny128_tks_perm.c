@@ -0,0 +1,237 @@
+/*******************************************************************************
+* Portable C implementation of the permutation-based part of the Skinny-128-384+
+* tweakey schedule, ported from 'skinny128_tks_perm.s'.
+*
+* For more details, see the paper at
+* https://csrc.nist.gov/CSRC/media/Events/lightweight-cryptography-workshop-2020
+* /documents/papers/fixslicing-lwc2020.pdf
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+*******************************************************************************/
+#include "skinny128_tks.h"
+
+/**
+ * Round constants in fixsliced representation for all rounds, including the
+ * NOT which is saved in the s-box calculations.
+ */
+const uint32_t rconst_32_fs[4*SKINNY128_384_ROUNDS] = {
+    0x00000004, 0xffffffbf, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x10000100, 0xfffffeff,
+    0x44000000, 0xfbffffff, 0x00000000, 0x04000000,
+    0x00100000, 0x00100000, 0x00100001, 0xffefffff,
+    0x00440000, 0xffafffff, 0x00400000, 0x00400000,
+    0x01000000, 0x01000000, 0x01401000, 0xffbfffff,
+    0x01004000, 0xfefffbff, 0x00000400, 0x00000400,
+    0x00000010, 0x00000000, 0x00010410, 0xfffffbef,
+    0x00000054, 0xffffffaf, 0x00000000, 0x00000040,
+    0x00000100, 0x00000100, 0x10000140, 0xfffffeff,
+    0x44000000, 0xfffffeff, 0x04000000, 0x04000000,
+    0x00100000, 0x00100000, 0x04000001, 0xfbffffff,
+    0x00140000, 0xffafffff, 0x00400000, 0x00000000,
+    0x00000000, 0x00000000, 0x01401000, 0xfebfffff,
+    0x01004400, 0xfffffbff, 0x00000000, 0x00000400,
+    0x00000010, 0x00000010, 0x00010010, 0xffffffff,
+    0x00000004, 0xffffffaf, 0x00000040, 0x00000040,
+    0x00000100, 0x00000000, 0x10000140, 0xffffffbf,
+    0x40000100, 0xfbfffeff, 0x00000000, 0x04000000,
+    0x00100000, 0x00000000, 0x04100001, 0xffefffff,
+    0x00440000, 0xffefffff, 0x00000000, 0x00400000,
+    0x01000000, 0x01000000, 0x00401000, 0xffffffff,
+    0x00004000, 0xfeffffff, 0x00000400, 0x00000000,
+    0x00000000, 0x00000000, 0x00010400, 0xfffffbff,
+    0x00000014, 0xffffffbf, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x10000100, 0xffffffff,
+    0x40000000, 0xfbffffff, 0x00000000, 0x04000000,
+    0x00100000, 0x00000000, 0x00100001, 0xffefffff,
+    0x00440000, 0xffafffff, 0x00000000, 0x00400000,
+    0x01000000, 0x01000000, 0x01401000, 0xffffffff,
+    0x00004000, 0xfeffffff, 0x00000400, 0x00000400,
+    0x00000010, 0x00000000, 0x00010400, 0xfffffbff,
+    0x00000014, 0xffffffaf, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x10000140, 0xfffffeff,
+    0x44000000, 0xffffffff, 0x00000000, 0x04000000,
+    0x00100000, 0x00100000, 0x00000001, 0xffefffff,
+    0x00440000, 0xffafffff, 0x00400000, 0x00000000,
+    0x00000000, 0x01000000, 0x01401000, 0xffbfffff,
+    0x01004000, 0xfffffbff, 0x00000400, 0x00000400,
+    0x00000010, 0x00000000, 0x00010010, 0xfffffbff
+};
+
+/**
+ * Applies the tweakey permutation 2*q times on a full (bitsliced) tweakey.
+ * Since P^16 = Id, q is taken modulo 8.
+ */
+static void tk_permute(uint32_t tk[4], int q)
+{
+    int i;
+    for(i = 0; i < 4; i++) {
+        switch(q & 7) {
+            case 1: tk[i] = PERM2(tk[i]); break;
+            case 2: tk[i] = PERM4(tk[i]); break;
+            case 3: tk[i] = PERM6(tk[i]); break;
+            case 4: tk[i] = PERM8(tk[i]); break;
+            case 5: tk[i] = PERM10(tk[i]); break;
+            case 6: tk[i] = PERM12(tk[i]); break;
+            case 7: tk[i] = PERM14(tk[i]); break;
+            default: break;
+        }
+    }
+}
+
+/**
+ * Stores the round tweakeys for round i (odd) and i+1 (if i+1 < rounds) from
+ * the permuted tweakey 'tk' so that they match the fixsliced representation.
+ */
+static void tk_store_fs(uint32_t *rtk, const uint32_t tk[4], int i, int rounds)
+{
+    int j;
+    uint32_t *rtk_i = rtk + 4*i;
+    uint32_t *rtk_n = rtk + 4*(i+1);
+    switch(i & 7) {
+        case 1:
+            for(j = 0; j < 4; j++)
+                rtk_i[j] = ROR(tk[j], 26) & 0xc3c3c3c3;
+            if (i+1 < rounds)
+                for(j = 0; j < 4; j++)
+                    rtk_n[j ^ 2] = BS2FS_ODD(tk[j], 28, 6, 12);
+            break;
+        case 3:
+            if (i+1 < rounds)
+                for(j = 0; j < 4; j++)
+                    rtk_n[j ^ 2] = ROR(tk[j], 16) & 0xf0f0f0f0;
+            for(j = 0; j < 4; j++)
+                rtk_i[j] = BS2FS_EVEN(tk[j], 14, 4, 6);
+            break;
+        case 5:
+            for(j = 0; j < 4; j++)
+                rtk_i[j] = ROR(tk[j], 10) & 0xc3c3c3c3;
+            if (i+1 < rounds)
+                for(j = 0; j < 4; j++)
+                    rtk_n[j ^ 2] = BS2FS_ODD(tk[j], 12, 6, 28);
+            break;
+        case 7:
+            if (i+1 < rounds)
+                for(j = 0; j < 4; j++)
+                    rtk_n[j ^ 2] = tk[j] & 0xf0f0f0f0;
+            for(j = 0; j < 4; j++)
+                rtk_i[j] = BS2FS_EVEN(tk[j], 30, 4, 22);
+            break;
+    }
+}
+
+/**
+ * Apply the tweakey permutation to round tweakeys for 40 rounds.
+ *
+ * Input/output round tweakeys are expected to be in fixsliced representation.
+ */
+void tks_perm_23_norc(uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES])
+{
+    int i, j;
+    uint32_t tk[4];
+    uint32_t *rtk = (uint32_t *)rtk_23;
+    for(j = 0; j < 4; j++)
+        tk[j] = rtk[j];
+    for(j = 0; j < 4; j++)
+        rtk[j ^ 2] = tk[j] & 0xf0f0f0f0;
+    for(i = 1; i < SKINNY128_384_ROUNDS; i += 2) {
+        for(j = 0; j < 4; j++)
+            tk[j] = rtk[4*i + j];
+        tk_permute(tk, (i+1)/2);
+        tk_store_fs(rtk, tk, i, SKINNY128_384_ROUNDS);
+    }
+}
+
+/**
+ * Apply the tweakey permutation to round tweakeys for 40 rounds.
+ * Also add the round constants at the same time.
+ *
+ * Input/output round tweakeys are expected to be in fixsliced representation.
+ */
+void tks_perm_23(uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES])
+{
+    int i;
+    uint32_t *rtk = (uint32_t *)rtk_23;
+    tks_perm_23_norc(rtk_23);
+    for(i = 0; i < 4*SKINNY128_384_ROUNDS; i++)
+        rtk[i] ^= rconst_32_fs[i];
+}
+
+/**
+ * Full TK2/TK3 schedule for 40 rounds: 'tks_lfsr_23' (or 'tks_lfsr_3' if tk_2
+ * is NULL) followed by 'tks_perm_23' (or 'tks_perm_23_norc' if rc is 0).
+ * Relies on GFNI if supported by the CPU.
+ */
+void tks_23(
+    uint8_t rtk_23[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_2[TWEAKEYBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const int rc)
+{
+    int i;
+    uint32_t *rtk = (uint32_t *)rtk_23;
+    if (gfni_available()) {
+        tks_23_gfni(rtk_23, tk_2, tk_3);
+    } else {
+        if (tk_2)
+            tks_lfsr_23(rtk_23, tk_2, tk_3, SKINNY128_384_ROUNDS);
+        else
+            tks_lfsr_3(rtk_23, tk_3, SKINNY128_384_ROUNDS);
+        tks_perm_23_norc(rtk_23);
+    }
+    if (rc)
+        for(i = 0; i < 4*SKINNY128_384_ROUNDS; i++)
+            rtk[i] ^= rconst_32_fs[i];
+}
+
+/**
+ * Equivalent to 'tks_23(rtk_3, NULL, tk_3, 1)' and 'tks_23(rtk_3m, NULL, tk_3m,
+ * 0)', i.e. the TK3 schedule for both shares of a masked key.
+ * Relies on GFNI and AVX2 if supported by the CPU to compute both at once.
+ */
+void tks_3_x2(
+    uint8_t rtk_3[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    uint8_t rtk_3m[SKINNY128_384_ROUNDS*BLOCKBYTES],
+    const uint8_t tk_3[TWEAKEYBYTES],
+    const uint8_t tk_3m[TWEAKEYBYTES])
+{
+    int i;
+    uint32_t *rtk = (uint32_t *)rtk_3;
+    if (gfni_avx2_available()) {
+        tks_3_gfni_x2(rtk_3, rtk_3m, tk_3, tk_3m);
+        for(i = 0; i < 4*SKINNY128_384_ROUNDS; i++)
+            rtk[i] ^= rconst_32_fs[i];
+    } else {
+        tks_23(rtk_3, NULL, tk_3, 1);
+        tks_23(rtk_3m, NULL, tk_3m, 0);
+    }
+}
+
+/**
+ * Applies the permutations P^2, ..., P^14 for rounds 0 to 16. Since P^16=Id, we
+ * don't need more calculations as no LFSR is applied to TK1.
+ * Relies on GFNI if supported by the CPU.
+ */
+void tks_perm_1(
+    uint8_t rtk_1[TKPERMORDER*BLOCKBYTES],
+    const uint8_t tk_1[TWEAKEYBYTES])
+{
+    int i, j;
+    uint32_t tk1[4], tk[4];
+    uint32_t *rtk = (uint32_t *)rtk_1;
+    if (gfni_available()) {
+        tks_perm_1_gfni(rtk_1, tk_1);
+        return;
+    }
+    packing(tk1, tk_1);
+    for(j = 0; j < 4; j++)
+        rtk[j ^ 2] = tk1[j] & 0xf0f0f0f0;
+    for(i = 1; i < TKPERMORDER; i += 2) {
+        for(j = 0; j < 4; j++)
+            tk[j] = tk1[j];
+        tk_permute(tk, (i+1)/2);
+        tk_store_fs(rtk, tk, i, TKPERMORDER);
+    }
+}
@@ -0,0 +1,189 @@
+/*******************************************************************************
+* Up to 8 independent TK3 schedules of Skinny-128-384+ relying on AVX2, e.g. to
+* expand the round tweakeys of many keys at once (see 'romulus_expand_keys').
+*
+* Each 32-bit lane of a 256-bit vector holds a fixsliced word of a distinct
+* tweakey, so that the steps of 'tks_lfsr_3' and 'tks_perm_23_norc' are their
+* lane-wise counterparts. Since they only consist of shifts and bitwise
+* operations, the macros of 'skinny128_tks.h' are applied as is on GNU vector
+* types.
+*
+* @author 	Alexandre Adomnicai
+* 			alex.adomnicai@gmail.com
+*
+* @date     October 2026
+*******************************************************************************/
+#include "skinny128.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include "skinny128_x8.h"
+#undef ROR          // the rotation of 'skinny128_tks.h' also works lane-wise
+#endif
+
+#include "skinny128_tks.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+typedef uint32_t tw_t __attribute__((vector_size(32)));
+
+/**
+ * Lane-wise counterpart of 'tk_permute' (see 'skinny128_tks_perm.c').
+ */
+AVX2_TARGET static inline __attribute__((always_inline)) void tk_permute_x8(tw_t tk[4], int q)
+{
+    int i;
+    for(i = 0; i < 4; i++) {
+        switch(q & 7) {
+            case 1: tk[i] = PERM2(tk[i]); break;
+            case 2: tk[i] = PERM4(tk[i]); break;
+            case 3: tk[i] = PERM6(tk[i]); break;
+            case 4: tk[i] = PERM8(tk[i]); break;
+            case 5: tk[i] = PERM10(tk[i]); break;
+            case 6: tk[i] = PERM12(tk[i]); break;
+            case 7: tk[i] = PERM14(tk[i]); break;
+            default: break;
+        }
+    }
+}
+
+/**
+ * Lane-wise counterpart of 'tk_store_fs' (see 'skinny128_tks_perm.c') for 40
+ * rounds, where 'rtk' has room for a 41st round tweakey.
+ */
+AVX2_TARGET static inline __attribute__((always_inline)) void tk_store_fs_x8(tw_t *rtk, const tw_t tk[4],
+    int i)
+{
+    int j;
+    tw_t *rtk_i = rtk + 4*i;
+    tw_t *rtk_n = rtk + 4*(i+1);
+    switch(i & 7) {
+        case 1:
+            for(j = 0; j < 4; j++) {
+                rtk_i[j] = ROR(tk[j], 26) & 0xc3c3c3c3;
+                rtk_n[j ^ 2] = BS2FS_ODD(tk[j], 28, 6, 12);
+            }
+            break;
+        case 3:
+            for(j = 0; j < 4; j++) {
+                rtk_n[j ^ 2] = ROR(tk[j], 16) & 0xf0f0f0f0;
+                rtk_i[j] = BS2FS_EVEN(tk[j], 14, 4, 6);
+            }
+            break;
+        case 5:
+            for(j = 0; j < 4; j++) {
+                rtk_i[j] = ROR(tk[j], 10) & 0xc3c3c3c3;
+                rtk_n[j ^ 2] = BS2FS_ODD(tk[j], 12, 6, 28);
+            }
+            break;
+        case 7:
+            for(j = 0; j < 4; j++) {
+                rtk_n[j ^ 2] = tk[j] & 0xf0f0f0f0;
+                rtk_i[j] = BS2FS_EVEN(tk[j], 30, 4, 22);
+            }
+            break;
+    }
+}
+
+/**
+ * TK3 schedule of 8 tweakeys w/o round constants, the round tweakeys being
+ * computed in interleaved form and de-interleaved two rounds at a time.
+ */
+AVX2_TARGET static void tks_3_avx2(
+    uint8_t *const rtk_3[8],
+    const uint8_t *const tk_3[8])
+{
+    int i, j;
+    uint32_t w[8][4];
+    __m256i r[8];
+    tw_t tmp, tk3[4], tk[4];
+    tw_t rtk[4*(SKINNY128_384_ROUNDS+1)];   // one spare round for the loop
+    for(i = 0; i < 8; i++)
+        packing(w[i], tk_3[i]);
+    load_x8(r, (const uint32_t (*)[4])w);
+    for(i = 0; i < 4; i++)
+        tk3[i] = (tw_t)r[i];
+    // LFSR-based part (see 'tks_lfsr_3')
+    for(j = 0; j < 4; j++)
+        rtk[j] = tk3[j];
+    for(i = 1; i < SKINNY128_384_ROUNDS; i += 8) {
+        LFSR3(tk3[3], tk3[1]);
+        rtk[4*i+0] = tk3[3]; rtk[4*i+1] = tk3[0];
+        rtk[4*i+2] = tk3[1]; rtk[4*i+3] = tk3[2];
+        LFSR3(tk3[2], tk3[0]);
+        rtk[4*i+8] = tk3[2]; rtk[4*i+9] = tk3[3];
+        rtk[4*i+10] = tk3[0]; rtk[4*i+11] = tk3[1];
+        LFSR3(tk3[1], tk3[3]);
+        rtk[4*i+16] = tk3[1]; rtk[4*i+17] = tk3[2];
+        rtk[4*i+18] = tk3[3]; rtk[4*i+19] = tk3[0];
+        LFSR3(tk3[0], tk3[2]);
+        rtk[4*i+24] = tk3[0]; rtk[4*i+25] = tk3[1];
+        rtk[4*i+26] = tk3[2]; rtk[4*i+27] = tk3[3];
+    }
+    // Permutation-based part (see 'tks_perm_23_norc')
+    for(j = 0; j < 4; j++)
+        tk[j] = rtk[j];
+    for(j = 0; j < 4; j++)
+        rtk[j ^ 2] = tk[j] & 0xf0f0f0f0;
+#pragma GCC unroll 20
+    for(i = 1; i < SKINNY128_384_ROUNDS; i += 2) {
+        for(j = 0; j < 4; j++)
+            tk[j] = rtk[4*i + j];
+        tk_permute_x8(tk, (i+1)/2);
+        tk_store_fs_x8(rtk, tk, i);
+    }
+    for(i = 0; i < SKINNY128_384_ROUNDS/2; i++) {
+        for(j = 0; j < 8; j++)
+            r[j] = (__m256i)rtk[8*i + j];
+        transpose_x8(r);
+        for(j = 0; j < 8; j++)
+            _mm256_storeu_si256((__m256i *)(rtk_3[j] + 32*i), r[j]);
+    }
+}
+
+#endif
+
+/**
+ * Equivalent to 'tks_23(rtk_3[i], NULL, tk_3[i], (rc >> i) & 1)' for i < n.
+ * Relies on AVX2 if supported by the CPU and if more than 2 tweakeys are to be
+ * processed, on 'tks_3_x2' otherwise. If GFNI is supported as well, 'tks_3_x2'
+ * is preferred as it is about twice as fast per tweakey: AVX2 has no rotation
+ * instruction, on which the tweakey permutation heavily relies.
+ */
+void tks_3_x8(
+    uint8_t *const rtk_3[],
+    const uint8_t *const tk_3[],
+    uint32_t rc,
+    int n)
+{
+    int i;
+#if defined(__x86_64__) || defined(__i386__)
+    int j;
+    uint32_t *rtk;
+    uint8_t spare[SKINNY128_384_ROUNDS*BLOCKBYTES] __attribute__((aligned(32)));
+    uint8_t *out[8];
+    const uint8_t *in[8];
+    if (n > 2 && avx2_available() && !gfni_avx2_available()) {
+        // missing lanes are computed from the 1st tweakey and discarded
+        for(i = 0; i < 8; i++) {
+            out[i] = (i < n) ? rtk_3[i] : spare;
+            in[i] = (i < n) ? tk_3[i] : tk_3[0];
+        }
+        tks_3_avx2(out, in);
+        for(i = 0; i < n; i++) {
+            rtk = (uint32_t *)rtk_3[i];
+            if ((rc >> i) & 1)
+                for(j = 0; j < 4*SKINNY128_384_ROUNDS; j++)
+                    rtk[j] ^= rconst_32_fs[j];
+        }
+        return;
+    }
+#endif
+    for(i = 0; i < n; i++) {
+        if (i + 1 < n && ((rc >> i) & 3) == 1) {
+            tks_3_x2(rtk_3[i], rtk_3[i+1], tk_3[i], tk_3[i+1]);
+            i++;
+        } else {
+            tks_23(rtk_3[i], NULL, tk_3[i], (rc >> i) & 1);
+        }
+    }
+}
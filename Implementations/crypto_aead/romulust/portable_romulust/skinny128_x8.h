@@ -0,0 +1,131 @@
+#ifndef SKINNY128_X8_H_
+#define SKINNY128_X8_H_
+
+/*******************************************************************************
+* Helpers shared by the 8-way AVX2 implementations of Skinny-128-384+ (see
+* 'skinny128_core_x8.c' and 'skinny128_core_mask_x8.c') and of its TK3
+* schedule (see 'skinny128_tks_x8.c').
+*
+* Each 32-bit lane of a 256-bit register holds a fixsliced word of a distinct
+* block, so that all operations are the lane-wise counterparts of the ones
+* from the 32-bit implementation.
+*******************************************************************************/
+#include <immintrin.h>
+#include "skinny128.h"
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+#define XOR(x, y)       (_mm256_xor_si256(x, y))
+#define AND(x, y)       (_mm256_and_si256(x, y))
+#define OR(x, y)        (_mm256_or_si256(x, y))
+#define NOT(x)          (_mm256_xor_si256(x, _mm256_set1_epi32(-1)))
+#define SET1(m)         (_mm256_set1_epi32((int)(m)))
+
+#define ROR(x,y)        (OR(_mm256_srli_epi32(x, y),                        \
+                            _mm256_slli_epi32(x, (32 - (y)) & 31)))
+
+#define SWAPMOVE(a, b, mask, n) ({                                          \
+    tmp = AND(XOR(b, _mm256_srli_epi32(a, n)), SET1(mask));                 \
+    b = XOR(b, tmp);                                                        \
+    a = XOR(a, _mm256_slli_epi32(tmp, n));                                  \
+})
+
+#define MIXCOL(x, idx0, idx1, idx2, idx3, idx4, idx5) ({    \
+    tmp = AND(ROR(x, idx0), SET1(0x30303030));              \
+    x = XOR(x, ROR(tmp, idx1));                             \
+    tmp = AND(ROR(x, idx2), SET1(0x30303030));              \
+    x = XOR(x, ROR(tmp, idx3));                             \
+    tmp = AND(ROR(x, idx4), SET1(0x30303030));              \
+    x = XOR(x, ROR(tmp, idx5));                             \
+})
+
+#define MIXCOLUMNS(s, idx0, idx1, idx2, idx3, idx4, idx5) ({ \
+    MIXCOL(s[0], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[1], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[2], idx0, idx1, idx2, idx3, idx4, idx5);       \
+    MIXCOL(s[3], idx0, idx1, idx2, idx3, idx4, idx5);       \
+})
+
+/**
+ * Transposes a 8x8 matrix of 32-bit words, i.e. r[j] lane i <- r[i] lane j.
+ */
+AVX2_TARGET static inline void transpose_x8(__m256i r[8])
+{
+    __m256i t[8], u[8];
+    t[0] = _mm256_unpacklo_epi32(r[0], r[1]);
+    t[1] = _mm256_unpackhi_epi32(r[0], r[1]);
+    t[2] = _mm256_unpacklo_epi32(r[2], r[3]);
+    t[3] = _mm256_unpackhi_epi32(r[2], r[3]);
+    t[4] = _mm256_unpacklo_epi32(r[4], r[5]);
+    t[5] = _mm256_unpackhi_epi32(r[4], r[5]);
+    t[6] = _mm256_unpacklo_epi32(r[6], r[7]);
+    t[7] = _mm256_unpackhi_epi32(r[6], r[7]);
+    u[0] = _mm256_unpacklo_epi64(t[0], t[2]);
+    u[1] = _mm256_unpackhi_epi64(t[0], t[2]);
+    u[2] = _mm256_unpacklo_epi64(t[1], t[3]);
+    u[3] = _mm256_unpackhi_epi64(t[1], t[3]);
+    u[4] = _mm256_unpacklo_epi64(t[4], t[6]);
+    u[5] = _mm256_unpackhi_epi64(t[4], t[6]);
+    u[6] = _mm256_unpacklo_epi64(t[5], t[7]);
+    u[7] = _mm256_unpackhi_epi64(t[5], t[7]);
+    r[0] = _mm256_permute2x128_si256(u[0], u[4], 0x20);
+    r[1] = _mm256_permute2x128_si256(u[1], u[5], 0x20);
+    r[2] = _mm256_permute2x128_si256(u[2], u[6], 0x20);
+    r[3] = _mm256_permute2x128_si256(u[3], u[7], 0x20);
+    r[4] = _mm256_permute2x128_si256(u[0], u[4], 0x31);
+    r[5] = _mm256_permute2x128_si256(u[1], u[5], 0x31);
+    r[6] = _mm256_permute2x128_si256(u[2], u[6], 0x31);
+    r[7] = _mm256_permute2x128_si256(u[3], u[7], 0x31);
+}
+
+/**
+ * Interleaves the round tweakeys of 8 blocks, two rounds (i.e. 8 words) at a
+ * time. If not NULL, rtk1 is added on the fly.
+ */
+AVX2_TARGET static inline void interleave_rtk_x8(
+    __m256i rtk[SKINNY128_384_ROUNDS*4],
+    const uint8_t *const rtk_23[8],
+    const uint8_t *const rtk1[8])
+{
+    int i, j;
+    __m256i r[8];
+    for(i = 0; i < SKINNY128_384_ROUNDS/2; i++) {
+        for(j = 0; j < 8; j++) {
+            r[j] = _mm256_loadu_si256((const __m256i *)(rtk_23[j] + 32*i));
+            if (rtk1 != NULL)   // rtk1 repeats every 16 rounds
+                r[j] = XOR(r[j], _mm256_loadu_si256((const __m256i *)
+                    (rtk1[j] + 32*(i % (TKPERMORDER/2)))));
+        }
+        transpose_x8(r);
+        for(j = 0; j < 8; j++)
+            rtk[8*i + j] = r[j];
+    }
+}
+
+/**
+ * Loads (resp. stores) the fixsliced words of 8 blocks into (resp. from) 4
+ * registers.
+ */
+AVX2_TARGET static inline void load_x8(__m256i s[4], const uint32_t w[8][4])
+{
+    __m256i r[8];
+    for(int i = 0; i < 8; i++)
+        r[i] = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)w[i]));
+    transpose_x8(r);
+    for(int i = 0; i < 4; i++)
+        s[i] = r[i];
+}
+
+AVX2_TARGET static inline void store_x8(uint32_t w[8][4], const __m256i s[4])
+{
+    __m256i r[8];
+    for(int i = 0; i < 4; i++) {
+        r[i] = s[i];
+        r[i+4] = _mm256_setzero_si256();
+    }
+    transpose_x8(r);
+    for(int i = 0; i < 8; i++)
+        _mm_storeu_si128((__m128i *)w[i], _mm256_castsi256_si128(r[i]));
+}
+
+#endif  // SKINNY128_X8_H_
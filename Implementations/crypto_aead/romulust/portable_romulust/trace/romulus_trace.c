@@ -0,0 +1,267 @@
+/**
+ * Workload trace capture and parsing (see 'romulus_trace.h').
+ *
+ * Calls are captured through the hook of the masked API. Key contexts are
+ * mapped to IDs in order of first use through an open-addressing hash table,
+ * so that no key material ever reaches the trace. Records are appended under
+ * a mutex to a buffered stream, the inter-arrival times being computed in the
+ * same critical section so that they are never negative.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "crypto_aead_shared.h"
+#include "romulus_trace.h"
+
+struct romulus_trace_file {
+    FILE *f;
+    int err;
+};
+
+static struct {
+    pthread_mutex_t lock;
+    romulus_trace_file *t;                  // NULL if not capturing
+    uint64_t last;                          // time of the previous record
+    const void **keys;                      // key contexts ...
+    uint32_t *ids;                          // ... and their IDs
+    size_t cap;                             // power of 2
+    uint32_t nkeys;
+} capture = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+static uint64_t clock_ns(clockid_t id)
+{
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+static void put_le(uint8_t *p, uint64_t x, int len)
+{
+    for(int i = 0; i < len; i++)
+        p[i] = (uint8_t)(x >> 8*i);
+}
+
+static uint64_t get_le(const uint8_t *p, int len)
+{
+    uint64_t x = 0;
+    for(int i = 0; i < len; i++)
+        x |= (uint64_t)p[i] << 8*i;
+    return x;
+}
+
+static void put_uleb(FILE *f, uint64_t x)
+{
+    while (x >= 0x80) {
+        putc((int)(x & 0x7f) | 0x80, f);
+        x >>= 7;
+    }
+    putc((int)x, f);
+}
+
+static int get_uleb(FILE *f, uint64_t *x)
+{
+    int c, sh;
+    *x = 0;
+    for(sh = 0; sh < 64; sh += 7) {
+        if ((c = getc(f)) == EOF)
+            return -1;
+        *x |= (uint64_t)(c & 0x7f) << sh;
+        if (!(c & 0x80))
+            return 0;
+    }
+    return -1;
+}
+
+/**
+ * Returns the ID of a key context, assigning the next one on first use.
+ * Called with the capture lock held.
+ */
+static uint32_t key_id(const void *key)
+{
+    size_t i, j, cap;
+    const void **keys;
+    uint32_t *ids;
+
+    if (key == NULL)
+        return 0;
+    if (2*(capture.nkeys + 1) > capture.cap) {
+        cap = capture.cap ? 2*capture.cap : 64;
+        keys = calloc(cap, sizeof(const void *));
+        ids = malloc(cap*sizeof(uint32_t));
+        if (keys == NULL || ids == NULL) {
+            free(keys);
+            free(ids);
+            capture.t->err = 1;
+            return 0;
+        }
+        for(i = 0; i < capture.cap; i++) {
+            if (capture.keys[i] == NULL)
+                continue;
+            j = ((uintptr_t)capture.keys[i] >> 6) * 0x9e3779b97f4a7c15ULL;
+            for(j &= cap - 1; keys[j] != NULL; j = (j + 1) & (cap - 1));
+            keys[j] = capture.keys[i];
+            ids[j] = capture.ids[i];
+        }
+        free(capture.keys);
+        free(capture.ids);
+        capture.keys = keys;
+        capture.ids = ids;
+        capture.cap = cap;
+    }
+    j = ((uintptr_t)key >> 6) * 0x9e3779b97f4a7c15ULL;
+    for(j &= capture.cap - 1; capture.keys[j] != NULL;
+        j = (j + 1) & (capture.cap - 1))
+        if (capture.keys[j] == key)
+            return capture.ids[j];
+    capture.keys[j] = key;
+    capture.ids[j] = ++capture.nkeys;
+    return capture.ids[j];
+}
+
+static void capture_hook(void *arg, int op, const void *key,
+    unsigned long long adlen, unsigned long long len)
+{
+    romulus_trace_rec rec;
+    uint64_t now;
+
+    (void)arg;
+    pthread_mutex_lock(&capture.lock);
+    if (capture.t != NULL) {
+        now = clock_ns(CLOCK_MONOTONIC);
+        rec.variant = TRACE_ROMULUS_T;
+        rec.op = (op == ROMULUS_HOOK_DECRYPT) ? TRACE_DECRYPT : TRACE_ENCRYPT;
+        rec.adlen = adlen;
+        if (rec.op == TRACE_DECRYPT)
+            rec.mlen = (len < TAGBYTES) ? 0 : len - TAGBYTES;
+        else
+            rec.mlen = len;
+        rec.key = key_id(key);
+        rec.dt = capture.last ? now - capture.last : 0;
+        capture.last = now;
+        romulus_trace_write(capture.t, &rec);
+    }
+    pthread_mutex_unlock(&capture.lock);
+}
+
+int romulus_trace_start(const char *path)
+{
+    int ret = -1;
+    pthread_mutex_lock(&capture.lock);
+    if (capture.t == NULL) {
+        capture.t = romulus_trace_create(path);
+        capture.last = 0;
+        capture.nkeys = 0;
+        ret = (capture.t != NULL) ? 0 : -1;
+    }
+    pthread_mutex_unlock(&capture.lock);
+    if (ret == 0)
+        romulus_set_call_hook(capture_hook, NULL);
+    return ret;
+}
+
+/**
+ * Calls in flight may still run the hook after it has been unregistered, in
+ * which case they find no trace and return.
+ */
+int romulus_trace_stop(void)
+{
+    romulus_trace_file *t;
+    romulus_set_call_hook(NULL, NULL);
+    pthread_mutex_lock(&capture.lock);
+    t = capture.t;
+    capture.t = NULL;
+    free(capture.keys);
+    free(capture.ids);
+    capture.keys = NULL;
+    capture.ids = NULL;
+    capture.cap = 0;
+    pthread_mutex_unlock(&capture.lock);
+    return t ? romulus_trace_close(t) : -1;
+}
+
+romulus_trace_file *romulus_trace_create(const char *path)
+{
+    uint8_t hdr[TRACE_HEADERBYTES] = { 'R', 'T', 'R', '1' };
+    romulus_trace_file *t = calloc(1, sizeof(romulus_trace_file));
+    if (t == NULL)
+        return NULL;
+    if ((t->f = fopen(path, "wb")) == NULL) {
+        free(t);
+        return NULL;
+    }
+    setvbuf(t->f, NULL, _IOFBF, 1 << 16);
+    put_le(hdr + 4, TRACE_VERSION, 4);
+    put_le(hdr + 8, clock_ns(CLOCK_REALTIME), 8);
+    if (fwrite(hdr, 1, sizeof(hdr), t->f) != sizeof(hdr))
+        t->err = 1;
+    return t;
+}
+
+int romulus_trace_write(romulus_trace_file *t, const romulus_trace_rec *rec)
+{
+    putc((rec->variant & 0x03) | (rec->op & 0x01) << 2, t->f);
+    put_uleb(t->f, rec->adlen);
+    put_uleb(t->f, rec->mlen);
+    put_uleb(t->f, rec->key);
+    put_uleb(t->f, rec->dt);
+    if (ferror(t->f))
+        t->err = 1;
+    return t->err ? -1 : 0;
+}
+
+romulus_trace_file *romulus_trace_open(const char *path)
+{
+    uint8_t hdr[TRACE_HEADERBYTES];
+    romulus_trace_file *t = calloc(1, sizeof(romulus_trace_file));
+    if (t == NULL)
+        return NULL;
+    if ((t->f = fopen(path, "rb")) == NULL) {
+        free(t);
+        return NULL;
+    }
+    if (fread(hdr, 1, sizeof(hdr), t->f) != sizeof(hdr) ||
+        hdr[0] != 'R' || hdr[1] != 'T' || hdr[2] != 'R' || hdr[3] != '1' ||
+        get_le(hdr + 4, 4) != TRACE_VERSION) {
+        fclose(t->f);
+        free(t);
+        return NULL;
+    }
+    return t;
+}
+
+int romulus_trace_read(romulus_trace_file *t, romulus_trace_rec *rec)
+{
+    int flags;
+    uint64_t key;
+    if ((flags = getc(t->f)) == EOF)
+        return 0;
+    if ((flags & ~0x07) || (flags & 0x03) > TRACE_ROMULUS_T)
+        return -1;
+    rec->variant = flags & 0x03;
+    rec->op = (flags >> 2) & 0x01;
+    if (get_uleb(t->f, &rec->adlen) || get_uleb(t->f, &rec->mlen) ||
+        get_uleb(t->f, &key) || get_uleb(t->f, &rec->dt) || key > UINT32_MAX)
+        return -1;
+    rec->key = (uint32_t)key;
+    return 1;
+}
+
+int romulus_trace_close(romulus_trace_file *t)
+{
+    int err;
+    if (t == NULL)
+        return -1;
+    if (fflush(t->f) || ferror(t->f))
+        t->err = 1;
+    if (fclose(t->f))
+        t->err = 1;
+    err = t->err;
+    free(t);
+    return err ? -1 : 0;
+}
@@ -0,0 +1,64 @@
+#ifndef ROMULUS_TRACE_H_
+#define ROMULUS_TRACE_H_
+
+#include <stdint.h>
+
+//Workload traces (POSIX only), to be captured from live processes and
+//replayed by 'romulus_trace_replay.c'.
+//
+//A trace is a 16-byte header followed by one record per call:
+//  header: "RTR1" | version (u32) | capture start in ns since epoch (u64)
+//  record: flags (1 byte: bits 0-1 variant, bit 2 operation), then adlen,
+//          mlen, key ID and inter-arrival time in ns as unsigned LEB128
+//Integers of the header are little-endian. 'mlen' is the message length for
+//both operations (i.e. clen - TAGBYTES for decryption). Key IDs start at 1,
+//in order of first use, 0 standing for keys expanded within the call (i.e.
+//'crypto_aead_{en,de}crypt_shared'). Typical records take 5 to 8 bytes.
+#define TRACE_VERSION       1
+#define TRACE_HEADERBYTES   16
+
+#define TRACE_ROMULUS_N     0
+#define TRACE_ROMULUS_M     1
+#define TRACE_ROMULUS_T     2
+
+#define TRACE_ENCRYPT       0
+#define TRACE_DECRYPT       1
+
+typedef struct {
+    uint8_t variant;
+    uint8_t op;
+    uint64_t adlen;
+    uint64_t mlen;
+    uint32_t key;
+    uint64_t dt;                            // ns since the previous record
+} romulus_trace_rec;
+
+//Starts capturing the calls to the masked API (see 'romulus_set_call_hook')
+//into a new file at 'path'. Only one capture can run at a time. Returns 0 on
+//success, -1 otherwise.
+int romulus_trace_start(const char *path);
+
+//Stops the capture and closes the file. Returns -1 if some records could not
+//be written, 0 otherwise.
+int romulus_trace_stop(void);
+
+typedef struct romulus_trace_file romulus_trace_file;
+
+//Creates a trace to be filled with 'romulus_trace_write' (e.g. synthetic
+//workloads), 'dt' being taken from the records.
+romulus_trace_file *romulus_trace_create(const char *path);
+
+int romulus_trace_write(romulus_trace_file *t, const romulus_trace_rec *rec);
+
+//Opens a trace for reading. Returns NULL if the file cannot be read or is not
+//a trace.
+romulus_trace_file *romulus_trace_open(const char *path);
+
+//Returns 1 if a record has been read, 0 at the end of the trace and -1 if it
+//is truncated or malformed.
+int romulus_trace_read(romulus_trace_file *t, romulus_trace_rec *rec);
+
+//Returns -1 if some records could not be written, 0 otherwise
+int romulus_trace_close(romulus_trace_file *t);
+
+#endif  // ROMULUS_TRACE_H_
@@ -0,0 +1,434 @@
+/**
+ * Replays a workload trace (see 'romulus_trace.h') through the masked
+ * Romulus-T API and reports the throughput and latency percentiles.
+ *
+ *  -a shared   every call expands its key ('crypto_aead_{en,de}crypt_shared')
+ *  -a ctx      calls go through the key contexts of their key ID ('_ctx'),
+ *              calls with key ID 0 through '_shared' (default)
+ *  -a batch    calls are grouped into '_batch' calls of up to ROMULUST_BATCH
+ *              messages, keys with ID 0 being expanded for each message
+ *  -s max      calls are issued back to back (default)
+ *  -s original calls are issued at their original inter-arrival times, pending
+ *              ones being grouped in batch mode
+ *
+ * Latencies are measured from the arrival of each call (i.e. including
+ * queueing if the replay falls behind the original schedule) or from its
+ * issue at maximum speed. Records of other variants than Romulus-T are
+ * skipped.
+ *
+ * Keys are random, one per key ID. So that decryptions go through tag
+ * verification and decryption as in production, valid ciphertexts are
+ * derived beforehand: the keystream prefix property of Romulus-T allows to
+ * keep a single ciphertext per key, of the longest message decrypted under
+ * it, along with the tag of each distinct (key, adlen, mlen) triple.
+ *
+ * Build from the 'portable_romulust' directory:
+ *   cc -O2 -o romulus_trace_replay trace/romulus_trace_replay.c \
+ *      trace/romulus_trace.c bench/bench.c aead.c romulus_t.c skinny128_*.c \
+ *      -I. -lpthread
+ * Usage:
+ *   romulus_trace_replay [-a shared|ctx|batch] [-s max|original]
+ *                        [-f text|csv|json] <trace>
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "randombytes.h"
+#include "crypto_aead_shared.h"
+#include "bench/bench.h"
+#include "romulus_trace.h"
+
+#define API_SHARED  0
+#define API_CTX     1
+#define API_BATCH   2
+
+typedef struct {
+    romulus_trace_rec *recs;
+    uint32_t *tag;                          // index in 'tags' (decryption)
+    size_t n;
+    uint32_t nkeys;                         // highest key ID
+    unsigned long long max_mlen, max_adlen;
+    unsigned long long *max_dec;            // per key ID
+    uint8_t (*tags)[TAGBYTES];
+    size_t ntags;
+} replay_trace;
+
+typedef struct {
+    mask_key_uint32_t (*ks)[4];             // per key ID
+    romulust_key_ctx *ctx;                  // per key ID
+    romulust_key_ctx tmp[ROMULUST_BATCH];   // for key ID 0 in batch mode
+    mask_npub_uint32_t npub[4];
+    uint8_t *m;                             // plaintext of all encryptions
+    uint8_t *ad;                            // AD of all calls
+    uint8_t **refc;                         // ciphertext per key ID
+    uint8_t *buf[ROMULUST_BATCH];           // per call in flight
+    size_t failures;
+} replay_state;
+
+/**
+ * Loads the Romulus-T records of a trace. Returns -1 if it cannot be read.
+ */
+static int load_trace(replay_trace *tr, const char *path, size_t *skipped)
+{
+    romulus_trace_file *t;
+    romulus_trace_rec rec;
+    size_t cap = 0;
+    int ret;
+
+    memset(tr, 0, sizeof(*tr));
+    *skipped = 0;
+    if ((t = romulus_trace_open(path)) == NULL)
+        return -1;
+    while ((ret = romulus_trace_read(t, &rec)) > 0) {
+        if (rec.variant != TRACE_ROMULUS_T) {
+            (*skipped)++;
+            continue;
+        }
+        if (tr->n == cap) {
+            cap = cap ? 2*cap : 4096;
+            tr->recs = realloc(tr->recs, cap*sizeof(romulus_trace_rec));
+            if (tr->recs == NULL)
+                return -1;
+        }
+        tr->recs[tr->n++] = rec;
+        if (rec.key > tr->nkeys)
+            tr->nkeys = rec.key;
+        if (rec.mlen > tr->max_mlen)
+            tr->max_mlen = rec.mlen;
+        if (rec.adlen > tr->max_adlen)
+            tr->max_adlen = rec.adlen;
+    }
+    romulus_trace_close(t);
+    return ret;
+}
+
+/**
+ * Assigns to each decryption the index of the tag of its (key, adlen, mlen)
+ * triple, through an open-addressing hash table of record indices.
+ */
+static int index_tags(replay_trace *tr)
+{
+    size_t i, j, cap;
+    uint32_t *slot;
+    const romulus_trace_rec *r, *s;
+
+    for(cap = 64; cap < 2*tr->n; cap *= 2);
+    slot = malloc(cap*sizeof(uint32_t));
+    tr->tag = malloc(tr->n*sizeof(uint32_t));
+    tr->max_dec = calloc(tr->nkeys + 1, sizeof(unsigned long long));
+    if (slot == NULL || tr->tag == NULL || tr->max_dec == NULL)
+        return -1;
+    memset(slot, 0xff, cap*sizeof(uint32_t));
+    for(i = 0; i < tr->n; i++) {
+        r = &tr->recs[i];
+        if (r->op != TRACE_DECRYPT)
+            continue;
+        if (r->mlen > tr->max_dec[r->key])
+            tr->max_dec[r->key] = r->mlen;
+        j = (r->key * 0x9e3779b97f4a7c15ULL) ^ (r->adlen * 0xc2b2ae3d27d4eb4fULL)
+            ^ (r->mlen * 0x165667b19e3779f9ULL);
+        for(j &= cap - 1; slot[j] != UINT32_MAX; j = (j + 1) & (cap - 1)) {
+            s = &tr->recs[slot[j]];
+            if (s->key == r->key && s->adlen == r->adlen && s->mlen == r->mlen)
+                break;
+        }
+        if (slot[j] == UINT32_MAX) {
+            slot[j] = i;
+            tr->tag[i] = tr->ntags++;
+        } else {
+            tr->tag[i] = tr->tag[slot[j]];
+        }
+    }
+    free(slot);
+    tr->tags = malloc((tr->ntags ? tr->ntags : 1)*TAGBYTES);
+    return tr->tags ? 0 : -1;
+}
+
+/**
+ * Draws the keys and derives the ciphertexts and tags used by decryptions.
+ */
+static int setup(replay_state *st, replay_trace *tr)
+{
+    size_t i, k;
+    unsigned long long clen, bufsize = tr->max_mlen + TAGBYTES;
+    uint8_t *c;
+    const romulus_trace_rec *r;
+
+    st->ks = malloc((tr->nkeys + 1)*sizeof(*st->ks));
+    st->ctx = aligned_alloc(64, (tr->nkeys + 1)*sizeof(romulust_key_ctx));
+    st->refc = calloc(tr->nkeys + 1, sizeof(uint8_t *));
+    st->m = malloc(bufsize);
+    st->ad = malloc(tr->max_adlen + 1);
+    c = malloc(bufsize);
+    if (!st->ks || !st->ctx || !st->refc || !st->m || !st->ad || !c)
+        return -1;
+    for(i = 0; i < ROMULUST_BATCH; i++)
+        if ((st->buf[i] = malloc(bufsize)) == NULL)
+            return -1;
+    randombytes((uint8_t *)st->ks, (tr->nkeys + 1)*sizeof(*st->ks));
+    randombytes((uint8_t *)st->npub, sizeof(st->npub));
+    randombytes(st->m, bufsize);
+    randombytes(st->ad, tr->max_adlen + 1);
+    romulus_expand_keys(st->ctx, (const mask_key_uint32_t *)st->ks,
+        tr->nkeys + 1);
+    for(k = 0; k <= tr->nkeys; k++) {
+        if (tr->max_dec[k] == 0)
+            continue;
+        if ((st->refc[k] = malloc(tr->max_dec[k] + TAGBYTES)) == NULL)
+            return -1;
+        crypto_aead_encrypt_shared_ctx((mask_c_uint32_t *)st->refc[k], &clen,
+            (const mask_m_uint32_t *)st->m, tr->max_dec[k],
+            (const mask_ad_uint32_t *)st->ad, 0, st->npub, &st->ctx[k]);
+    }
+    // tag of each distinct triple, computed at its first occurrence
+    for(i = 0, k = 0; i < tr->n && k < tr->ntags; i++) {
+        r = &tr->recs[i];
+        if (r->op != TRACE_DECRYPT || tr->tag[i] != k)
+            continue;
+        crypto_aead_encrypt_shared_ctx((mask_c_uint32_t *)c, &clen,
+            (const mask_m_uint32_t *)st->m, r->mlen,
+            (const mask_ad_uint32_t *)st->ad, r->adlen, st->npub,
+            &st->ctx[r->key]);
+        memcpy(tr->tags[k++], c + r->mlen, TAGBYTES);
+    }
+    free(c);
+    return 0;
+}
+
+/**
+ * Writes the ciphertext of a decryption into 'buf'.
+ */
+static void prepare(const replay_state *st, const replay_trace *tr, size_t i,
+    uint8_t *buf)
+{
+    const romulus_trace_rec *r = &tr->recs[i];
+    if (r->op != TRACE_DECRYPT)
+        return;
+    memcpy(buf, st->refc[r->key], r->mlen);
+    memcpy(buf + r->mlen, tr->tags[tr->tag[i]], TAGBYTES);
+}
+
+static void run_single(replay_state *st, const replay_trace *tr, size_t i,
+    int api)
+{
+    const romulus_trace_rec *r = &tr->recs[i];
+    unsigned long long len;
+    uint8_t *buf = st->buf[0];
+    if (r->op == TRACE_ENCRYPT) {
+        if (api == API_SHARED || r->key == 0)
+            crypto_aead_encrypt_shared((mask_c_uint32_t *)buf, &len,
+                (const mask_m_uint32_t *)st->m, r->mlen,
+                (const mask_ad_uint32_t *)st->ad, r->adlen, st->npub,
+                st->ks[r->key]);
+        else
+            crypto_aead_encrypt_shared_ctx((mask_c_uint32_t *)buf, &len,
+                (const mask_m_uint32_t *)st->m, r->mlen,
+                (const mask_ad_uint32_t *)st->ad, r->adlen, st->npub,
+                &st->ctx[r->key]);
+    } else if (api == API_SHARED || r->key == 0) {
+        st->failures += crypto_aead_decrypt_shared((mask_m_uint32_t *)buf, &len,
+            (const mask_c_uint32_t *)buf, r->mlen + TAGBYTES,
+            (const mask_ad_uint32_t *)st->ad, r->adlen, st->npub,
+            st->ks[r->key]) != 0;
+    } else {
+        st->failures += crypto_aead_decrypt_shared_ctx((mask_m_uint32_t *)buf,
+            &len, (const mask_c_uint32_t *)buf, r->mlen + TAGBYTES,
+            (const mask_ad_uint32_t *)st->ad, r->adlen, st->npub,
+            &st->ctx[r->key]) != 0;
+    }
+}
+
+/**
+ * Processes the calls idx[0..nb-1] through the batch API, one call per
+ * operation.
+ */
+static void run_batch(replay_state *st, const replay_trace *tr,
+    const size_t idx[], int nb)
+{
+    mask_c_uint32_t *out[ROMULUST_BATCH];
+    const mask_m_uint32_t *in[ROMULUST_BATCH];
+    const mask_ad_uint32_t *ad[ROMULUST_BATCH];
+    const mask_npub_uint32_t *npub[ROMULUST_BATCH];
+    const romulust_key_ctx *ctx[ROMULUST_BATCH];
+    unsigned long long inlen[ROMULUST_BATCH], outlen[ROMULUST_BATCH];
+    unsigned long long adlen[ROMULUST_BATCH];
+    int b, k, op, res[ROMULUST_BATCH];
+
+    for(op = TRACE_ENCRYPT; op <= TRACE_DECRYPT; op++) {
+        for(b = 0, k = 0; b < nb; b++) {
+            const romulus_trace_rec *r = &tr->recs[idx[b]];
+            if (r->op != op)
+                continue;
+            if (r->key == 0) {
+                romulus_expand_keys(&st->tmp[k],
+                    (const mask_key_uint32_t *)st->ks[0], 1);
+                ctx[k] = &st->tmp[k];
+            } else {
+                ctx[k] = &st->ctx[r->key];
+            }
+            out[k] = (mask_c_uint32_t *)st->buf[b];
+            in[k] = (op == TRACE_ENCRYPT) ?
+                (const mask_m_uint32_t *)st->m :
+                (const mask_m_uint32_t *)st->buf[b];
+            inlen[k] = (op == TRACE_ENCRYPT) ? r->mlen : r->mlen + TAGBYTES;
+            ad[k] = (const mask_ad_uint32_t *)st->ad;
+            adlen[k] = r->adlen;
+            npub[k++] = st->npub;
+        }
+        if (k == 0)
+            continue;
+        if (op == TRACE_ENCRYPT) {
+            crypto_aead_encrypt_shared_batch(out, outlen, in, inlen, ad, adlen,
+                npub, ctx, k);
+        } else {
+            crypto_aead_decrypt_shared_batch((mask_m_uint32_t *const *)out,
+                outlen, (const mask_c_uint32_t *const *)in, inlen, ad, adlen,
+                npub, ctx, res, k);
+            for(b = 0; b < k; b++)
+                st->failures += (res[b] != 0);
+        }
+    }
+}
+
+/**
+ * Waits until 't' (in seconds, see 'bench_now'), sleeping if it is more than
+ * 200us ahead and spinning otherwise.
+ */
+static void wait_until(double t)
+{
+    double now;
+    struct timespec ts;
+    while ((now = bench_now()) < t) {
+        if (t - now > 200e-6) {
+            ts.tv_sec = 0;
+            ts.tv_nsec = (long)((t - now - 100e-6)*1e9);
+            if (ts.tv_nsec >= 1000000000) {
+                ts.tv_sec = ts.tv_nsec / 1000000000;
+                ts.tv_nsec %= 1000000000;
+            }
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[])
+{
+    replay_trace tr;
+    replay_state st;
+    int opt, b, nb, api = API_CTX, original = 0, fmt = BENCH_TEXT;
+    size_t i, j, skipped, idx[ROMULUST_BATCH];
+    double *arrival, *lat, start, t, bytes = 0;
+    static const char *apis[] = { "shared", "ctx", "batch" };
+    static const char *pct_names[] = { "latency_p50", "latency_p90",
+        "latency_p99", "latency_p999", "latency_max" };
+    static const double pct[] = { 0.5, 0.9, 0.99, 0.999, 1.0 };
+    bench_result r;
+
+    while ((opt = getopt(argc, argv, "a:s:f:")) != -1) {
+        switch (opt) {
+        case 'a':
+            for(api = 2; api >= 0 && strcmp(optarg, apis[api]); api--);
+            break;
+        case 's':
+            original = !strcmp(optarg, "original") ? 1 :
+                !strcmp(optarg, "max") ? 0 : -1;
+            break;
+        case 'f':
+            fmt = bench_parse_format(optarg);
+            break;
+        default:
+            api = -1;
+            break;
+        }
+    }
+    if (api < 0 || original < 0 || fmt < 0 || optind != argc - 1) {
+        fprintf(stderr, "usage: %s [-a shared|ctx|batch] [-s max|original] "
+            "[-f text|csv|json] <trace>\n", argv[0]);
+        return 1;
+    }
+    if (load_trace(&tr, argv[optind], &skipped) < 0) {
+        fprintf(stderr, "cannot read trace '%s'\n", argv[optind]);
+        return 1;
+    }
+    memset(&st, 0, sizeof(st));
+    arrival = malloc((tr.n + 1)*sizeof(double));
+    lat = malloc((tr.n + 1)*sizeof(double));
+    if (!arrival || !lat || index_tags(&tr) < 0 || setup(&st, &tr) < 0) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    fprintf(stderr, "%zu calls (%zu skipped), %u key(s), %zu decryption "
+        "tag(s)\n", tr.n, skipped, tr.nkeys, tr.ntags);
+
+    start = bench_now();
+    for(i = 0, t = start; i < tr.n; i++) {
+        t += i ? tr.recs[i].dt*1e-9 : 0;
+        arrival[i] = t;
+        bytes += tr.recs[i].adlen + tr.recs[i].mlen;
+    }
+    for(i = 0; i < tr.n; i += nb) {
+        if (original)
+            wait_until(arrival[i]);
+        if (api != API_BATCH) {
+            nb = 1;
+            idx[0] = i;
+            prepare(&st, &tr, i, st.buf[0]);
+        } else {
+            t = bench_now();
+            for(nb = 0; nb < ROMULUST_BATCH && i + nb < tr.n &&
+                (!original || arrival[i + nb] <= t); nb++) {
+                idx[nb] = i + nb;
+                prepare(&st, &tr, i + nb, st.buf[nb]);
+            }
+        }
+        if (!original)
+            for(b = 0; b < nb; b++)
+                arrival[i + b] = bench_now();
+        if (api == API_BATCH)
+            run_batch(&st, &tr, idx, nb);
+        else
+            run_single(&st, &tr, i, api);
+        t = bench_now();
+        for(b = 0; b < nb; b++)
+            lat[i + b] = (t - arrival[i + b])*1e6;
+    }
+    t = bench_now() - start;
+    if (st.failures)
+        fprintf(stderr, "%zu decryption(s) failed\n", st.failures);
+
+    bench_init(fmt, "trace-replay");
+    r.backend = apis[api];
+    r.mode = original ? "original" : "max";
+    r.size = tr.n;
+    r.size_unit = "calls";
+    r.name = "throughput";
+    r.value = bytes / t / 1e6;
+    r.unit = "MB/s";
+    bench_report(&r);
+    r.name = "call_rate";
+    r.value = tr.n / t;
+    r.unit = "calls/s";
+    bench_report(&r);
+    qsort(lat, tr.n, sizeof(double), cmp_double);
+    r.unit = "us";
+    for(j = 0; j < sizeof(pct)/sizeof(pct[0]) && tr.n; j++) {
+        r.name = pct_names[j];
+        r.value = lat[(size_t)(pct[j]*(tr.n - 1))];
+        bench_report(&r);
+    }
+    return st.failures ? 1 : 0;
+}
@@ -0,0 +1,49 @@
+#ifndef ROMULUS_LEAKAGE_H_
+#define ROMULUS_LEAKAGE_H_
+
+#include <stdint.h>
+
+//Leakage recording of the instrumented build (-DROMULUS_LEAKAGE), used by
+//the simulated-leakage TVLA tool ('romulus_tvla.c').
+//
+//The 1st-order masked Skinny-128-384+ ('skinny128_core_mask.c') reports its
+//intermediates through LEAK(slot, x): the 8 state words (both shares) after
+//each s-box, tweakey addition and MixColumns, and the outputs of each secure
+//OR, slots identifying the variables holding them. Each report appends one
+//sample to the recorder of the calling thread, if any:
+//  - LEAK_HW: Hamming weight of x,
+//  - LEAK_HD: Hamming distance between x and the previous value of its slot
+//    (register overwrite).
+//Note that intermediates are recorded in source order: this models the
+//masking scheme as written, not the register allocation of the compiler.
+#define LEAK_HW             0
+#define LEAK_HD             1
+
+#define LEAK_SLOTS          10
+#define LEAK_MAX_SAMPLES    4096
+
+typedef struct {
+    int model;
+    int n;                                  // samples recorded so far
+    uint32_t last[LEAK_SLOTS];
+    uint8_t samples[LEAK_MAX_SAMPLES];
+} romulus_leak_rec;
+
+//Recorder of the calling thread, NULL to disable recording
+extern __thread romulus_leak_rec *romulus_leak;
+
+static inline void romulus_leak_word(int slot, uint32_t x)
+{
+    romulus_leak_rec *r = romulus_leak;
+    if (r == NULL || r->n == LEAK_MAX_SAMPLES)
+        return;
+    if (r->model == LEAK_HD)
+        r->samples[r->n++] = (uint8_t)__builtin_popcount(x ^ r->last[slot]);
+    else
+        r->samples[r->n++] = (uint8_t)__builtin_popcount(x);
+    r->last[slot] = x;
+}
+
+#define LEAK(slot, x)       romulus_leak_word((slot), (x))
+
+#endif  // ROMULUS_LEAKAGE_H_
@@ -0,0 +1,404 @@
+/**
+ * Fixed-vs-random TVLA on simulated leakage of the 1st-order masked
+ * Skinny-128-384+ (see 'romulus_leakage.h'), without storing traces.
+ *
+ * Each trace runs the target on the instrumented build with either a fixed or
+ * a random input (drawn with probability 1/2), fresh masks being drawn for
+ * every trace. The leakage samples (Hamming weights or distances of the
+ * intermediates, plus optional Gaussian noise) are accumulated per class with
+ * Welford's online algorithm; accumulators of the threads are merged at the
+ * end and the Welch t-statistic is computed for every sample.
+ *
+ * Targets:
+ *   skinny     masked Skinny-128-384+ on a fixed or random plaintext, under a
+ *              fixed key whose shares are refreshed for every trace,
+ *   romulus    full Romulus-T encryption (KDF and tag generation being the
+ *              masked calls) with a fixed or random nonce, under a fixed key.
+ * With '-u', all masks are set to zero, which should make the test fail
+ * (sanity check of the setup).
+ *
+ * Build from the 'portable_romulust' directory (w/ MASKING_ORDER = 1):
+ *   cc -O2 -DROMULUS_LEAKAGE -o romulus_tvla tvla/romulus_tvla.c aead.c \
+ *      romulus_t.c skinny128_*.c -I. -lpthread -lm
+ * Usage:
+ *   romulus_tvla [-t skinny|romulus] [-n <traces>] [-j <threads>]
+ *                [-m hw|hd] [-s <noise std. dev.>] [-u] [-S <seed>]
+ *                [-T <threshold>] [-o <t-curve file>]
+ * Returns 2 if |t| exceeds the threshold (4.5 by default) for some sample.
+ *
+ * @author      Alexandre Adomnicai
+ *              alex.adomnicai@gmail.com
+ *
+ * @date        October 2026
+ */
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "crypto_aead_shared.h"
+#include "skinny128.h"
+#include "romulus_leakage.h"
+
+#if MASKING_ORDER != 1
+#error "only the 1st-order masked implementation is instrumented"
+#endif
+
+#define TARGET_SKINNY       0
+#define TARGET_ROMULUS      1
+
+#define TVLA_MSGBYTES       16
+
+typedef struct {
+    int target;
+    int model;
+    int unmasked;
+    double sigma;
+    uint64_t seed;
+    uint8_t key[TWEAKEYBYTES];
+    uint8_t fixed[BLOCKBYTES];              // plaintext or nonce
+} tvla_cfg;
+
+//Welford accumulators of one class
+typedef struct {
+    uint64_t n;
+    double *mean;
+    double *m2;
+} tvla_acc;
+
+typedef struct {
+    const tvla_cfg *cfg;
+    int nsamples;
+    uint64_t ntraces;
+    int id;
+    tvla_acc acc[2];                        // fixed, random
+} tvla_worker;
+
+static __thread uint64_t rng[4];
+
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static void rng_seed(uint64_t seed)
+{
+    for(int i = 0; i < 4; i++)
+        rng[i] = splitmix64(&seed);
+}
+
+/**
+ * xoshiro256** (not cryptographic, masks only need to be uniform here).
+ */
+static uint64_t rng_next(void)
+{
+    uint64_t r = rng[1] * 5, t = rng[1] << 17;
+    r = ((r << 7) | (r >> 57)) * 9;
+    rng[2] ^= rng[0];
+    rng[3] ^= rng[1];
+    rng[1] ^= rng[2];
+    rng[0] ^= rng[3];
+    rng[2] ^= t;
+    rng[3] = (rng[3] << 45) | (rng[3] >> 19);
+    return r;
+}
+
+/**
+ * Box-Muller transform, the 2nd normal deviate being kept for the next call.
+ */
+static __thread double spare;
+static __thread int has_spare;
+
+static double rng_gauss(void)
+{
+    double u, v, r;
+    if (has_spare) {
+        has_spare = 0;
+        return spare;
+    }
+    u = ((rng_next() >> 11) + 0.5) * 0x1p-53;
+    v = (rng_next() >> 11) * 0x1p-53;
+    r = sqrt(-2*log(u));
+    spare = r * sin(2*M_PI*v);
+    has_spare = 1;
+    return r * cos(2*M_PI*v);
+}
+
+/**
+ * Randomness source required by the masked implementation.
+ */
+void randombytes(unsigned char *x, unsigned long long xlen)
+{
+    uint64_t r = 0;
+    for(unsigned long long i = 0; i < xlen; i++) {
+        if ((i & 7) == 0)
+            r = rng_next();
+        x[i] = (uint8_t)r;
+        r >>= 8;
+    }
+}
+
+/**
+ * Splits a 16-byte value into 2 shares, the 2nd one being zero if unmasked.
+ */
+static void share(uint8_t s[2][BLOCKBYTES], const uint8_t x[BLOCKBYTES],
+    int unmasked)
+{
+    if (unmasked)
+        memset(s[1], 0, BLOCKBYTES);
+    else
+        randombytes(s[1], BLOCKBYTES);
+    for(int i = 0; i < BLOCKBYTES; i++)
+        s[0][i] = x[i] ^ s[1][i];
+}
+
+static void to_words(mask_key_uint32_t w[4], const uint8_t s[2][BLOCKBYTES])
+{
+    for(int i = 0; i < 4; i++)
+        for(int j = 0; j < 2; j++)
+            w[i].shares[j] = (uint32_t)s[j][4*i] |
+                (uint32_t)s[j][4*i+1] << 8 | (uint32_t)s[j][4*i+2] << 16 |
+                (uint32_t)s[j][4*i+3] << 24;
+}
+
+/**
+ * Runs the target once on 'in', leakage being recorded by the caller.
+ */
+static void run_target(const tvla_cfg *cfg, const uint8_t in[BLOCKBYTES])
+{
+    uint8_t ks[2][BLOCKBYTES], xs[2][BLOCKBYTES], out[2][BLOCKBYTES];
+    share(ks, cfg->key, cfg->unmasked);
+    share(xs, in, cfg->unmasked);
+    if (cfg->target == TARGET_SKINNY) {
+        romulust_key_ctx ctx;
+        uint8_t tk1[TWEAKEYBYTES], rtk1[TKPERMORDER*BLOCKBYTES];
+        memset(tk1, 0, TWEAKEYBYTES);
+        SET_DOMAIN(tk1, 0x42);
+        tk_schedule_1(rtk1, tk1);
+        romulust_expand_key(&ctx, (const unsigned char (*)[TWEAKEYBYTES])ks);
+        skinny128_384_plus_m(out[0], out[1], xs[0], xs[1], ctx.rtk_3[0],
+            ctx.rtk_3[1], rtk1);
+    } else {
+        mask_key_uint32_t kw[4];
+        mask_npub_uint32_t nw[4];
+        mask_m_uint32_t m[TVLA_MSGBYTES/4];
+        mask_c_uint32_t c[(TVLA_MSGBYTES + TAGBYTES)/4];
+        unsigned long long clen;
+        to_words(kw, (const uint8_t (*)[BLOCKBYTES])ks);
+        to_words((mask_key_uint32_t *)nw, (const uint8_t (*)[BLOCKBYTES])xs);
+        memset(m, 0, sizeof(m));
+        crypto_aead_encrypt_shared(c, &clen, m, TVLA_MSGBYTES, NULL, 0, nw, kw);
+    }
+}
+
+static void acc_update(tvla_acc *a, const uint8_t *x, int n, double sigma)
+{
+    double d, v, inv = 1.0 / (double)(++a->n);
+    for(int i = 0; i < n; i++) {
+        v = x[i];
+        if (sigma > 0)
+            v += sigma*rng_gauss();
+        d = v - a->mean[i];
+        a->mean[i] += d*inv;
+        a->m2[i] += d*(v - a->mean[i]);
+    }
+}
+
+/**
+ * Merges 'b' into 'a' (Chan et al.).
+ */
+static void acc_merge(tvla_acc *a, const tvla_acc *b, int n)
+{
+    double d, na = a->n, nb = b->n;
+    if (b->n == 0)
+        return;
+    for(int i = 0; i < n; i++) {
+        d = b->mean[i] - a->mean[i];
+        a->mean[i] += d*nb/(na + nb);
+        a->m2[i] += b->m2[i] + d*d*na*nb/(na + nb);
+    }
+    a->n += b->n;
+}
+
+static void *worker(void *arg)
+{
+    tvla_worker *w = arg;
+    const tvla_cfg *cfg = w->cfg;
+    romulus_leak_rec rec;
+    uint8_t in[BLOCKBYTES];
+    int cls;
+
+    rng_seed(cfg->seed + 1 + w->id);
+    rec.model = cfg->model;
+    romulus_leak = &rec;
+    for(uint64_t t = 0; t < w->ntraces; t++) {
+        cls = (int)(rng_next() >> 63);
+        if (cls)
+            randombytes(in, BLOCKBYTES);
+        else
+            memcpy(in, cfg->fixed, BLOCKBYTES);
+        rec.n = 0;
+        memset(rec.last, 0, sizeof(rec.last));
+        run_target(cfg, in);
+        acc_update(&w->acc[cls], rec.samples, w->nsamples, cfg->sigma);
+    }
+    romulus_leak = NULL;
+    return NULL;
+}
+
+/**
+ * Samples per trace, from a single run of the target.
+ */
+static int count_samples(const tvla_cfg *cfg)
+{
+    romulus_leak_rec rec;
+    rec.model = cfg->model;
+    rec.n = 0;
+    memset(rec.last, 0, sizeof(rec.last));
+    rng_seed(cfg->seed);
+    romulus_leak = &rec;
+    run_target(cfg, cfg->fixed);
+    romulus_leak = NULL;
+    return rec.n;
+}
+
+static int acc_alloc(tvla_acc *a, int n)
+{
+    a->n = 0;
+    a->mean = calloc(n, sizeof(double));
+    a->m2 = calloc(n, sizeof(double));
+    return (a->mean == NULL || a->m2 == NULL) ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int opt, nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN), nsamples, nleaky = 0;
+    int i, imax = 0;
+    uint64_t ntraces = 1000000, seed;
+    double thr = 4.5, t, tmax = 0, vf, vr, elapsed;
+    const char *outfile = NULL;
+    tvla_cfg cfg = {0};
+    tvla_worker *w;
+    pthread_t *th;
+    struct timespec t0, t1;
+    FILE *f = NULL;
+
+    cfg.target = TARGET_SKINNY;
+    cfg.model = LEAK_HW;
+    cfg.seed = (uint64_t)time(NULL);
+    while ((opt = getopt(argc, argv, "t:n:j:m:s:uS:T:o:")) != -1) {
+        switch (opt) {
+        case 't':
+            if (!strcmp(optarg, "skinny"))
+                cfg.target = TARGET_SKINNY;
+            else if (!strcmp(optarg, "romulus"))
+                cfg.target = TARGET_ROMULUS;
+            else
+                nthreads = -1;
+            break;
+        case 'n': ntraces = strtoull(optarg, NULL, 0); break;
+        case 'j': nthreads = atoi(optarg); break;
+        case 'm':
+            if (!strcmp(optarg, "hw"))
+                cfg.model = LEAK_HW;
+            else if (!strcmp(optarg, "hd"))
+                cfg.model = LEAK_HD;
+            else
+                nthreads = -1;
+            break;
+        case 's': cfg.sigma = atof(optarg); break;
+        case 'u': cfg.unmasked = 1; break;
+        case 'S': cfg.seed = strtoull(optarg, NULL, 0); break;
+        case 'T': thr = atof(optarg); break;
+        case 'o': outfile = optarg; break;
+        default: nthreads = -1; break;
+        }
+    }
+    if (nthreads <= 0 || ntraces < 4) {
+        fprintf(stderr, "usage: %s [-t skinny|romulus] [-n <traces>] "
+            "[-j <threads>] [-m hw|hd] [-s <noise std. dev.>] [-u] "
+            "[-S <seed>] [-T <threshold>] [-o <t-curve file>]\n", argv[0]);
+        return 1;
+    }
+    seed = cfg.seed;
+    rng_seed(seed);
+    randombytes(cfg.key, TWEAKEYBYTES);
+    randombytes(cfg.fixed, BLOCKBYTES);
+    nsamples = count_samples(&cfg);
+
+    w = calloc(nthreads, sizeof(tvla_worker));
+    th = calloc(nthreads, sizeof(pthread_t));
+    if (w == NULL || th == NULL)
+        return 1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(i = 0; i < nthreads; i++) {
+        w[i].cfg = &cfg;
+        w[i].nsamples = nsamples;
+        w[i].id = i;
+        w[i].ntraces = ntraces/nthreads + ((uint64_t)i < ntraces % nthreads);
+        if (acc_alloc(&w[i].acc[0], nsamples) || acc_alloc(&w[i].acc[1], nsamples))
+            return 1;
+        if (pthread_create(&th[i], NULL, worker, &w[i]))
+            return 1;
+    }
+    for(i = 0; i < nthreads; i++) {
+        pthread_join(th[i], NULL);
+        if (i > 0) {
+            acc_merge(&w[0].acc[0], &w[i].acc[0], nsamples);
+            acc_merge(&w[0].acc[1], &w[i].acc[1], nsamples);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    elapsed = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec)*1e-9;
+
+    if (outfile != NULL && (f = fopen(outfile, "w")) == NULL) {
+        perror(outfile);
+        return 1;
+    }
+    for(i = 0; i < nsamples; i++) {
+        const tvla_acc *a = &w[0].acc[0], *b = &w[0].acc[1];
+        vf = (a->n > 1) ? a->m2[i] / (a->n - 1) : 0;
+        vr = (b->n > 1) ? b->m2[i] / (b->n - 1) : 0;
+        if (vf + vr > 0)
+            t = (a->mean[i] - b->mean[i]) / sqrt(vf/a->n + vr/b->n);
+        else    // constant sample: leaks iff both classes differ
+            t = (a->mean[i] != b->mean[i]) ? INFINITY : 0;
+        if (fabs(t) > thr)
+            nleaky++;
+        if (fabs(t) > fabs(tmax)) {
+            tmax = t;
+            imax = i;
+        }
+        if (f != NULL)
+            fprintf(f, "%d %.4f\n", i, t);
+    }
+    if (f != NULL)
+        fclose(f);
+
+    printf("target              %s (%s%s), seed %llu\n",
+        cfg.target == TARGET_SKINNY ? "skinny" : "romulus",
+        cfg.model == LEAK_HD ? "hamming distance" : "hamming weight",
+        cfg.unmasked ? ", unmasked" : "", (unsigned long long)seed);
+    printf("traces              %llu fixed, %llu random, %d samples each\n",
+        (unsigned long long)w[0].acc[0].n, (unsigned long long)w[0].acc[1].n,
+        nsamples);
+    printf("time                %.1f s (%.0f traces/s on %d threads)\n",
+        elapsed, ntraces / elapsed, nthreads);
+    printf("max |t|             %.2f at sample %d\n", fabs(tmax), imax);
+    printf("|t| > %-6.2f        %d sample(s): %s\n", thr, nleaky,
+        nleaky ? "FAIL" : "pass");
+    for(i = 0; i < nthreads; i++) {
+        free(w[i].acc[0].mean);
+        free(w[i].acc[0].m2);
+        free(w[i].acc[1].mean);
+        free(w[i].acc[1].m2);
+    }
+    free(w);
+    free(th);
+    return nleaky ? 2 : 0;
+}
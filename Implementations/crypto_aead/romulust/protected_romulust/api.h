@@ -2,6 +2,7 @@
 #define CRYPTO_NSECBYTES    0
 #define CRYPTO_NPUBBYTES    16
 #define CRYPTO_ABYTES       16
+// in-place processing (c == m) is supported, partial overlaps are not
 #define CRYPTO_NOOVERLAP    1
 #define CRYPTO_BYTES        32
 
@@ -41,15 +41,15 @@
 
 
 //Rho as defined in the Romulus specification
-//use pad as a tmp variable in case y = z
+//z is absorbed into the state before y is written, so that y = z is supported
 #define RHO(x,y,z,tmp) ({       \
     G(tmp,x);                   \
-    XOR_BLOCK(y, tmp, z);       \
     XOR_BLOCK(x, x, z);         \
+    XOR_BLOCK(y, tmp, z);       \
 })
 
 //Rho inverse as defined in the Romulus specification
-//use pad as a tmp variable in case y = z
+//y is fully read before z is written, so that y = z is supported
 #define RHO_INV(x, y, z, tmp) ({    \
     G(tmp, x);                      \
     XOR_BLOCK(z, tmp, y);           \
@@ -12,6 +12,7 @@
 #include "variant.h"
 #include "skinny.h"
 #include "romulus_t.h"
+#include "romulus_usdt.h"
 
 
 int crypto_aead_encrypt (
@@ -23,6 +24,10 @@ int crypto_aead_encrypt (
 			 const unsigned char* k
 			 )
 {
-  return romulus_t_encrypt(c,clen,m,mlen,ad,adlen,nsec,npub,k);
+  int ret;
+  ROMULUS_PROBE3(aead_encrypt_entry,"romulus-t",adlen,mlen);
+  ret = romulus_t_encrypt(c,clen,m,mlen,ad,adlen,nsec,npub,k);
+  ROMULUS_PROBE4(aead_encrypt_return,"romulus-t",adlen,mlen,ret);
+  return ret;
 }
 
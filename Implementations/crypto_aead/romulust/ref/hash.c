@@ -10,6 +10,7 @@
 #include "skinny.h"
 #include "api.h"
 #include "crypto_hash.h"
+#include "romulus_usdt.h"
 
 
 // The hirose double-block length (DBL) compression function.
@@ -17,6 +18,7 @@ void hirose_128_128_256 (unsigned char* h,
 			 unsigned char* g,
 			 const unsigned char* m) {
   unsigned char key [48];
+  unsigned char rtk23 [SKINNY_RTK23_BYTES];
   unsigned char hh  [16];
   int i;
 
@@ -31,8 +33,10 @@ void hirose_128_128_256 (unsigned char* h,
     key[i+16] = m[i];
   }
   
-  skinny_128_384_plus_enc(h,key);
-  skinny_128_384_plus_enc(g,key);
+  // both calls share the same tweakey
+  skinny_128_384_plus_ks(rtk23,key+16);
+  skinny_128_384_plus_enc_with_rtk(h,key,rtk23);
+  skinny_128_384_plus_enc_with_rtk(g,key,rtk23);
 
   for (i = 0; i < 16; i++) {
     h[i] ^= hh[i];
@@ -108,6 +112,7 @@ int crypto_hash(
   unsigned char p[32];
   unsigned char i;
 
+  ROMULUS_PROBE2(hash_entry,"romulus-h",inlen);
   mlen = inlen;
 
   initialize(h,g);
@@ -126,6 +131,7 @@ int crypto_hash(
     out[i+16] = g[i];
   }
 
+  ROMULUS_PROBE3(hash_return,"romulus-h",inlen,0);
   return 0;
 }
 
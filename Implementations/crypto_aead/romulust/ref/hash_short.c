@@ -0,0 +1,131 @@
+/*
+ * Romulus-H for short inputs (see 'romulus_h_short.h').
+ *
+ * The subtweakeys are linear in the tweakey cells, each cell following a
+ * fixed path through the tweakey permutation: a cell only contributes to the
+ * subtweakey of the rounds where it lies in the two top rows, where its LFSR
+ * is also applied. The subtweakeys of a compression are thus the sum of the
+ * contributions of its non-zero cells, which are known from the input length.
+ *
+ * Date: October 2026
+ * Contact: Alexandre Adomnicai (alex.adomnicai@gmail.com)
+ */
+
+#include "skinny.h"
+#include "crypto_hash.h"
+#include "romulus_t_hash.h"
+#include "romulus_h_short.h"
+
+#define ROUNDS      40
+#define RTK_BYTES   (8*ROUNDS)
+
+#define LFSR_NONE   0   // TK1
+#define LFSR_TK2    1
+#define LFSR_TK3    2
+
+// Position of a tweakey cell after the tweakey permutation
+static const unsigned char TK_NEXT[16] = {8,9,10,11,12,13,14,15,2,0,4,7,6,3,5,1};
+
+// Adds to 'rtk' the contribution of value 'v' in cell 'pos' of a tweakey word
+static void add_cell(unsigned char* rtk, unsigned char v, int pos, int lfsr) {
+  int r;
+
+  for (r = 0; r < ROUNDS; r++) {
+    if (pos < 8) {
+      rtk[8*r+pos] ^= v;
+    }
+    pos = TK_NEXT[pos];
+    if (pos < 8) {
+      if (lfsr == LFSR_TK2) {
+        v = ((v<<1)&0xFE)^((v>>7)&0x01)^((v>>5)&0x01);
+      }
+      else if (lfsr == LFSR_TK3) {
+        v = ((v>>1)&0x7F)^((v<<7)&0x80)^((v<<1)&0x80);
+      }
+    }
+  }
+}
+
+// Hirose compression (see 'hirose_128_128_256') where the 256-bit block
+// is m[0..len-1] || 0* || pad, g is zero if 'g_zero' is set and the
+// subtweakeys are computed once for both Skinny calls
+static void hirose_short(unsigned char* h,
+                         unsigned char* g,
+                         int g_zero,
+                         const unsigned char* m,
+                         int len,
+                         unsigned char pad) {
+  unsigned char rtk[RTK_BYTES];
+  unsigned char hh[16];
+  int i;
+
+  for (i = 0; i < RTK_BYTES; i++) {
+    rtk[i] = 0;
+  }
+  for (i = 0; i < 16 && !g_zero; i++) { // TK1 = g
+    add_cell(rtk,g[i],i,LFSR_NONE);
+  }
+  for (i = 0; i < len && i < 16; i++) { // TK2 = m[0..15]
+    add_cell(rtk,m[i],i,LFSR_TK2);
+  }
+  for (i = 16; i < len; i++) { // TK3 = m[16..31]
+    add_cell(rtk,m[i],i-16,LFSR_TK3);
+  }
+  if (pad) {
+    add_cell(rtk,pad,15,LFSR_TK3);
+  }
+
+  for (i = 0; i < 16; i++) {
+    g[i]  = h[i];
+    hh[i] = h[i];
+  }
+  g[0] ^= 0x01;
+  skinny_128_384_plus_enc_with_full_rtk(h,rtk);
+  skinny_128_384_plus_enc_with_full_rtk(g,rtk);
+  for (i = 0; i < 16; i++) {
+    h[i] ^= hh[i];
+    g[i] ^= hh[i];
+  }
+  g[0] ^= 0x01;
+}
+
+int romulush_short(unsigned char *out,
+                   const unsigned char *in,
+                   unsigned long long inlen) {
+  unsigned char h[16];
+  unsigned char g[16];
+  int g_zero = 1;
+  int mlen = (int)inlen;
+  int i;
+
+  if (inlen > ROMULUSH_SHORT_MAXBYTES) {
+    return crypto_hash(out,in,inlen);
+  }
+  initialize(h,g);
+  while (mlen >= 32) { // Full blocks
+    hirose_short(h,g,g_zero,in,32,0);
+    g_zero = 0;
+    in += 32;
+    mlen -= 32;
+  }
+  // Partial block (or in case there is no partial block we add a 0^2n block
+  h[0] ^= 2;
+  hirose_short(h,g,g_zero,in,mlen,(unsigned char)(mlen & 0x1f));
+
+  for (i = 0; i < 16; i++) { // Assign the output tag
+    out[i] = h[i];
+    out[i+16] = g[i];
+  }
+  return 0;
+}
+
+void romulush_short_batch(unsigned char out[][32],
+                          const unsigned char *const in[],
+                          const unsigned long long inlen[],
+                          size_t n) {
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    romulush_short(out[i],in[i],inlen[i]);
+  }
+}
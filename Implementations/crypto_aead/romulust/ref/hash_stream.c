@@ -0,0 +1,110 @@
+/*
+ * Romulus-H streaming interface (see 'romulus_h_stream.h'), on top of the
+ * compression function and padding of 'hash.c'.
+ *
+ * Date: October 2026
+ * Contact: Alexandre Adomnicai (alex.adomnicai@gmail.com)
+ */
+
+#include "romulus_h_stream.h"
+#include "romulus_t_hash.h"
+
+void romulush_stream_init(romulush_stream_ctx *ctx) {
+  initialize(ctx->h,ctx->g);
+  ctx->buflen = 0;
+}
+
+void romulush_update(romulush_stream_ctx *ctx,
+                     const unsigned char *in,
+                     unsigned long long inlen) {
+  unsigned long long n;
+  unsigned long long i;
+
+  if (ctx->buflen > 0) { // Complete the buffered block first
+    n = 32 - ctx->buflen;
+    if (inlen < n) {
+      n = inlen;
+    }
+    for (i = 0; i < n; i++) {
+      ctx->buf[ctx->buflen + i] = in[i];
+    }
+    ctx->buflen += (uint32_t)n;
+    in += n;
+    inlen -= n;
+    if (ctx->buflen < 32) {
+      return;
+    }
+    hirose_128_128_256(ctx->h,ctx->g,ctx->buf);
+    ctx->buflen = 0;
+  }
+  while (inlen >= 32) { // Normal loop
+    hirose_128_128_256(ctx->h,ctx->g,in);
+    in += 32;
+    inlen -= 32;
+  }
+  for (i = 0; i < inlen; i++) {
+    ctx->buf[i] = in[i];
+  }
+  ctx->buflen = (uint32_t)inlen;
+}
+
+void romulush_final(romulush_stream_ctx *ctx, unsigned char *out) {
+  unsigned char p[32];
+  int i;
+
+  // Partial block (or in case there is no partial block we add a 0^2n block
+  ipad_256(ctx->buf,p,32,ctx->buflen);
+  ctx->h[0] ^= 2;
+  hirose_128_128_256(ctx->h,ctx->g,p);
+
+  for (i = 0; i < 16; i++) { // Assign the output tag
+    out[i] = ctx->h[i];
+    out[i+16] = ctx->g[i];
+  }
+}
+
+void romulush_stream_export(const romulush_stream_ctx *ctx,
+                            unsigned char out[ROMULUSH_STREAM_EXPORTBYTES]) {
+  int i;
+
+  out[0] = 'R';
+  out[1] = 'H';
+  out[2] = 'S';
+  out[3] = 'T';
+  out[4] = ROMULUSH_STREAM_VERSION;
+  out[5] = (unsigned char)ctx->buflen;
+  out[6] = 0;
+  out[7] = 0;
+  for (i = 0; i < 16; i++) {
+    out[8+i] = ctx->h[i];
+    out[24+i] = ctx->g[i];
+  }
+  for (i = 0; i < 32; i++) {
+    out[40+i] = (i < (int)ctx->buflen) ? ctx->buf[i] : 0;
+  }
+}
+
+int romulush_stream_import(romulush_stream_ctx *ctx,
+                           const unsigned char in[ROMULUSH_STREAM_EXPORTBYTES]) {
+  int i;
+
+  if (in[0] != 'R' || in[1] != 'H' || in[2] != 'S' || in[3] != 'T' ||
+      in[4] != ROMULUSH_STREAM_VERSION || in[5] >= 32 ||
+      in[6] != 0 || in[7] != 0) {
+    return -1;
+  }
+  for (i = in[5]; i < 32; i++) { // Padding must be canonical
+    if (in[40+i] != 0) {
+      return -1;
+    }
+  }
+  for (i = 0; i < 16; i++) {
+    ctx->h[i] = in[8+i];
+    ctx->g[i] = in[24+i];
+  }
+  for (i = 0; i < 32; i++) {
+    ctx->buf[i] = in[40+i];
+  }
+  ctx->buflen = in[5];
+  return 0;
+}
@@ -0,0 +1,27 @@
+#ifndef ROMULUS_H_SHORT_H_
+#define ROMULUS_H_SHORT_H_
+
+#include <stddef.h>
+
+//Romulus-H for short inputs (e.g. hash-table or deduplication keys), with
+//the same output as crypto_hash.
+//
+//Inputs of up to ROMULUSH_SHORT_MAXBYTES bytes take at most three
+//compressions (the last one absorbing an all-padding block when the length
+//is a multiple of 32). For each of them, the subtweakeys of TK1, TK2 and TK3
+//are computed at once and shared by both Skinny calls, cell by cell: cells
+//known to be zero (the initial TK1, the zero padding) are skipped based on
+//the input length only. Longer inputs are passed to crypto_hash.
+#define ROMULUSH_SHORT_MAXBYTES 64
+
+int romulush_short(unsigned char *out,
+                   const unsigned char *in,
+                   unsigned long long inlen);
+
+//Hashes 'n' independent inputs, 'out[i]' receiving the digest of 'in[i]'.
+void romulush_short_batch(unsigned char out[][32],
+                          const unsigned char *const in[],
+                          const unsigned long long inlen[],
+                          size_t n);
+
+#endif  // ROMULUS_H_SHORT_H_
@@ -0,0 +1,42 @@
+#ifndef ROMULUS_H_STREAM_H_
+#define ROMULUS_H_STREAM_H_
+
+#include <stdint.h>
+
+//Streaming interface for Romulus-H: romulush_stream_init, romulush_update*,
+//romulush_final, with the same output as crypto_hash over the concatenation
+//of all inputs. Full 256-bit blocks are compressed as soon as they are
+//complete, only a partial block being buffered.
+typedef struct {
+  unsigned char h[16];
+  unsigned char g[16];
+  unsigned char buf[32];
+  uint32_t buflen;
+} romulush_stream_ctx;
+
+void romulush_stream_init(romulush_stream_ctx *ctx);
+
+void romulush_update(romulush_stream_ctx *ctx,
+                     const unsigned char *in,
+                     unsigned long long inlen);
+
+void romulush_final(romulush_stream_ctx *ctx, unsigned char *out);
+
+//Export of an in-progress context, e.g. to resume it on another host, in a
+//stable versioned format of ROMULUSH_STREAM_EXPORTBYTES bytes:
+//  "RHST" | version (1 byte) | buffered length (1 byte) | 0x0000 |
+//  h (16 bytes) | g (16 bytes) | buffered bytes, zero-padded (32 bytes)
+//Since there is no key, anyone holding the exported context can compute the
+//digest of any continuation of the input.
+#define ROMULUSH_STREAM_VERSION     1
+#define ROMULUSH_STREAM_EXPORTBYTES 72
+
+void romulush_stream_export(const romulush_stream_ctx *ctx,
+                            unsigned char out[ROMULUSH_STREAM_EXPORTBYTES]);
+
+//Returns 0 on success, -1 if 'in' is not a valid export (in which case 'ctx'
+//is left untouched).
+int romulush_stream_import(romulush_stream_ctx *ctx,
+                           const unsigned char in[ROMULUSH_STREAM_EXPORTBYTES]);
+
+#endif  // ROMULUS_H_STREAM_H_
@@ -81,6 +81,40 @@ void block_cipher(unsigned char* s,
 
 }
 
+// Precomputes the subtweakeys of TK2 || TK3 = T || K
+void key_schedule (unsigned char* rtk23,
+		   const unsigned char* K,
+		   unsigned char* T) {
+  unsigned char KT [32];
+  int i;
+
+  for (i = 0; i < 16; i++) {
+    KT[i] = T[i];
+    KT[i+16] = K[i];
+  }
+  skinny_128_384_plus_ks(rtk23,KT);
+
+}
+
+// Same as block_cipher from the subtweakeys computed by key_schedule: only TK1 (counter and
+// domain bits) is composed
+void block_cipher_with_rtk(unsigned char* s,
+			   const unsigned char* rtk23,
+			   unsigned char* CNT, unsigned char D) {
+  unsigned char KT [16];
+  int i;
+
+  for (i = 0; i < 7; i++) {
+    KT[i] = CNT[i];
+  }
+  KT[i] = D;
+  for (i = 8; i < 16; i++) {
+    KT[i] = 0x00;
+  }
+  skinny_128_384_plus_enc_with_rtk(s,KT,rtk23);
+
+}
+
 // Initialization function: KDF
 void kdf (const unsigned char* K, unsigned char* Z, const unsigned char* N, unsigned char* CNT) {  
 
@@ -103,6 +137,7 @@ unsigned long long msg_encryption (const unsigned char** M, unsigned char** C,
 
   unsigned char S[16];
   unsigned char T[16]={0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
+  unsigned char rtk23[SKINNY_RTK23_BYTES];
 
   int len8, i;
   
@@ -119,7 +154,9 @@ unsigned long long msg_encryption (const unsigned char** M, unsigned char** C,
     S[i] = N[i];
   }
 
-  block_cipher(S,Z,T,CNT,64);
+  // both TBC calls use TK2 = 0 and TK3 = Z
+  key_schedule(rtk23,Z,T);
+  block_cipher_with_rtk(S,rtk23,CNT,64);
   
   for (i = 0; i < len8; i++) {
     (*C)[i] = (*M)[i] ^ S[i];
@@ -132,7 +169,7 @@ unsigned long long msg_encryption (const unsigned char** M, unsigned char** C,
   }
 
   if (mlen != 0) {
-    block_cipher(S,Z,T,CNT,65);
+    block_cipher_with_rtk(S,rtk23,CNT,65);
 
     for (i = 0; i < 16; i++) {
       Z[i] = S[i];
@@ -155,6 +192,7 @@ unsigned long long msg_decryption (unsigned char** M, const unsigned char** C,
 
   unsigned char S[16];
   unsigned char T[16]={0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
+  unsigned char rtk23[SKINNY_RTK23_BYTES];
 
   int len8, i;
   
@@ -171,7 +209,9 @@ unsigned long long msg_decryption (unsigned char** M, const unsigned char** C,
     S[i] = N[i];
   }
 
-  block_cipher(S,Z,T,CNT,64);
+  // both TBC calls use TK2 = 0 and TK3 = Z
+  key_schedule(rtk23,Z,T);
+  block_cipher_with_rtk(S,rtk23,CNT,64);
   
   for (i = 0; i < len8; i++) {
     (*M)[i] = (*C)[i] ^ S[i];
@@ -184,7 +224,7 @@ unsigned long long msg_decryption (unsigned char** M, const unsigned char** C,
   }
 
   if (clen != 0) {
-    block_cipher(S,Z,T,CNT,65);
+    block_cipher_with_rtk(S,rtk23,CNT,65);
 
     for (i = 0; i < 16; i++) {
       Z[i] = S[i];
@@ -1 +1,14 @@
 extern void skinny_128_384_plus_enc (unsigned char* input, const unsigned char* userkey);
+
+// Size in bytes of the subtweakeys related to TK2 and TK3 (8 bytes for each of the 40 rounds)
+#define SKINNY_RTK23_BYTES 320
+
+// Precomputes the subtweakeys related to TK2 and TK3 from userkey = TK2 || TK3 (32 bytes)
+extern void skinny_128_384_plus_ks (unsigned char* rtk23, const unsigned char* userkey);
+
+// Same as skinny_128_384_plus_enc with TK1 (16 bytes) and the subtweakeys computed by skinny_128_384_plus_ks
+extern void skinny_128_384_plus_enc_with_rtk (unsigned char* input, const unsigned char* tk1, const unsigned char* rtk23);
+
+// Same as skinny_128_384_plus_enc_with_rtk with the subtweakeys of TK1, TK2 and TK3 XORed together
+// (8 bytes for each of the 40 rounds, round constants excluded)
+extern void skinny_128_384_plus_enc_with_full_rtk (unsigned char* input, const unsigned char* rtk);